@@ -57,6 +57,7 @@ namespace landan {
 	//////////////////////////////////////////////////////////////////////
 
 	class ApplicationConfig;
+	class JobSystem;
 
 	//////////////////////////////////////////////////////////////////////
 	// CLASS DECLARATION /////////////////////////////////////////////////
@@ -66,7 +67,7 @@ namespace landan {
 
 	//PUBLIC FUNCTIONS
 	public:
-		IApplication() {LOG_INFO("IApplication Constructor");}
+		IApplication() :p_quitFlag(0), p_jobSystem(0) {LOG_INFO("IApplication Constructor");}
 		virtual ~IApplication() {LOG_INFO("IApplication Destructor");}
 
 		virtual void ApplyConfig(ApplicationConfig *appConfig) = 0;
@@ -77,6 +78,10 @@ namespace landan {
 		void Quit() { *p_quitFlag = 0; }
 		void ApplyQuitFlag(u8 *quitFlag) { p_quitFlag = quitFlag; }
 
+		//Running from Init onwards, Update can spread its work across it with ParallelFor or jobs
+		JobSystem* GetJobSystem() { return p_jobSystem; }
+		void ApplyJobSystem(JobSystem *jobSystem) { p_jobSystem = jobSystem; }
+
 	//PRIVATE FUNCTIONS
 	private:
 		IApplication(const IApplication &other);
@@ -87,6 +92,10 @@ namespace landan {
 	private:
 		u8 *p_quitFlag;
 
+	//JOB SYSTEM
+	private:
+		JobSystem *p_jobSystem;
+
 	};
 }
 
@@ -47,6 +47,7 @@ namespace landan {
 	//////////////////////////////////////////////////////////////////////
 
 	WindowedApplication::WindowedApplication()
+	:m_renderBuffer(0)
 	{
 	}
 
@@ -91,7 +92,22 @@ namespace landan {
 
 	}
 
-	void WindowedApplication::Render()
+	void WindowedApplication::Render(f32 interpolationAlpha)
+	{
+
+	}
+
+	void WindowedApplication::CopyRenderState(u32 buffer)
+	{
+
+	}
+
+	void WindowedApplication::InitRenderThread()
+	{
+
+	}
+
+	void WindowedApplication::ShutdownRenderThread()
 	{
 
 	}
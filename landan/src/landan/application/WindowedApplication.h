@@ -67,14 +67,33 @@ namespace landan {
 		virtual void ApplyConfig(ApplicationConfig *appConfig);
 		virtual void Init();
 		virtual void Update(f32 deltaMilliSeconds);
-		virtual void Render();
+		//interpolationAlpha is how far (0-1) the current time sits between the last two fixed steps, 1.0 outside FIXED_TIMESTEP
+		virtual void Render(f32 interpolationAlpha);
 		virtual void Destroy();
 
+		//Called after each Update with the buffer that frame will Render from. With a pipeline depth above 1
+		//Render runs on its own thread alongside the next Updates, so copy everything it reads into the
+		//buffer here and have Render read only GetRenderBuffer's copy. There are pipeline depth buffers.
+		virtual void CopyRenderState(u32 buffer);
+
+		//Called on the thread that Renders, before the first and after the last Render. With a pipeline depth
+		//above 1 that's the render thread, so make the D3D or GL context current there and release it again.
+		virtual void InitRenderThread();
+		virtual void ShutdownRenderThread();
+
+		//The buffer the current Render call should read from
+		u32 GetRenderBuffer() { return m_renderBuffer; }
+		void ApplyRenderBuffer(u32 buffer) { m_renderBuffer = buffer; }
+
 	//PRIVATE FUNCTIONS
 	private:
 		WindowedApplication(const WindowedApplication &other);
 		WindowedApplication& operator = (const WindowedApplication &other);
 
+	//PRIVATE VARIABLES
+	private:
+		u32 m_renderBuffer;
+
 	};
 
 }
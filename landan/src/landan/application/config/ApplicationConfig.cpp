@@ -35,6 +35,7 @@ or implied, of Karman Interactive Ltd.
 //////////////////////////////////////////////////////////////////////
 
 #include "ApplicationConfig.h"
+#include <landan/job/JobSystem.h>
 
 //////////////////////////////////////////////////////////////////////
 // NAMESPACE /////////////////////////////////////////////////////////
@@ -48,7 +49,7 @@ namespace landan {
 	//////////////////////////////////////////////////////////////////////
 
 	ApplicationConfig::ApplicationConfig()
-	:m_applicationType(application::BASIC), m_updateType(application::RUN_ONCE), m_renderType(application::NONE), m_frameRate(60.0f)
+	:m_applicationType(application::BASIC), m_updateType(application::RUN_ONCE), m_renderType(application::NONE), m_frameRate(60.0f), m_fixedTimeStep(1000.0f/60.0f), m_maxFixedStepsPerFrame(5), m_jobWorkerCount(job::AUTO_WORKER_COUNT), m_pipelineDepth(1)
 	{
 
 	}
@@ -106,6 +107,46 @@ namespace landan {
 		m_frameRate = frameRate;
 	}
 
+	f32 ApplicationConfig::GetFixedTimeStep()
+	{
+		return m_fixedTimeStep;
+	}
+
+	void ApplicationConfig::SetFixedTimeStep(f32 milliSeconds)
+	{
+		m_fixedTimeStep = milliSeconds;
+	}
+
+	u32 ApplicationConfig::GetMaxFixedStepsPerFrame()
+	{
+		return m_maxFixedStepsPerFrame;
+	}
+
+	void ApplicationConfig::SetMaxFixedStepsPerFrame(u32 maxSteps)
+	{
+		m_maxFixedStepsPerFrame = maxSteps;
+	}
+
+	u32 ApplicationConfig::GetJobWorkerCount()
+	{
+		return m_jobWorkerCount;
+	}
+
+	void ApplicationConfig::SetJobWorkerCount(u32 workerCount)
+	{
+		m_jobWorkerCount = workerCount;
+	}
+
+	u32 ApplicationConfig::GetPipelineDepth()
+	{
+		return m_pipelineDepth;
+	}
+
+	void ApplicationConfig::SetPipelineDepth(u32 depth)
+	{
+		m_pipelineDepth = depth;
+	}
+
 
 
 }
\ No newline at end of file
@@ -68,7 +68,8 @@ namespace landan {
 		{
 			RUN_ONCE = 0,
 			FRAMERATE_LIMITED = 1,
-			FRAMERATE_UNLIMITED = 2
+			FRAMERATE_UNLIMITED = 2,
+			FIXED_TIMESTEP = 3
 		};
 
 		enum RENDER_TYPE
@@ -101,6 +102,23 @@ namespace landan {
 		f32 GetFrameRate();
 		void SetFrameRate(f32 frameRate);
 
+		//Size of a single simulation step in FIXED_TIMESTEP mode
+		f32 GetFixedTimeStep();
+		void SetFixedTimeStep(f32 milliSeconds);
+
+		//Cap on simulation steps per frame in FIXED_TIMESTEP mode, time beyond this is dropped so a slow frame can't snowball
+		u32 GetMaxFixedStepsPerFrame();
+		void SetMaxFixedStepsPerFrame(u32 maxSteps);
+
+		//Threads the scaffold starts in its JobSystem, job::AUTO_WORKER_COUNT for one per core less the main thread
+		u32 GetJobWorkerCount();
+		void SetJobWorkerCount(u32 workerCount);
+
+		//Frames in flight between Update and Render in windowed apps. 1 runs them back to back, above that
+		//Render gets its own thread and the next frames Update while it draws.
+		u32 GetPipelineDepth();
+		void SetPipelineDepth(u32 depth);
+
 
 	//PRIVATE FUNCTIONS
 	private:
@@ -113,6 +131,10 @@ namespace landan {
 		application::UPDATE_TYPE m_updateType;
 		application::RENDER_TYPE m_renderType;
 		f32 m_frameRate;
+		f32 m_fixedTimeStep;
+		u32 m_maxFixedStepsPerFrame;
+		u32 m_jobWorkerCount;
+		u32 m_pipelineDepth;
 	
 	};
 
@@ -0,0 +1,426 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "ApplicationRunner.h"
+
+#include <landan/application/IApplication.h>
+#include <landan/application/config/ApplicationConfig.h>
+#include <landan/profile/Profiler.h>
+#include <landan/thread/Atomic.h>
+#include <landan/thread/Thread.h>
+#include <landan/timer/FixedTimeStep.h>
+#include <landan/timer/FramePacer.h>
+#include <landan/timer/Timer.h>
+#include <landan/util/DebugUtil.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	struct ApplicationRunner::Instance
+	{
+		Instance(IApplication *instanceApp)
+		:app(instanceApp), quitFlag(1), running(false), updating(0), updateType(application::RUN_ONCE), budgetTicks(0), lastTicks(0),
+		frameCount(0), overrunCount(0), lastUpdateTicks(0), maxUpdateTicks(0)
+		{
+
+		}
+
+		IApplication *app;
+		ApplicationConfig config;
+		u8 quitFlag;
+		bool running;
+		//Set while the instance's Update job is queued or running, the runner leaves it alone until then
+		volatile u32 updating;
+
+		application::UPDATE_TYPE updateType;
+		//One frame or one fixed step in ticks, 0 for RUN_ONCE and FRAMERATE_UNLIMITED
+		u64 budgetTicks;
+		u64 lastTicks;
+		FixedTimeStep timeStep;
+
+		u64 frameCount;
+		u64 overrunCount;
+		u64 lastUpdateTicks;
+		u64 maxUpdateTicks;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	ApplicationRunner::ApplicationRunner()
+	:p_framePacer(0), m_quit(0), m_runningCount(0)
+	{
+		//Initialize the Timer statically so we know how fast the system is.
+		Timer::Init();
+
+		//Sleeps the runner thread until the next instance is due
+		p_framePacer = new FramePacer();
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	ApplicationRunner::~ApplicationRunner()
+	{
+		Stop();
+
+		for (u32 i = 0; i < m_instances.size(); i++)
+		{
+			delete m_instances[i];
+		}
+		m_instances.clear();
+
+		if (p_framePacer != 0)
+		{
+			delete p_framePacer;
+			p_framePacer = 0;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// PUBLIC FUNCTIONS //////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool ApplicationRunner::Start(u32 workerCount)
+	{
+		return m_jobSystem.Start(workerCount);
+	}
+
+	u32 ApplicationRunner::Add(IApplication *app)
+	{
+		Instance *instance = new Instance(app);
+		ApplicationConfig &config = instance->config;
+
+		//The same defaults a Basic Application gets from the scaffold
+		config.SetApplicationType(application::BASIC);
+		config.SetRenderType(application::NONE);
+		config.SetUpdateType(application::RUN_ONCE);
+
+		app->ApplyQuitFlag(&instance->quitFlag);
+		app->ApplyJobSystem(&m_jobSystem);
+		app->ApplyConfig(&config);
+
+		if (config.GetApplicationType() != application::BASIC || config.GetRenderType() != application::NONE)
+		{
+			LOG_ERROR("The Application Runner only hosts Basic Applications with their render type set to NONE.");
+			delete instance;
+			return 0;
+		}
+
+		instance->updateType = config.GetUpdateType();
+		u64 currentTicks = Timer::GetTicks();
+		instance->lastTicks = currentTicks;
+
+		if (instance->updateType == application::FRAMERATE_LIMITED)
+		{
+			instance->budgetTicks = static_cast<u64>(1000.0 / static_cast<f64>(config.GetFrameRate()) * static_cast<f64>(Timer::TICKS_PER_MILLISECOND));
+			//Back date the last frame so the first Update is due immediately
+			instance->lastTicks = currentTicks - instance->budgetTicks;
+		}
+		else if (instance->updateType == application::FIXED_TIMESTEP)
+		{
+			if (!instance->timeStep.SetStep(config.GetFixedTimeStep(), config.GetMaxFixedStepsPerFrame()))
+			{
+				LOG_ERROR("Fixed Timestep requires a time step and max steps per frame greater than zero.");
+				delete instance;
+				return 0;
+			}
+			instance->budgetTicks = instance->timeStep.GetStepTicks();
+			instance->timeStep.Reset(currentTicks);
+		}
+		else if (instance->updateType != application::RUN_ONCE && instance->updateType != application::FRAMERATE_UNLIMITED)
+		{
+			LOG_ERROR("Update Type is not a known type. Currently set to " << instance->updateType);
+			delete instance;
+			return 0;
+		}
+
+		app->Init();
+
+		instance->running = true;
+		m_instances.push_back(instance);
+		m_runningCount++;
+		return static_cast<u32>(m_instances.size());
+	}
+
+	void ApplicationRunner::Run()
+	{
+		u32 idleCount = 0;
+		while (m_runningCount > 0 && AtomicLoadAcquire(&m_quit) == 0)
+		{
+			u64 currentTicks = Timer::GetTicks();
+			u64 nextTicks = ~0ull;
+			u32 updatingCount = 0;
+			bool progressed = false;
+
+			for (u32 i = 0; i < m_instances.size(); i++)
+			{
+				Instance &instance = *m_instances[i];
+				if (!instance.running)
+				{
+					continue;
+				}
+
+				if (AtomicLoadAcquire(&instance.updating) == 1)
+				{
+					updatingCount++;
+				}
+				else if (instance.quitFlag == 0)
+				{
+					Retire(instance);
+					progressed = true;
+				}
+				else if (IsDue(instance, currentTicks, nextTicks))
+				{
+					//No barrier, the instance is picked up again on the first pass after its job finishes
+					AtomicStoreRelease(&instance.updating, 1);
+					m_jobSystem.Run(m_jobSystem.Create(MEMBER_FUNCTION(&ApplicationRunner::UpdateJob, this), &instance));
+					updatingCount++;
+					progressed = true;
+				}
+			}
+
+			if (progressed)
+			{
+				idleCount = 0;
+			}
+			if (updatingCount > 0)
+			{
+				HelpUpdates(idleCount);
+			}
+			else if (nextTicks != ~0ull)
+			{
+				LANDAN_PROFILE_SCOPE("Idle");
+				p_framePacer->WaitUntil(nextTicks);
+			}
+		}
+
+		//Nothing may still be touching an instance once Run returns
+		idleCount = 0;
+		for (u32 i = 0; i < m_instances.size(); i++)
+		{
+			while (AtomicLoadAcquire(&m_instances[i]->updating) == 1)
+			{
+				HelpUpdates(idleCount);
+			}
+		}
+
+		//Cleared on the way out so a Quit from before Run started still counts
+		AtomicStoreRelease(&m_quit, 0);
+	}
+
+	void ApplicationRunner::Quit()
+	{
+		AtomicStoreRelease(&m_quit, 1);
+	}
+
+	void ApplicationRunner::QuitInstance(u32 instance)
+	{
+		if (instance == 0 || instance > m_instances.size())
+		{
+			return;
+		}
+		m_instances[instance - 1]->app->Quit();
+	}
+
+	void ApplicationRunner::Stop()
+	{
+		for (u32 i = 0; i < m_instances.size(); i++)
+		{
+			if (m_instances[i]->running)
+			{
+				Retire(*m_instances[i]);
+			}
+		}
+
+		//Last, an instance's Destroy may still hand work to the pool
+		m_jobSystem.Stop();
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	u32 ApplicationRunner::GetInstanceCount()
+	{
+		return static_cast<u32>(m_instances.size());
+	}
+
+	u32 ApplicationRunner::GetRunningCount()
+	{
+		return m_runningCount;
+	}
+
+	bool ApplicationRunner::GetInstanceStats(u32 instance, InstanceStats &stats)
+	{
+		if (instance == 0 || instance > m_instances.size())
+		{
+			return false;
+		}
+
+		Instance &source = *m_instances[instance - 1];
+		f64 ticksPerMilliSecond = static_cast<f64>(Timer::TICKS_PER_MILLISECOND);
+		stats.frameCount = source.frameCount;
+		stats.overrunCount = source.overrunCount;
+		stats.budgetMilliSeconds = static_cast<f64>(source.budgetTicks) / ticksPerMilliSecond;
+		stats.lastUpdateMilliSeconds = static_cast<f64>(source.lastUpdateTicks) / ticksPerMilliSecond;
+		stats.maxUpdateMilliSeconds = static_cast<f64>(source.maxUpdateTicks) / ticksPerMilliSecond;
+		stats.running = source.running;
+		return true;
+	}
+
+	JobSystem* ApplicationRunner::GetJobSystem()
+	{
+		return &m_jobSystem;
+	}
+
+	FramePacer* ApplicationRunner::GetFramePacer()
+	{
+		return p_framePacer;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// PRIVATE FUNCTIONS /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool ApplicationRunner::IsDue(Instance &instance, u64 currentTicks, u64 &nextTicks)
+	{
+		u64 dueTicks = currentTicks;
+
+		if (instance.updateType == application::RUN_ONCE)
+		{
+			return instance.frameCount == 0;
+		}
+		else if (instance.updateType == application::FRAMERATE_LIMITED)
+		{
+			//Round the deadline up a tick so we never wake a hair before the frame is due
+			dueTicks = instance.lastTicks + instance.budgetTicks + 1;
+		}
+		else if (instance.updateType == application::FIXED_TIMESTEP)
+		{
+			dueTicks = currentTicks + instance.timeStep.GetTicksUntilStep(currentTicks);
+		}
+
+		if (dueTicks > currentTicks)
+		{
+			nextTicks = (dueTicks < nextTicks) ? dueTicks : nextTicks;
+			return false;
+		}
+		return true;
+	}
+
+	void ApplicationRunner::UpdateJob(Job &job)
+	{
+		LANDAN_PROFILE_SCOPE("Update");
+		Instance *instance = static_cast<Instance*>(job.data);
+		UpdateInstance(*instance);
+		AtomicStoreRelease(&instance->updating, 0);
+	}
+
+	void ApplicationRunner::UpdateInstance(Instance &instance)
+	{
+		u64 startTicks = Timer::GetTicks();
+		u32 steps = 1;
+
+		if (instance.updateType == application::RUN_ONCE)
+		{
+			instance.app->Update(0.0f);
+			instance.app->Quit();
+		}
+		else if (instance.updateType == application::FIXED_TIMESTEP)
+		{
+			FixedTimeStep &timeStep = instance.timeStep;
+			timeStep.Advance(startTicks);
+			while (instance.quitFlag == 1 && timeStep.ConsumeStep())
+			{
+				instance.app->Update(timeStep.GetStepMilliSeconds());
+			}
+			steps = timeStep.EndFrame();
+		}
+		else
+		{
+			f32 deltaMilliSeconds = static_cast<f32>(static_cast<f64>(startTicks - instance.lastTicks) / static_cast<f64>(Timer::TICKS_PER_MILLISECOND));
+			instance.lastTicks = startTicks;
+			instance.app->Update(deltaMilliSeconds);
+		}
+
+		u64 updateTicks = Timer::GetTicks() - startTicks;
+		instance.frameCount++;
+		instance.lastUpdateTicks = updateTicks;
+		instance.maxUpdateTicks = (updateTicks > instance.maxUpdateTicks) ? updateTicks : instance.maxUpdateTicks;
+		//No steps means the instance quit before its first one, there's no budget to overrun
+		if (instance.budgetTicks != 0 && steps != 0 && updateTicks > instance.budgetTicks * steps)
+		{
+			instance.overrunCount++;
+		}
+	}
+
+	void ApplicationRunner::HelpUpdates(u32 &idleCount)
+	{
+		//With pool threads the runner keeps out of the Updates so it's free to re-arm instances as they finish
+		if (m_jobSystem.GetWorkerCount() == 0 && m_jobSystem.RunQueuedJob())
+		{
+			idleCount = 0;
+		}
+		//Same back off as the pipelined scaffold, a long Update shouldn't cost the pool a core
+		else if (idleCount < IDLE_YIELD_COUNT)
+		{
+			idleCount++;
+			Thread::YieldThread();
+		}
+		else
+		{
+			Thread::SleepFor(1);
+		}
+	}
+
+	void ApplicationRunner::Retire(Instance &instance)
+	{
+		instance.app->Destroy();
+		instance.running = false;
+		m_runningCount--;
+	}
+
+}
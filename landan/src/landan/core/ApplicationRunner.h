@@ -0,0 +1,151 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: ApplicationRunner
+*Description: Hosts many headless applications in one process. Each instance keeps its own config,
+*quit flag and frame budget. Each instance that's due Updates as its own job on one shared JobSystem
+*and is re-armed once that job finishes, so a slow instance never holds up the rest. Stands in for one
+*ApplicationScaffold per process when running simulations.
+*Author: jkeon
+**********************************/
+
+#ifndef _APPLICATIONRUNNER_H_
+#define _APPLICATIONRUNNER_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/job/JobSystem.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class IApplication;
+	class FramePacer;
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	struct InstanceStats
+	{
+		u64 frameCount;
+		//Frames whose Update took longer than the budget
+		u64 overrunCount;
+		//One frame at the instance's frame rate or one fixed step, 0 when the instance is unlimited
+		f64 budgetMilliSeconds;
+		f64 lastUpdateMilliSeconds;
+		f64 maxUpdateMilliSeconds;
+		bool running;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class ApplicationRunner {
+
+	//PUBLIC FUNCTIONS
+	public:
+		ApplicationRunner();
+		//Stops the runner if it's still running
+		~ApplicationRunner();
+
+		//Starts the shared worker pool. With no workers the thread calling Run does every Update itself.
+		bool Start(u32 workerCount = job::AUTO_WORKER_COUNT);
+
+		//Applies the app's config and Inits it on the calling thread, returns the instance ID or 0 if
+		//the config isn't a headless one. Apps aren't owned by the runner and must outlive it. Instances
+		//can't be added while Run is in progress.
+		u32 Add(IApplication *app);
+
+		//Ticks until every instance has quit or Quit is called
+		void Run();
+		//Safe to call from any thread, Run returns after the current tick or straight away if it hasn't started
+		void Quit();
+		//The same as the instance calling Quit on itself
+		void QuitInstance(u32 instance);
+		//Destroys every instance still running and stops the worker pool
+		void Stop();
+
+		u32 GetInstanceCount();
+		u32 GetRunningCount();
+		bool GetInstanceStats(u32 instance, InstanceStats &stats);
+		JobSystem* GetJobSystem();
+		FramePacer* GetFramePacer();
+
+	//PRIVATE FUNCTIONS
+	private:
+		ApplicationRunner(const ApplicationRunner &other);
+		ApplicationRunner& operator = (const ApplicationRunner &other);
+
+		struct Instance;
+
+		//Whether the instance wants an Update this tick, otherwise pulls nextTicks in to when it will
+		bool IsDue(Instance &instance, u64 currentTicks, u64 &nextTicks);
+		void UpdateJob(Job &job);
+		void UpdateInstance(Instance &instance);
+		//Runs a queued job on the calling thread when there's no pool to run it, otherwise yields and
+		//then sleeps once IDLE_YIELD_COUNT empty passes have gone by. Callers reset idleCount on progress.
+		void HelpUpdates(u32 &idleCount);
+		void Retire(Instance &instance);
+
+	//PUBLIC VARIABLES
+	public:
+		//Empty passes the runner yields through while Updates are in flight before it starts sleeping
+		static const u32 IDLE_YIELD_COUNT = 1024;
+
+	//PRIVATE VARIABLES
+	private:
+		JobSystem m_jobSystem;
+		FramePacer *p_framePacer;
+		volatile u32 m_quit;
+
+		std::vector<Instance*> m_instances;
+		u32 m_runningCount;
+
+	};
+
+}
+#endif
@@ -44,7 +44,15 @@ or implied, of Karman Interactive Ltd.
 #include <landan/application/BasicApplication.h>
 #include <landan/application/WindowedApplication.h>
 #include <landan/application/config/ApplicationConfig.h>
+#include <landan/job/JobSystem.h>
+#include <landan/util/DebugUtil.h>
+#include <landan/timer/FixedTimeStep.h>
 #include <landan/timer/Timer.h>
+#include <landan/timer/FramePacer.h>
+#include <landan/profile/FrameProfiler.h>
+#include <landan/profile/Profiler.h>
+#include <landan/thread/Atomic.h>
+#include <landan/thread/Thread.h>
 
 //////////////////////////////////////////////////////////////////////
 // NAMESPACE /////////////////////////////////////////////////////////
@@ -57,7 +65,7 @@ namespace landan {
 	//////////////////////////////////////////////////////////////////////
 
 	ApplicationScaffold::ApplicationScaffold(IApplication *app)
-	:p_app(app)
+	:p_app(app), p_appConfig(0), p_framePacer(0), p_frameProfiler(0), p_jobSystem(0), p_renderThread(0), m_pipelineDepth(1), m_renderInline(false), m_framesSubmitted(0), m_framesRendered(0), m_renderRunning(0), m_renderTicks(0), m_renderTicksCharged(0), p_quitFlag(0)
 	{
 		
 	}
@@ -68,22 +76,48 @@ namespace landan {
 
 	ApplicationScaffold::~ApplicationScaffold() 
 	{
+		StopRenderThread();
+
 		if (p_appConfig != 0)
 		{
 			delete p_appConfig;
 			p_appConfig = 0;
 		}
 
+		if (p_framePacer != 0)
+		{
+			delete p_framePacer;
+			p_framePacer = 0;
+		}
+
+		if (p_frameProfiler != 0)
+		{
+			delete p_frameProfiler;
+			p_frameProfiler = 0;
+		}
+
+		if (p_jobSystem != 0)
+		{
+			delete p_jobSystem;
+			p_jobSystem = 0;
+		}
+
 		if (p_quitFlag != 0)
 		{
 			delete p_quitFlag;
 			p_quitFlag = 0;
+
+			//Only retained if Init ran, the last scaffold out flushes anything still queued
+			DebugUtil::ReleaseAsyncLogging();
 		}
 		p_app = 0;
 	}
 
 	void ApplicationScaffold::Init()
 	{
+		//Move log output off the update thread, the logger is shared by every scaffold in the process
+		DebugUtil::RetainAsyncLogging();
+
 		//Assign a Quit Flag into the Application
 		p_quitFlag = new u8();
 		*p_quitFlag = 1;
@@ -94,6 +128,220 @@ namespace landan {
 
 		//Initialize the Timer statically so we know how fast the system is.
 		Timer::Init();
+
+		//Used to wait out the remainder of each frame in the limited update loops
+		p_framePacer = new FramePacer();
+
+		//Always on, it costs a few timer reads per frame
+		p_frameProfiler = new FrameProfiler();
+
+		//Handed over now so ApplyConfig can see it, the workers only start once the config is applied
+		p_jobSystem = new JobSystem();
+		p_app->ApplyJobSystem(p_jobSystem);
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	FramePacer* ApplicationScaffold::GetFramePacer()
+	{
+		return p_framePacer;
+	}
+
+	FrameProfiler* ApplicationScaffold::GetFrameProfiler()
+	{
+		return p_frameProfiler;
+	}
+
+	JobSystem* ApplicationScaffold::GetJobSystem()
+	{
+		return p_jobSystem;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// LOOP HELPERS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	void ApplicationScaffold::UpdateApp(f32 deltaMilliSeconds)
+	{
+		LANDAN_PROFILE_SCOPE("Update");
+		u64 startTicks = Timer::GetTicks();
+		p_app->Update(deltaMilliSeconds);
+		p_frameProfiler->AddTicks(profile::UPDATE, Timer::GetTicks() - startTicks);
+	}
+
+	void ApplicationScaffold::RenderApp(f32 interpolationAlpha)
+	{
+		LANDAN_PROFILE_SCOPE("Render");
+		u64 startTicks = Timer::GetTicks();
+		static_cast<WindowedApplication*>(p_app)->Render(interpolationAlpha);
+		p_frameProfiler->AddTicks(profile::RENDER, Timer::GetTicks() - startTicks);
+	}
+
+	void ApplicationScaffold::WaitUntil(u64 deadlineTicks)
+	{
+		LANDAN_PROFILE_SCOPE("Idle");
+		u64 startTicks = Timer::GetTicks();
+		p_framePacer->WaitUntil(deadlineTicks);
+		p_frameProfiler->AddTicks(profile::IDLE, Timer::GetTicks() - startTicks);
+	}
+
+	void ApplicationScaffold::StartJobSystem()
+	{
+		if (!p_jobSystem->Start(p_appConfig->GetJobWorkerCount()))
+		{
+			LOG_ERROR("Job System failed to start its worker threads.");
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// FRAME PIPELINE ////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	void ApplicationScaffold::StartRenderThread()
+	{
+		m_pipelineDepth = p_appConfig->GetPipelineDepth();
+		if (m_pipelineDepth < 1 || m_pipelineDepth > MAX_PIPELINE_DEPTH)
+		{
+			LOG_ERROR("Pipeline Depth must be between 1 and " << MAX_PIPELINE_DEPTH << ". Currently set to " << m_pipelineDepth);
+			m_pipelineDepth = (m_pipelineDepth < 1) ? 1 : MAX_PIPELINE_DEPTH;
+		}
+		if (m_pipelineDepth == 1)
+		{
+			static_cast<WindowedApplication*>(p_app)->InitRenderThread();
+			m_renderInline = true;
+			return;
+		}
+
+		m_framesSubmitted = 0;
+		m_framesRendered = 0;
+		m_renderTicks = 0;
+		m_renderTicksCharged = 0;
+		AtomicStoreRelease(&m_renderRunning, 1);
+
+		p_renderThread = new Thread(MEMBER_FUNCTION(&ApplicationScaffold::RenderLoop, this));
+		if (!p_renderThread->Start())
+		{
+			LOG_ERROR("Render thread failed to start, rendering in step with Update instead.");
+			delete p_renderThread;
+			p_renderThread = 0;
+			m_pipelineDepth = 1;
+			static_cast<WindowedApplication*>(p_app)->InitRenderThread();
+			m_renderInline = true;
+		}
+	}
+
+	void ApplicationScaffold::StopRenderThread()
+	{
+		if (p_renderThread == 0)
+		{
+			if (m_renderInline)
+			{
+				static_cast<WindowedApplication*>(p_app)->ShutdownRenderThread();
+				m_renderInline = false;
+			}
+			return;
+		}
+
+		//The render thread finishes every submitted frame before it exits
+		AtomicStoreRelease(&m_renderRunning, 0);
+		p_renderThread->Join();
+		delete p_renderThread;
+		p_renderThread = 0;
+	}
+
+	void ApplicationScaffold::PresentFrame(f32 interpolationAlpha)
+	{
+		WindowedApplication *app = static_cast<WindowedApplication*>(p_app);
+
+		if (p_renderThread == 0)
+		{
+			app->CopyRenderState(0);
+			app->ApplyRenderBuffer(0);
+			RenderApp(interpolationAlpha);
+			p_frameProfiler->EndFrame();
+			return;
+		}
+
+		//This frame's buffer was last used depth frames ago, wait for that one to finish rendering
+		u32 frame = m_framesSubmitted;
+		if (frame - AtomicLoadAcquire(&m_framesRendered) >= m_pipelineDepth)
+		{
+			LANDAN_PROFILE_SCOPE("Idle");
+			u64 startTicks = Timer::GetTicks();
+			u32 idleCount = 0;
+			while (frame - AtomicLoadAcquire(&m_framesRendered) >= m_pipelineDepth)
+			{
+				//Same back off as the render thread, a long frame on the other side shouldn't burn a core
+				if (idleCount < RENDER_IDLE_YIELD_COUNT)
+				{
+					idleCount++;
+					Thread::YieldThread();
+				}
+				else
+				{
+					Thread::SleepFor(1);
+				}
+			}
+			p_frameProfiler->AddTicks(profile::IDLE, Timer::GetTicks() - startTicks);
+		}
+
+		u32 buffer = frame % m_pipelineDepth;
+		app->CopyRenderState(buffer);
+		m_renderAlphas[buffer] = interpolationAlpha;
+		AtomicStoreRelease(&m_framesSubmitted, frame + 1);
+
+		//Renders finish on the other thread, so each frame is charged whatever render time completed since the last one
+		u64 renderTicks = AtomicLoadAcquire(&m_renderTicks);
+		p_frameProfiler->AddTicks(profile::RENDER, renderTicks - m_renderTicksCharged);
+		m_renderTicksCharged = renderTicks;
+		p_frameProfiler->EndFrame();
+	}
+
+	void ApplicationScaffold::RenderLoop()
+	{
+		WindowedApplication *app = static_cast<WindowedApplication*>(p_app);
+		u32 idleCount = 0;
+		app->InitRenderThread();
+
+		for (;;)
+		{
+			//Only this thread moves the rendered count
+			u32 frame = m_framesRendered;
+			if (AtomicLoadAcquire(&m_framesSubmitted) != frame)
+			{
+				u32 buffer = frame % m_pipelineDepth;
+				app->ApplyRenderBuffer(buffer);
+
+				LANDAN_PROFILE_SCOPE("Render");
+				u64 startTicks = Timer::GetTicks();
+				app->Render(m_renderAlphas[buffer]);
+				AtomicFetchAdd(&m_renderTicks, Timer::GetTicks() - startTicks);
+
+				AtomicStoreRelease(&m_framesRendered, frame + 1);
+				idleCount = 0;
+			}
+			else if (AtomicLoadAcquire(&m_renderRunning) == 0)
+			{
+				//A last frame may have been submitted between the two checks
+				if (AtomicLoadAcquire(&m_framesSubmitted) == frame)
+				{
+					break;
+				}
+			}
+			else if (idleCount < RENDER_IDLE_YIELD_COUNT)
+			{
+				idleCount++;
+				Thread::YieldThread();
+			}
+			else
+			{
+				Thread::SleepFor(1);
+			}
+		}
+
+		app->ShutdownRenderThread();
 	}
 
 	//////////////////////////////////////////////////////////////////////
@@ -122,6 +370,8 @@ namespace landan {
 		}
 
 
+		StartJobSystem();
+
 		//Initialize the App
 		p_app->Init();
 
@@ -136,7 +386,8 @@ namespace landan {
 		if (updateType == application::RUN_ONCE)
 		{
 			//If we're only running once, no need to calculate anything.
-			p_app->Update(0.0f);
+			UpdateApp(0.0f);
+			p_frameProfiler->EndFrame();
 		}
 		//Case 02: The program will run continuously until the application decides to quit and will run at a specified framerate.
 		else if (updateType == application::FRAMERATE_LIMITED)
@@ -157,10 +408,12 @@ namespace landan {
 
 				if (m_deltaTime < targetMSPerFrame)
 				{
-					Sleep(0);
+					//Round the deadline up a tick so we never wake a hair before the frame is due
+					WaitUntil(static_cast<u64>((m_lastTime + targetMSPerFrame) * static_cast<f64>(Timer::TICKS_PER_MILLISECOND)) + 1);
 				}
 				else {
-					p_app->Update(m_deltaTime);
+					UpdateApp(m_deltaTime);
+					p_frameProfiler->EndFrame();
 
 					m_lastTime = m_currentTime;
 				}
@@ -179,10 +432,43 @@ namespace landan {
 				//Clamp to >0
 				m_deltaTime = (m_deltaTime > 0.0f) ? m_deltaTime : 0.0f;
 
-				p_app->Update(m_deltaTime);
+				UpdateApp(m_deltaTime);
+				p_frameProfiler->EndFrame();
 				m_lastTime = m_currentTime;
 			}
 		}
+		//Case 04: The program will run continuously until the application decides to quit and will Update in fixed size steps.
+		else if (updateType == application::FIXED_TIMESTEP)
+		{
+			FixedTimeStep timeStep;
+			if (!timeStep.SetStep(p_appConfig->GetFixedTimeStep(), p_appConfig->GetMaxFixedStepsPerFrame()))
+			{
+				LOG_ERROR("Fixed Timestep requires a time step and max steps per frame greater than zero.");
+				return;
+			}
+			f32 stepMS = timeStep.GetStepMilliSeconds();
+			timeStep.Reset(Timer::GetTicks());
+
+			while(*p_quitFlag == 1)
+			{
+				u64 currentTicks = Timer::GetTicks();
+				u64 waitTicks = timeStep.GetTicksUntilStep(currentTicks);
+
+				if (waitTicks > 0)
+				{
+					WaitUntil(currentTicks + waitTicks);
+				}
+				else {
+					timeStep.Advance(currentTicks);
+					while (*p_quitFlag == 1 && timeStep.ConsumeStep())
+					{
+						UpdateApp(stepMS);
+					}
+					timeStep.EndFrame();
+					p_frameProfiler->EndFrame();
+				}
+			}
+		}
 		//Unknown Case - Should never happen
 		else {
 			LOG_ERROR("Update Type is not a known type. Currently set to " << updateType);
@@ -192,6 +478,9 @@ namespace landan {
 	void ApplicationScaffold::StopBasic()
 	{
 		p_app->Destroy();
+
+		//After Destroy so the app can still wait on jobs while tearing down
+		p_jobSystem->Stop();
 	}
 
 
@@ -216,24 +505,26 @@ namespace landan {
 			LOG_ERROR("Windowed Applications must have their application type set to WINDOWED.");
 		}
 
+		StartJobSystem();
+
 		//Initialize the App
 		p_app->Init();
 	}
 
 	void ApplicationScaffold::RunWindowed()
 	{
-
-		WindowedApplication *p_windowedApp = static_cast<WindowedApplication*>(p_app);
-
 		//Get the Update Loop Type
 		application::UPDATE_TYPE updateType = p_appConfig->GetUpdateType();
 
+		//Render moves to its own thread when frames are pipelined, it's drained and joined once the loop exits
+		StartRenderThread();
+
 		//Case 01: The program runs once and exits normally
 		if (updateType == application::RUN_ONCE)
 		{
 			//If we're only running once, no need to calculate anything.
-			p_windowedApp->Update(0.0f);
-			p_windowedApp->Render();
+			UpdateApp(0.0f);
+			PresentFrame(1.0f);
 		}
 		//Case 02: The program will run continuously until the application decides to quit and will run at a specified framerate.
 		else if (updateType == application::FRAMERATE_LIMITED)
@@ -254,11 +545,12 @@ namespace landan {
 
 				if (m_deltaTime < targetMSPerFrame)
 				{
-					Sleep(0);
+					//Round the deadline up a tick so we never wake a hair before the frame is due
+					WaitUntil(static_cast<u64>((m_lastTime + targetMSPerFrame) * static_cast<f64>(Timer::TICKS_PER_MILLISECOND)) + 1);
 				}
 				else {
-					p_app->Update(m_deltaTime);
-					p_windowedApp->Render();
+					UpdateApp(m_deltaTime);
+					PresentFrame(1.0f);
 
 					m_lastTime = m_currentTime;
 				}
@@ -277,21 +569,51 @@ namespace landan {
 				//Clamp to >0
 				m_deltaTime = (m_deltaTime > 0.0f) ? m_deltaTime : 0.0f;
 
-				p_app->Update(m_deltaTime);
-				p_windowedApp->Render();
+				UpdateApp(m_deltaTime);
+				PresentFrame(1.0f);
 
 				m_lastTime = m_currentTime;
 			}
 		}
+		//Case 04: The program will run continuously until the application decides to quit, Updating in fixed size steps and Rendering every frame.
+		else if (updateType == application::FIXED_TIMESTEP)
+		{
+			FixedTimeStep timeStep;
+			if (!timeStep.SetStep(p_appConfig->GetFixedTimeStep(), p_appConfig->GetMaxFixedStepsPerFrame()))
+			{
+				LOG_ERROR("Fixed Timestep requires a time step and max steps per frame greater than zero.");
+				StopRenderThread();
+				return;
+			}
+			f32 stepMS = timeStep.GetStepMilliSeconds();
+			timeStep.Reset(Timer::GetTicks());
+
+			while(*p_quitFlag == 1)
+			{
+				timeStep.Advance(Timer::GetTicks());
+				while (*p_quitFlag == 1 && timeStep.ConsumeStep())
+				{
+					UpdateApp(stepMS);
+				}
+				timeStep.EndFrame();
+
+				//Render with how far we are into the next step so motion can be blended between the last two states
+				PresentFrame(timeStep.GetInterpolationAlpha());
+			}
+		}
 		//Unknown Case - Should never happen
 		else {
 			LOG_ERROR("Update Type is not a known type. Currently set to " << updateType);
 		}
+
+		StopRenderThread();
 	}
 
 	void ApplicationScaffold::StopWindowed()
 	{
 		p_app->Destroy();
+
+		p_jobSystem->Stop();
 	}
 
 }
\ No newline at end of file
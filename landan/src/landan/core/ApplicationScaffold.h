@@ -58,6 +58,10 @@ namespace landan {
 
 	class IApplication;
 	class ApplicationConfig;
+	class FramePacer;
+	class FrameProfiler;
+	class JobSystem;
+	class Thread;
 
 	//////////////////////////////////////////////////////////////////////
 	// CLASS DECLARATION /////////////////////////////////////////////////
@@ -81,11 +85,38 @@ namespace landan {
 		void RunWindowed();
 		void StopWindowed();
 
+		//Exposes the pacing jitter statistics of the limited update loops
+		FramePacer* GetFramePacer();
+
+		//Rolling Update/Render/Idle timings of the loop, safe to query from another thread
+		FrameProfiler* GetFrameProfiler();
+
+		//Worker pool shared with the app, started once the app has applied its config
+		JobSystem* GetJobSystem();
+
 	//PRIVATE FUNCTIONS
 	private:
 		ApplicationScaffold(const ApplicationScaffold &other);
 		ApplicationScaffold& operator = (const ApplicationScaffold &other);
 
+		//Wrap the app calls and frame waits so each is timed into the frame profiler
+		void UpdateApp(f32 deltaMilliSeconds);
+		void RenderApp(f32 interpolationAlpha);
+		void WaitUntil(u64 deadlineTicks);
+		void StartJobSystem();
+
+		//Windowed frame pipelining, without a render thread PresentFrame just renders in place
+		void StartRenderThread();
+		void StopRenderThread();
+		void PresentFrame(f32 interpolationAlpha);
+		void RenderLoop();
+
+	//PUBLIC VARIABLES
+	public:
+		static const u32 MAX_PIPELINE_DEPTH = 4;
+		//Empty polls either end of the pipeline yields through before it starts sleeping
+		static const u32 RENDER_IDLE_YIELD_COUNT = 1024;
+
 	//PRIVATE VARIABLES
 	private:
 		IApplication *p_app;
@@ -94,6 +125,22 @@ namespace landan {
 		f32 m_deltaTime;
 
 		ApplicationConfig *p_appConfig;
+		FramePacer *p_framePacer;
+		FrameProfiler *p_frameProfiler;
+		JobSystem *p_jobSystem;
+
+		//Frame f is copied into buffer f % depth, the update thread only reuses a buffer once its frame is rendered
+		Thread *p_renderThread;
+		u32 m_pipelineDepth;
+		//The app's render thread hooks ran on the update thread and still need their shutdown
+		bool m_renderInline;
+		volatile u32 m_framesSubmitted;
+		volatile u32 m_framesRendered;
+		volatile u32 m_renderRunning;
+		f32 m_renderAlphas[MAX_PIPELINE_DEPTH];
+		//Accumulated by the render thread, charged to the profiler by the update thread as frames end
+		volatile u64 m_renderTicks;
+		u64 m_renderTicksCharged;
 
 		u8 *p_quitFlag;
 	
@@ -210,6 +257,29 @@ namespace landan {
 			return 0;																								\
 		}						
 	#endif
+#else
+	//Only basic applications are supported off Windows until SystemWindow is ported
+	#define CREATE_LANDAN_BASIC_APPLICATION(BASIC_APPLICATION_CLASS)												\
+	int main(int argc, const char* argv[])																			\
+	{																												\
+		IApplication *app = new BASIC_APPLICATION_CLASS();															\
+		ApplicationScaffold *scaffold = new ApplicationScaffold(app);												\
+		scaffold->Init();																							\
+		scaffold->PrepBasic();																						\
+		scaffold->RunBasic();																						\
+		scaffold->StopBasic();																						\
+		if (scaffold != 0)																							\
+		{																											\
+			delete scaffold;																						\
+			scaffold = 0;																							\
+		}																											\
+		if (app != 0)																								\
+		{																											\
+			delete app;																								\
+			app = 0;																								\
+		}																											\
+		return 0;																									\
+	}
 #endif
 
 
@@ -81,19 +81,50 @@ or implied, of Karman Interactive Ltd.
 #include <landan/application/WindowedApplication.h>
 
 //core
+#include <landan/core/ApplicationRunner.h>
 #include <landan/core/ApplicationScaffold.h>
 
 //file
+#include <landan/file/AsyncFileService.h>
+#include <landan/file/CompressedStream.h>
 #include <landan/file/File.h>
+#include <landan/file/FileStream.h>
+#include <landan/file/MappedFile.h>
+#include <landan/file/PackFile.h>
+
+//job
+#include <landan/job/JobSystem.h>
+#include <landan/job/WorkStealingDeque.h>
+
+//profile
+#include <landan/profile/FrameProfiler.h>
+#include <landan/profile/Profiler.h>
+
+//thread
+#include <landan/thread/Atomic.h>
+#include <landan/thread/BoundedQueue.h>
+#include <landan/thread/Thread.h>
+#include <landan/thread/ThreadLocal.h>
 
 //timer
+#include <landan/timer/FixedTimeStep.h>
+#include <landan/timer/FramePacer.h>
 #include <landan/timer/Timer.h>
 
 //util
+#include <landan/util/Archive.h>
+#include <landan/util/AsyncLogger.h>
+#include <landan/util/BinaryLog.h>
+#include <landan/util/BitStream.h>
 #include <landan/util/ByteArray.h>
+#include <landan/util/ByteStream.h>
+#include <landan/util/ByteSwap.h>
+#include <landan/util/Compression.h>
 #include <landan/util/DebugUtil.h>
 #include <landan/util/EndianUtil.h>
 #include <landan/util/Function.h>
+#include <landan/util/LogRecord.h>
+#include <landan/util/VarInt.h>
 
 //window
 #include <landan/window/SystemWindow.h>
@@ -41,7 +41,7 @@ or implied, of Karman Interactive Ltd.
 
 //Always ensure _UNICODE is defined as per UTF8 instructions on http://www.utf8everywhere.org/
 #ifndef _UNICODE
-define _UNICODE
+#define _UNICODE
 #endif
 
 //////////////////////////////////////////////////////////////////////
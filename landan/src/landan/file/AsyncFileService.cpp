@@ -0,0 +1,673 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "AsyncFileService.h"
+#include <cstring>
+#include <landan/thread/Atomic.h>
+#include <landan/thread/Thread.h>
+#include <landan/util/ByteArray.h>
+
+#ifdef _WIN32
+	#include <Windows.h>
+	#include <nowide/convert.hpp>
+#else
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+//Built against the kernel header directly rather than liburing, the raw interface is small
+#if defined(__linux__) && defined(__has_include)
+	#if __has_include(<linux/io_uring.h>)
+		#include <linux/io_uring.h>
+		#include <sys/mman.h>
+		#include <sys/syscall.h>
+		#include <sys/uio.h>
+		#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+			#define LANDAN_IO_URING
+		#endif
+	#endif
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+#ifdef LANDAN_IO_URING
+	struct AsyncFileService::Ring
+	{
+		int fd;
+		u32 entryCount;
+		//Written to the submission queue but not yet handed to the kernel
+		u32 unsubmitted;
+
+		u8 *submissionRing;
+		size_t submissionRingSize;
+		u8 *completionRing;
+		size_t completionRingSize;
+		io_uring_sqe *entries;
+		size_t entriesSize;
+
+		volatile u32 *submissionTail;
+		volatile u32 *submissionArray;
+		u32 submissionMask;
+		volatile u32 *completionHead;
+		volatile u32 *completionTail;
+		u32 completionMask;
+		io_uring_cqe *completions;
+
+		//One slot per submission queue entry, so the queue can never overflow
+		std::vector<Request> inFlight;
+		std::vector<iovec> vectors;
+		std::vector<u32> freeSlots;
+	};
+#else
+	struct AsyncFileService::Ring
+	{
+	};
+#endif
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+	static const file::NATIVE_HANDLE INVALID_NATIVE_HANDLE = INVALID_HANDLE_VALUE;
+
+	static file::NATIVE_HANDLE OpenNative(const string &path, file::IO_ACCESS access)
+	{
+		bool write = (access == file::READ_WRITE);
+		return CreateFileW(nowide::widen(path).c_str(), write ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, 0, write ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	}
+
+	static void CloseNative(file::NATIVE_HANDLE handle)
+	{
+		CloseHandle(handle);
+	}
+
+	//Blocking positioned I/O, the handle's own file pointer is never used
+	static u32 TransferNative(file::NATIVE_HANDLE handle, file::REQUEST_TYPE type, u64 offset, u8 *data, u32 length, bool &success)
+	{
+		u32 total = 0;
+		success = true;
+		while (total < length)
+		{
+			OVERLAPPED overlapped;
+			memset(&overlapped, 0, sizeof(overlapped));
+			overlapped.Offset = static_cast<DWORD>(offset + total);
+			overlapped.OffsetHigh = static_cast<DWORD>((offset + total) >> 32);
+			DWORD transferred = 0;
+			BOOL result = (type == file::REQUEST_READ)
+				? ReadFile(handle, data + total, length - total, &transferred, &overlapped)
+				: WriteFile(handle, data + total, length - total, &transferred, &overlapped);
+			if (!result)
+			{
+				success = (GetLastError() == ERROR_HANDLE_EOF);
+				break;
+			}
+			if (transferred == 0)
+			{
+				success = (type == file::REQUEST_READ);
+				break;
+			}
+			total += transferred;
+		}
+		return total;
+	}
+#else
+	static const file::NATIVE_HANDLE INVALID_NATIVE_HANDLE = -1;
+
+	static file::NATIVE_HANDLE OpenNative(const string &path, file::IO_ACCESS access)
+	{
+		int flags = O_CLOEXEC | ((access == file::READ_WRITE) ? (O_RDWR | O_CREAT) : O_RDONLY);
+		return open(path.c_str(), flags, 0644);
+	}
+
+	static void CloseNative(file::NATIVE_HANDLE handle)
+	{
+		close(handle);
+	}
+
+	static u32 TransferNative(file::NATIVE_HANDLE handle, file::REQUEST_TYPE type, u64 offset, u8 *data, u32 length, bool &success)
+	{
+		u32 total = 0;
+		success = true;
+		while (total < length)
+		{
+			ssize_t transferred = (type == file::REQUEST_READ)
+				? pread(handle, data + total, length - total, static_cast<off_t>(offset + total))
+				: pwrite(handle, data + total, length - total, static_cast<off_t>(offset + total));
+			if (transferred < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (transferred <= 0)
+			{
+				//0 from a read is the end of the file, anything else is a failure
+				success = (transferred == 0 && type == file::REQUEST_READ);
+				break;
+			}
+			total += static_cast<u32>(transferred);
+		}
+		return total;
+	}
+#endif
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	AsyncFileService::AsyncFileService(u32 workerCount, u32 capacity, file::IO_BACKEND preferred)
+	:m_preferred(preferred), m_backend(file::BACKEND_THREADS), m_workerCount((workerCount > 0) ? workerCount : 1),
+	m_requests(capacity), m_completions(capacity), m_nextId(1), m_pendingCount(0), m_droppedCount(0), m_running(0), p_ring(0)
+	{
+		p_files = new file::NATIVE_HANDLE[MAX_FILES];
+		for (u32 i = 0; i < MAX_FILES; i++)
+		{
+			p_files[i] = INVALID_NATIVE_HANDLE;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	AsyncFileService::~AsyncFileService()
+	{
+		Stop();
+
+		if (p_files != 0)
+		{
+			for (u32 i = 0; i < MAX_FILES; i++)
+			{
+				if (p_files[i] != INVALID_NATIVE_HANDLE)
+				{
+					CloseNative(p_files[i]);
+				}
+			}
+			delete[] p_files;
+			p_files = 0;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool AsyncFileService::Start()
+	{
+		if (!m_threads.empty())
+		{
+			return false;
+		}
+		AtomicStoreRelease(&m_running, 1);
+
+		if (m_preferred == file::BACKEND_IO_URING && StartRing())
+		{
+			m_backend = file::BACKEND_IO_URING;
+			m_threads.push_back(new Thread(MEMBER_FUNCTION(&AsyncFileService::RingLoop, this)));
+		}
+		else
+		{
+			m_backend = file::BACKEND_THREADS;
+			for (u32 i = 0; i < m_workerCount; i++)
+			{
+				m_threads.push_back(new Thread(MEMBER_FUNCTION(&AsyncFileService::WorkerLoop, this)));
+			}
+		}
+
+		for (u32 i = 0; i < m_threads.size(); i++)
+		{
+			if (!m_threads[i]->Start())
+			{
+				Stop();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void AsyncFileService::Stop()
+	{
+		AtomicStoreRelease(&m_running, 0);
+		for (u32 i = 0; i < m_threads.size(); i++)
+		{
+			m_threads[i]->Join();
+			delete m_threads[i];
+		}
+		m_threads.clear();
+		StopRing();
+	}
+
+	u32 AsyncFileService::Open(const string &path, file::IO_ACCESS access)
+	{
+		for (u32 i = 0; i < MAX_FILES; i++)
+		{
+			if (p_files[i] == INVALID_NATIVE_HANDLE)
+			{
+				file::NATIVE_HANDLE handle = OpenNative(path, access);
+				if (handle == INVALID_NATIVE_HANDLE)
+				{
+					return 0;
+				}
+				p_files[i] = handle;
+				return i + 1;
+			}
+		}
+		return 0;
+	}
+
+	void AsyncFileService::Close(u32 file)
+	{
+		if (file > 0 && file <= MAX_FILES && p_files[file - 1] != INVALID_NATIVE_HANDLE)
+		{
+			CloseNative(p_files[file - 1]);
+			p_files[file - 1] = INVALID_NATIVE_HANDLE;
+		}
+	}
+
+	u32 AsyncFileService::Read(u32 file, u64 offset, ByteArray &bytes, u32 length, Function<void (const FileCompletion&)> callback)
+	{
+		if (bytes.GetMode() == bytearray::GROWABLE && bytes.GetLength() < length)
+		{
+			bytes.Resize(length);
+		}
+		length = (length < bytes.GetLength()) ? length : bytes.GetLength();
+		return Submit(file, file::REQUEST_READ, offset, bytes, bytes.GetRawBytes(), length, callback);
+	}
+
+	u32 AsyncFileService::Write(u32 file, u64 offset, ByteArray &bytes, Function<void (const FileCompletion&)> callback)
+	{
+		return Submit(file, file::REQUEST_WRITE, offset, bytes, bytes.GetRawBytes(), bytes.GetLength(), callback);
+	}
+
+	u32 AsyncFileService::Submit(u32 file, file::REQUEST_TYPE type, u64 offset, ByteArray &bytes, u8 *data, u32 length, Function<void (const FileCompletion&)> callback)
+	{
+		if (AtomicLoadAcquire(&m_running) == 0 || file == 0 || file > MAX_FILES || p_files[file - 1] == INVALID_NATIVE_HANDLE)
+		{
+			return 0;
+		}
+
+		Request request;
+		request.completion.id = AtomicFetchAdd(&m_nextId, 1);
+		if (request.completion.id == 0)
+		{
+			request.completion.id = AtomicFetchAdd(&m_nextId, 1);
+		}
+		request.completion.type = type;
+		request.completion.bytes = &bytes;
+		request.completion.offset = offset;
+		request.completion.requested = length;
+		request.completion.transferred = 0;
+		request.completion.success = false;
+		request.handle = p_files[file - 1];
+		request.data = data;
+		request.callback = callback;
+
+		//Counted before it's visible so WaitIdle can't miss it
+		AtomicFetchAdd(&m_pendingCount, 1);
+		if (!m_requests.TryPush(request))
+		{
+			AtomicFetchAdd(&m_pendingCount, 0xFFFFFFFF);
+			return 0;
+		}
+		return request.completion.id;
+	}
+
+	void AsyncFileService::Complete(Request &request, u32 transferred, bool success)
+	{
+		request.completion.transferred = transferred;
+		request.completion.success = success;
+		if (request.callback)
+		{
+			request.callback(request.completion);
+		}
+		else
+		{
+			//Back pressure, nobody is polling fast enough. Once stopping there may be nobody left to
+			//poll at all, so drop it rather than hang Stop.
+			while (!m_completions.TryPush(request.completion))
+			{
+				if (AtomicLoadAcquire(&m_running) == 0)
+				{
+					AtomicFetchAdd(&m_droppedCount, 1);
+					break;
+				}
+				Thread::YieldThread();
+			}
+		}
+		AtomicFetchAdd(&m_pendingCount, 0xFFFFFFFF);
+	}
+
+	bool AsyncFileService::PollCompletion(FileCompletion &completion)
+	{
+		return m_completions.TryPop(completion);
+	}
+
+	void AsyncFileService::WaitIdle()
+	{
+		while (AtomicLoadAcquire(&m_pendingCount) > 0)
+		{
+			Thread::SleepFor(IDLE_SLEEP_MILLISECONDS);
+		}
+	}
+
+	void AsyncFileService::WorkerLoop()
+	{
+		Request request;
+		for (;;)
+		{
+			if (m_requests.TryPop(request))
+			{
+				bool success;
+				u32 transferred = TransferNative(request.handle, request.completion.type, request.completion.offset, request.data, request.completion.requested, success);
+				Complete(request, transferred, success);
+			}
+			else if (AtomicLoadAcquire(&m_running) == 0)
+			{
+				break;
+			}
+			else
+			{
+				Thread::SleepFor(IDLE_SLEEP_MILLISECONDS);
+			}
+		}
+	}
+
+#ifdef LANDAN_IO_URING
+	bool AsyncFileService::StartRing()
+	{
+		io_uring_params params;
+		memset(&params, 0, sizeof(params));
+		u32 entries = (m_requests.GetCapacity() < 256) ? m_requests.GetCapacity() : 256;
+		int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+		if (fd < 0)
+		{
+			//Old kernel, or blocked by a sandbox
+			return false;
+		}
+
+		Ring *ring = new Ring();
+		ring->fd = fd;
+		ring->entryCount = params.sq_entries;
+		ring->unsubmitted = 0;
+		ring->submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+		ring->completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		ring->entriesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+		bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (singleMap)
+		{
+			size_t size = (ring->submissionRingSize > ring->completionRingSize) ? ring->submissionRingSize : ring->completionRingSize;
+			ring->submissionRingSize = size;
+			ring->completionRingSize = size;
+		}
+
+		void *submissionRing = mmap(0, ring->submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+		void *completionRing = MAP_FAILED;
+		void *entriesMap = MAP_FAILED;
+		if (submissionRing != MAP_FAILED)
+		{
+			completionRing = singleMap ? submissionRing : mmap(0, ring->completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+			entriesMap = mmap(0, ring->entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+		}
+		if (submissionRing == MAP_FAILED || completionRing == MAP_FAILED || entriesMap == MAP_FAILED)
+		{
+			if (entriesMap != MAP_FAILED)
+			{
+				munmap(entriesMap, ring->entriesSize);
+			}
+			if (completionRing != MAP_FAILED && completionRing != submissionRing)
+			{
+				munmap(completionRing, ring->completionRingSize);
+			}
+			if (submissionRing != MAP_FAILED)
+			{
+				munmap(submissionRing, ring->submissionRingSize);
+			}
+			close(fd);
+			delete ring;
+			return false;
+		}
+
+		ring->submissionRing = static_cast<u8*>(submissionRing);
+		ring->completionRing = static_cast<u8*>(completionRing);
+		ring->entries = static_cast<io_uring_sqe*>(entriesMap);
+		ring->submissionTail = reinterpret_cast<volatile u32*>(ring->submissionRing + params.sq_off.tail);
+		ring->submissionArray = reinterpret_cast<volatile u32*>(ring->submissionRing + params.sq_off.array);
+		ring->submissionMask = *reinterpret_cast<u32*>(ring->submissionRing + params.sq_off.ring_mask);
+		ring->completionHead = reinterpret_cast<volatile u32*>(ring->completionRing + params.cq_off.head);
+		ring->completionTail = reinterpret_cast<volatile u32*>(ring->completionRing + params.cq_off.tail);
+		ring->completionMask = *reinterpret_cast<u32*>(ring->completionRing + params.cq_off.ring_mask);
+		ring->completions = reinterpret_cast<io_uring_cqe*>(ring->completionRing + params.cq_off.cqes);
+
+		ring->inFlight.resize(ring->entryCount);
+		ring->vectors.resize(ring->entryCount);
+		for (u32 i = ring->entryCount; i > 0; i--)
+		{
+			ring->freeSlots.push_back(i - 1);
+		}
+
+		p_ring = ring;
+		return true;
+	}
+
+	void AsyncFileService::StopRing()
+	{
+		if (p_ring == 0)
+		{
+			return;
+		}
+		munmap(p_ring->entries, p_ring->entriesSize);
+		if (p_ring->completionRing != p_ring->submissionRing)
+		{
+			munmap(p_ring->completionRing, p_ring->completionRingSize);
+		}
+		munmap(p_ring->submissionRing, p_ring->submissionRingSize);
+		close(p_ring->fd);
+		delete p_ring;
+		p_ring = 0;
+	}
+
+	void AsyncFileService::RingLoop()
+	{
+		Ring &ring = *p_ring;
+		Request request;
+		for (;;)
+		{
+			u32 started = 0;
+			while (!ring.freeSlots.empty() && m_requests.TryPop(request))
+			{
+				u32 slot = ring.freeSlots.back();
+				ring.freeSlots.pop_back();
+				ring.inFlight[slot] = request;
+				PrepareRingEntry(slot);
+				started++;
+			}
+
+			u32 reaped = ReapRing();
+			u32 inFlight = ring.entryCount - static_cast<u32>(ring.freeSlots.size());
+			if (inFlight == 0)
+			{
+				if (AtomicLoadAcquire(&m_running) == 0 && m_requests.IsEmpty())
+				{
+					break;
+				}
+				if (reaped == 0)
+				{
+					Thread::SleepFor(IDLE_SLEEP_MILLISECONDS);
+				}
+				continue;
+			}
+
+			//Nothing started or finished this time round, so block until something finishes. New
+			//requests wait for that, which is at most one disk round trip.
+			if (!EnterRing((started == 0 && reaped == 0) ? 1 : 0))
+			{
+				Thread::YieldThread();
+			}
+		}
+	}
+
+	void AsyncFileService::PrepareRingEntry(u32 slot)
+	{
+		Ring &ring = *p_ring;
+		Request &request = ring.inFlight[slot];
+		u32 done = request.completion.transferred;
+
+		ring.vectors[slot].iov_base = request.data + done;
+		ring.vectors[slot].iov_len = request.completion.requested - done;
+
+		//Only this thread writes the tail, and a free slot means there's a free entry
+		u32 tail = *ring.submissionTail;
+		u32 index = tail & ring.submissionMask;
+		io_uring_sqe &entry = ring.entries[index];
+		memset(&entry, 0, sizeof(entry));
+		entry.opcode = (request.completion.type == file::REQUEST_READ) ? IORING_OP_READV : IORING_OP_WRITEV;
+		entry.fd = request.handle;
+		entry.off = request.completion.offset + done;
+		entry.addr = reinterpret_cast<u64>(&ring.vectors[slot]);
+		entry.len = 1;
+		entry.user_data = slot;
+		ring.submissionArray[index] = index;
+		AtomicStoreRelease(ring.submissionTail, tail + 1);
+		ring.unsubmitted++;
+	}
+
+	bool AsyncFileService::EnterRing(u32 waitCount)
+	{
+		Ring &ring = *p_ring;
+		if (ring.unsubmitted == 0 && waitCount == 0)
+		{
+			return true;
+		}
+		int result = static_cast<int>(syscall(__NR_io_uring_enter, ring.fd, ring.unsubmitted, waitCount, (waitCount > 0) ? IORING_ENTER_GETEVENTS : 0, 0, 0));
+		if (result < 0)
+		{
+			return errno == EINTR;
+		}
+		ring.unsubmitted -= static_cast<u32>(result);
+		return true;
+	}
+
+	u32 AsyncFileService::ReapRing()
+	{
+		Ring &ring = *p_ring;
+		u32 reaped = 0;
+		u32 head = *ring.completionHead;
+		u32 tail = AtomicLoadAcquire(ring.completionTail);
+		while (head != tail)
+		{
+			io_uring_cqe &entry = ring.completions[head & ring.completionMask];
+			u32 slot = static_cast<u32>(entry.user_data);
+			i32 result = entry.res;
+			head++;
+			AtomicStoreRelease(ring.completionHead, head);
+
+			Request &request = ring.inFlight[slot];
+			if (result > 0)
+			{
+				request.completion.transferred += static_cast<u32>(result);
+				if (request.completion.transferred < request.completion.requested)
+				{
+					//Short transfer that isn't the end of the file, go again for the rest
+					PrepareRingEntry(slot);
+					continue;
+				}
+			}
+			bool success = (result >= 0) && (result > 0 || request.completion.type == file::REQUEST_READ || request.completion.requested == 0);
+			Complete(request, request.completion.transferred, success);
+			ring.freeSlots.push_back(slot);
+			reaped++;
+			tail = AtomicLoadAcquire(ring.completionTail);
+		}
+		return reaped;
+	}
+#else
+	bool AsyncFileService::StartRing()
+	{
+		return false;
+	}
+
+	void AsyncFileService::StopRing()
+	{
+	}
+
+	void AsyncFileService::RingLoop()
+	{
+	}
+
+	void AsyncFileService::PrepareRingEntry(u32 slot)
+	{
+	}
+
+	bool AsyncFileService::EnterRing(u32 waitCount)
+	{
+		return false;
+	}
+
+	u32 AsyncFileService::ReapRing()
+	{
+		return 0;
+	}
+#endif
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	file::IO_BACKEND AsyncFileService::GetBackend()
+	{
+		return m_backend;
+	}
+
+	u32 AsyncFileService::GetPendingCount()
+	{
+		return AtomicLoadAcquire(&m_pendingCount);
+	}
+
+	u32 AsyncFileService::GetDroppedCount()
+	{
+		return AtomicLoadAcquire(&m_droppedCount);
+	}
+
+}
@@ -0,0 +1,205 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: AsyncFileService
+*Description: Positioned reads and writes that complete off the calling thread, so streaming
+*assets doesn't stall the update loop. Uses io_uring on Linux when the kernel allows it and a
+*small pool of worker threads doing blocking I/O everywhere else.
+*Author: jkeon
+**********************************/
+
+#ifndef _ASYNCFILESERVICE_H_
+#define _ASYNCFILESERVICE_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/file/FileStream.h>
+#include <landan/thread/BoundedQueue.h>
+#include <landan/util/Function.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class ByteArray;
+	class Thread;
+	struct FileCompletion;
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace file
+	{
+		enum IO_ACCESS
+		{
+			READ_ONLY = 0,
+			//Creates the file if it's missing, never truncates
+			READ_WRITE = 1
+		};
+
+		enum REQUEST_TYPE
+		{
+			REQUEST_READ = 0,
+			REQUEST_WRITE = 1
+		};
+
+		enum IO_BACKEND
+		{
+			BACKEND_THREADS = 0,
+			BACKEND_IO_URING = 1
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	struct FileCompletion
+	{
+		u32 id;
+		file::REQUEST_TYPE type;
+		ByteArray *bytes;
+		u64 offset;
+		u32 requested;
+		//Fewer than requested only for a read that hit the end of the file, or a failure
+		u32 transferred;
+		bool success;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class AsyncFileService {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//workerCount only matters for the thread backend. Capacity bounds the requests waiting to start
+		//and the completions waiting to be polled, it's rounded up to a power of two.
+		AsyncFileService(u32 workerCount = 2, u32 capacity = 256, file::IO_BACKEND preferred = file::BACKEND_IO_URING);
+		//Finishes everything already submitted
+		~AsyncFileService();
+
+		//Falls back to threads if io_uring isn't available
+		bool Start();
+		//Completions that finish while stopping and don't fit in a full completion queue are dropped
+		void Stop();
+		file::IO_BACKEND GetBackend();
+
+		//Returns a file ID for requests, 0 on failure. Files stay open until Close or the service is
+		//destroyed, close one only once its requests have completed.
+		u32 Open(const string &path, file::IO_ACCESS access = file::READ_ONLY);
+		void Close(u32 file);
+
+		//Reads length bytes at offset into the start of the array, resizing a growable one to fit and
+		//clamping to a fixed one. Writes the whole array at offset. Either way the array belongs to the
+		//service until the request completes. Returns a request ID, 0 if the queue was full or the
+		//service isn't running.
+		//With a callback the completion is handed to it on a service thread, without one it waits in
+		//the completion queue for PollCompletion.
+		u32 Read(u32 file, u64 offset, ByteArray &bytes, u32 length, Function<void (const FileCompletion&)> callback = Function<void (const FileCompletion&)>());
+		u32 Write(u32 file, u64 offset, ByteArray &bytes, Function<void (const FileCompletion&)> callback = Function<void (const FileCompletion&)>());
+
+		//Safe to call from any thread, for example once per frame from the update loop
+		bool PollCompletion(FileCompletion &completion);
+		//Submitted requests that haven't been delivered to a callback or the completion queue yet
+		u32 GetPendingCount();
+		//Completions lost because the queue was full while stopping
+		u32 GetDroppedCount();
+		//Blocks until GetPendingCount reaches 0
+		void WaitIdle();
+
+	//PRIVATE FUNCTIONS
+	private:
+		AsyncFileService(const AsyncFileService &other);
+		AsyncFileService& operator = (const AsyncFileService &other);
+
+		struct Request
+		{
+			FileCompletion completion;
+			file::NATIVE_HANDLE handle;
+			u8 *data;
+			Function<void (const FileCompletion&)> callback;
+		};
+
+		u32 Submit(u32 file, file::REQUEST_TYPE type, u64 offset, ByteArray &bytes, u8 *data, u32 length, Function<void (const FileCompletion&)> callback);
+		void Complete(Request &request, u32 transferred, bool success);
+
+		void WorkerLoop();
+		bool StartRing();
+		void StopRing();
+		void RingLoop();
+		void PrepareRingEntry(u32 slot);
+		bool EnterRing(u32 waitCount);
+		u32 ReapRing();
+
+	//PUBLIC VARIABLES
+	public:
+		static const u32 MAX_FILES = 1024;
+		static const u32 IDLE_SLEEP_MILLISECONDS = 1;
+
+	//PRIVATE VARIABLES
+	private:
+		file::IO_BACKEND m_preferred;
+		file::IO_BACKEND m_backend;
+		u32 m_workerCount;
+
+		BoundedQueue<Request> m_requests;
+		BoundedQueue<FileCompletion> m_completions;
+		volatile u32 m_nextId;
+		volatile u32 m_pendingCount;
+		volatile u32 m_droppedCount;
+		volatile u32 m_running;
+		std::vector<Thread*> m_threads;
+
+		file::NATIVE_HANDLE *p_files;
+
+		//io_uring state, defined with the backend and only touched by the ring thread once it's running
+		struct Ring;
+		Ring *p_ring;
+
+	};
+}
+#endif
@@ -0,0 +1,254 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "CompressedStream.h"
+#include <cstring>
+#include <landan/file/FileStream.h>
+#include <landan/util/ByteArray.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	CompressedWriter::CompressedWriter(FileWriter &writer, u32 chunkSize)
+	:p_writer(&writer), m_buffered(0), m_started(false), m_finished(false), m_failed(false), m_bytesIn(0), m_bytesOut(0)
+	{
+		m_chunkSize = (chunkSize == 0) ? Compression::DEFAULT_CHUNK_SIZE : ((chunkSize > Compression::MAX_CHUNK_SIZE) ? Compression::MAX_CHUNK_SIZE : chunkSize);
+		p_chunk = new u8[m_chunkSize];
+		p_encoded = new u8[Compression::GetMaxChunkSize(m_chunkSize)];
+	}
+
+	CompressedReader::CompressedReader(FileReader &reader)
+	:p_reader(&reader), m_chunkSize(0), p_chunk(0), m_chunkLength(0), m_chunkPosition(0), p_stored(0), m_started(false), m_ended(false), m_error(false)
+	{
+
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	CompressedWriter::~CompressedWriter()
+	{
+		Finish();
+		delete[] p_chunk;
+		delete[] p_encoded;
+	}
+
+	CompressedReader::~CompressedReader()
+	{
+		delete[] p_chunk;
+		delete[] p_stored;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool CompressedWriter::Append(const u8 *bytes, u32 length)
+	{
+		if (m_finished || m_failed)
+		{
+			return false;
+		}
+		if (!m_started)
+		{
+			u8 header[compression::HEADER_SIZE];
+			Compression::WriteHeader(header, m_chunkSize);
+			m_failed = !p_writer->Append(header, compression::HEADER_SIZE);
+			m_bytesOut += compression::HEADER_SIZE;
+			m_started = true;
+		}
+
+		while (length > 0 && !m_failed)
+		{
+			u32 copy = (length < m_chunkSize - m_buffered) ? length : m_chunkSize - m_buffered;
+			memcpy(p_chunk + m_buffered, bytes, copy);
+			m_buffered += copy;
+			m_bytesIn += copy;
+			bytes += copy;
+			length -= copy;
+			if (m_buffered == m_chunkSize)
+			{
+				WriteChunk();
+			}
+		}
+		return !m_failed;
+	}
+
+	bool CompressedWriter::Append(ByteArray &bytes)
+	{
+		return Append(bytes.GetRawBytes(), bytes.GetLength());
+	}
+
+	bool CompressedWriter::WriteChunk()
+	{
+		u32 length = Compression::EncodeChunk(p_chunk, m_buffered, p_encoded);
+		m_failed = m_failed || !p_writer->Append(p_encoded, length);
+		m_bytesOut += length;
+		m_buffered = 0;
+		return !m_failed;
+	}
+
+	bool CompressedWriter::Finish()
+	{
+		if (m_finished)
+		{
+			return !m_failed;
+		}
+		//Even an empty stream gets its header
+		Append(p_chunk, 0);
+		if (m_buffered > 0)
+		{
+			WriteChunk();
+		}
+		u8 end[compression::CHUNK_HEADER_SIZE];
+		Compression::WriteEndChunk(end);
+		m_failed = m_failed || !p_writer->Append(end, compression::CHUNK_HEADER_SIZE);
+		m_bytesOut += compression::CHUNK_HEADER_SIZE;
+		m_finished = true;
+		return !m_failed;
+	}
+
+	bool CompressedReader::Start()
+	{
+		m_started = true;
+		u8 header[compression::HEADER_SIZE];
+		if (p_reader->Read(header, compression::HEADER_SIZE) != compression::HEADER_SIZE)
+		{
+			m_error = true;
+			return false;
+		}
+		m_chunkSize = Compression::ReadHeader(header);
+		if (m_chunkSize == 0)
+		{
+			m_error = true;
+			return false;
+		}
+		p_chunk = new u8[m_chunkSize];
+		p_stored = new u8[Compression::GetMaxChunkSize(m_chunkSize)];
+		return true;
+	}
+
+	bool CompressedReader::NextChunk()
+	{
+		u8 header[compression::CHUNK_HEADER_SIZE];
+		if (p_reader->Read(header, compression::CHUNK_HEADER_SIZE) != compression::CHUNK_HEADER_SIZE)
+		{
+			m_error = true;
+			return false;
+		}
+
+		compression::CODEC codec;
+		u32 originalSize;
+		u32 storedSize;
+		Compression::ReadChunkHeader(header, codec, originalSize, storedSize);
+		if (codec == compression::CODEC_END)
+		{
+			m_ended = true;
+			return false;
+		}
+
+		m_error = (originalSize > m_chunkSize) || (storedSize > Compression::GetMaxChunkSize(m_chunkSize))
+			|| (p_reader->Read(p_stored, storedSize) != storedSize)
+			|| !Compression::DecodeChunk(codec, p_stored, storedSize, p_chunk, originalSize);
+		m_chunkLength = m_error ? 0 : originalSize;
+		m_chunkPosition = 0;
+		return !m_error;
+	}
+
+	u32 CompressedReader::Read(u8 *bytes, u32 length)
+	{
+		if (!m_started && !Start())
+		{
+			return 0;
+		}
+
+		u32 total = 0;
+		while (total < length)
+		{
+			if (m_chunkPosition == m_chunkLength)
+			{
+				if (m_ended || m_error || !NextChunk())
+				{
+					break;
+				}
+				continue;
+			}
+			u32 copy = (length - total < m_chunkLength - m_chunkPosition) ? length - total : m_chunkLength - m_chunkPosition;
+			memcpy(bytes + total, p_chunk + m_chunkPosition, copy);
+			m_chunkPosition += copy;
+			total += copy;
+		}
+		return total;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	u64 CompressedWriter::GetBytesIn()
+	{
+		return m_bytesIn;
+	}
+
+	u64 CompressedWriter::GetBytesOut()
+	{
+		return m_bytesOut;
+	}
+
+	bool CompressedReader::IsEndOfStream()
+	{
+		//The end chunk may not have been reached yet if the last read stopped right on the end of the data
+		if (m_chunkPosition == m_chunkLength && !m_ended && !m_error && (m_started || Start()))
+		{
+			NextChunk();
+		}
+		return m_ended && m_chunkPosition == m_chunkLength;
+	}
+
+	bool CompressedReader::HasError()
+	{
+		return m_error;
+	}
+
+}
@@ -0,0 +1,150 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: CompressedWriter, CompressedReader
+*Description: Compression's chunked stream format written through a FileWriter and read back
+*through a FileReader, a chunk at a time, so recordings never have to sit in memory whole.
+*Author: jkeon
+**********************************/
+
+#ifndef _COMPRESSEDSTREAM_H_
+#define _COMPRESSEDSTREAM_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/util/Compression.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class ByteArray;
+	class FileReader;
+	class FileWriter;
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Starts a stream at the writer's current position. The stream isn't complete until Finish,
+	 * which the destructor calls, so finish before closing the file.
+	 */
+	class CompressedWriter {
+
+	//PUBLIC FUNCTIONS
+	public:
+		CompressedWriter(FileWriter &writer, u32 chunkSize = Compression::DEFAULT_CHUNK_SIZE);
+		~CompressedWriter();
+
+		bool Append(const u8 *bytes, u32 length);
+		bool Append(ByteArray &bytes);
+		//Writes the last partial chunk and the end of the stream, appends fail after this
+		bool Finish();
+
+		u64 GetBytesIn();
+		u64 GetBytesOut();
+
+	//PRIVATE FUNCTIONS
+	private:
+		CompressedWriter(const CompressedWriter &other);
+		CompressedWriter& operator = (const CompressedWriter &other);
+
+		bool WriteChunk();
+
+	//PRIVATE VARIABLES
+	private:
+		FileWriter *p_writer;
+		u32 m_chunkSize;
+		u8 *p_chunk;
+		u32 m_buffered;
+		u8 *p_encoded;
+
+		bool m_started;
+		bool m_finished;
+		bool m_failed;
+		u64 m_bytesIn;
+		u64 m_bytesOut;
+
+	};
+
+	/**
+	 * Reads a stream from the reader's current position, leaving the reader just past it.
+	 */
+	class CompressedReader {
+
+	//PUBLIC FUNCTIONS
+	public:
+		CompressedReader(FileReader &reader);
+		~CompressedReader();
+
+		//Returns how many bytes were read, fewer than length only at the end of the stream or on an error
+		u32 Read(u8 *bytes, u32 length);
+		bool IsEndOfStream();
+		//Bad header, bad chunk or the file ended before the stream did
+		bool HasError();
+
+	//PRIVATE FUNCTIONS
+	private:
+		CompressedReader(const CompressedReader &other);
+		CompressedReader& operator = (const CompressedReader &other);
+
+		bool Start();
+		bool NextChunk();
+
+	//PRIVATE VARIABLES
+	private:
+		FileReader *p_reader;
+		u32 m_chunkSize;
+		u8 *p_chunk;
+		u32 m_chunkLength;
+		u32 m_chunkPosition;
+		u8 *p_stored;
+
+		bool m_started;
+		bool m_ended;
+		bool m_error;
+
+	};
+}
+#endif
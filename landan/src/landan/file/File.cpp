@@ -37,6 +37,8 @@ or implied, of Karman Interactive Ltd.
 
 #include "File.h"
 #include <nowide/fstream.hpp>
+#include <nowide/cstdio.hpp>
+#include <landan/file/MappedFile.h>
 #include <landan/util/ByteArray.h>
 
 //////////////////////////////////////////////////////////////////////
@@ -49,7 +51,7 @@ namespace landan {
 	// CONSTRUCTORS //////////////////////////////////////////////////////
 	//////////////////////////////////////////////////////////////////////
 
-	File::File(string path) : m_path(path) {
+	File::File(string path) : m_path(path), p_stream(0) {
 
 	}
 
@@ -58,7 +60,7 @@ namespace landan {
 	//////////////////////////////////////////////////////////////////////
 
 	File::~File() {
-
+		Close();
 	}
 
 	//////////////////////////////////////////////////////////////////////
@@ -68,7 +70,21 @@ namespace landan {
 	bool File::Exists()
 	{
 		nowide::fstream fileStream(m_path.c_str());
-		return (fileStream != 0);
+		return !fileStream.fail();
+	}
+
+	u64 File::GetSize()
+	{
+		if (p_stream != 0)
+		{
+			p_stream->flush();
+		}
+		nowide::ifstream fileStream(m_path.c_str(), nowide::ifstream::binary | nowide::ifstream::ate);
+		if (!fileStream)
+		{
+			return 0;
+		}
+		return static_cast<u64>(fileStream.tellg());
 	}
 
 	void File::WriteBytes(ByteArray &bytes)
@@ -81,4 +97,107 @@ namespace landan {
 		}
 	}
 
+	bool File::ReadBytes(ByteArray &bytes)
+	{
+		nowide::ifstream fileStream(m_path.c_str(), nowide::ifstream::binary | nowide::ifstream::in);
+		if (!fileStream)
+		{
+			return false;
+		}
+		fileStream.read(reinterpret_cast<char*>(bytes.GetRawBytes()), bytes.GetLength());
+		return static_cast<u32>(fileStream.gcount()) == bytes.GetLength();
+	}
+
+	ByteArray File::ReadAll()
+	{
+		ByteArray bytes(static_cast<u32>(GetSize()));
+		if (!ReadBytes(bytes))
+		{
+			return ByteArray();
+		}
+		return bytes;
+	}
+
+	bool File::Map(MappedFile &mapping, u64 offset, u64 length)
+	{
+		return mapping.Open(m_path, offset, length);
+	}
+
+	bool File::Open(file::OPEN_MODE mode)
+	{
+		Close();
+		std::ios_base::openmode openMode = nowide::ofstream::binary | nowide::ofstream::out;
+		openMode |= (mode == file::APPEND) ? nowide::ofstream::app : nowide::ofstream::trunc;
+
+		nowide::ofstream *stream = new nowide::ofstream(m_path.c_str(), openMode);
+		if (!(*stream))
+		{
+			delete stream;
+			return false;
+		}
+		p_stream = stream;
+		return true;
+	}
+
+	bool File::IsOpen()
+	{
+		return p_stream != 0;
+	}
+
+	bool File::Write(const u8 *bytes, u32 length)
+	{
+		if (p_stream == 0)
+		{
+			return false;
+		}
+		p_stream->write(reinterpret_cast<const char*>(bytes), length);
+		return !p_stream->fail();
+	}
+
+	void File::Flush()
+	{
+		if (p_stream != 0)
+		{
+			p_stream->flush();
+		}
+	}
+
+	bool File::Close()
+	{
+		if (p_stream == 0)
+		{
+			return false;
+		}
+		p_stream->flush();
+		delete p_stream;
+		p_stream = 0;
+		return true;
+	}
+
+	bool File::Remove()
+	{
+		Close();
+		return nowide::remove(m_path.c_str()) == 0;
+	}
+
+	bool File::Rename(const string &path)
+	{
+		Close();
+		if (nowide::rename(m_path.c_str(), path.c_str()) != 0)
+		{
+			return false;
+		}
+		m_path = path;
+		return true;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	const string& File::GetPath()
+	{
+		return m_path;
+	}
+
 }
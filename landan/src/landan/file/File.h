@@ -45,6 +45,7 @@ or implied, of Karman Interactive Ltd.
 //////////////////////////////////////////////////////////////////////
 
 #include <landan/core/LandanTypes.h>
+#include <iosfwd>
 
 //////////////////////////////////////////////////////////////////////
 // NAMESPACE /////////////////////////////////////////////////////////
@@ -57,6 +58,20 @@ namespace landan {
 	//////////////////////////////////////////////////////////////////////
 
 	class ByteArray;
+	class MappedFile;
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace file
+	{
+		enum OPEN_MODE
+		{
+			WRITE = 0,
+			APPEND = 1
+		};
+	}
 
 	//////////////////////////////////////////////////////////////////////
 	// CLASS DECLARATION /////////////////////////////////////////////////
@@ -70,9 +85,27 @@ namespace landan {
 		~File();
 
 		bool Exists();
+		u64 GetSize();
+		const string& GetPath();
+
 		void WriteBytes(ByteArray &bytes);
+		//Reads from the start of the file until bytes is full
+		bool ReadBytes(ByteArray &bytes);
+		//The whole file in a ByteArray sized to fit, empty if it couldn't be read
+		ByteArray ReadAll();
+		//Maps the file, or part of it, read only without copying it into memory
+		bool Map(MappedFile &mapping, u64 offset = 0, u64 length = ~0ull);
+
+		//Streaming writes, the file stays open until Close or destruction
+		bool Open(file::OPEN_MODE mode);
+		bool IsOpen();
+		bool Write(const u8 *bytes, u32 length);
+		void Flush();
 		bool Close();
 
+		bool Remove();
+		bool Rename(const string &path);
+
 	//PRIVATE FUNCTIONS
 	private:
 		File(const File &other);
@@ -81,6 +114,7 @@ namespace landan {
 	//PRIVATE VARIABLES
 	private:
 		string m_path;
+		std::ostream *p_stream;
 
 	
 	};
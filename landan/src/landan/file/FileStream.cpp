@@ -0,0 +1,521 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "FileStream.h"
+#include <cstring>
+#include <landan/util/ByteArray.h>
+
+#ifdef _WIN32
+	#include <Windows.h>
+	#include <nowide/convert.hpp>
+#else
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	//Page aligned so the buffers also suit unbuffered and asynchronous I/O
+	static const u32 BUFFER_ALIGNMENT = 4096;
+
+	static u8* AllocateBuffer(u32 &size, u8 *&allocation)
+	{
+		size = (size < BUFFER_ALIGNMENT) ? BUFFER_ALIGNMENT : size;
+		size = (size + BUFFER_ALIGNMENT - 1) & ~(BUFFER_ALIGNMENT - 1);
+		allocation = new u8[size + BUFFER_ALIGNMENT - 1];
+		size_t address = reinterpret_cast<size_t>(allocation);
+		return allocation + ((BUFFER_ALIGNMENT - (address % BUFFER_ALIGNMENT)) % BUFFER_ALIGNMENT);
+	}
+
+#ifdef _WIN32
+	static const file::NATIVE_HANDLE INVALID_NATIVE_HANDLE = INVALID_HANDLE_VALUE;
+
+	static file::NATIVE_HANDLE OpenNative(const string &path, bool write, bool truncate)
+	{
+		DWORD access = write ? GENERIC_WRITE : GENERIC_READ;
+		DWORD disposition = write ? (truncate ? CREATE_ALWAYS : OPEN_ALWAYS) : OPEN_EXISTING;
+		DWORD flags = write ? FILE_ATTRIBUTE_NORMAL : FILE_FLAG_SEQUENTIAL_SCAN;
+		return CreateFileW(nowide::widen(path).c_str(), access, FILE_SHARE_READ, 0, disposition, flags, 0);
+	}
+
+	static void CloseNative(file::NATIVE_HANDLE handle)
+	{
+		CloseHandle(handle);
+	}
+
+	//Returns how many bytes were written, short only when the write failed
+	static u32 WriteNative(file::NATIVE_HANDLE handle, const u8 *bytes, u32 length)
+	{
+		u32 total = 0;
+		while (total < length)
+		{
+			DWORD written = 0;
+			if (!WriteFile(handle, bytes + total, length - total, &written, 0) || written == 0)
+			{
+				break;
+			}
+			total += written;
+		}
+		return total;
+	}
+
+	//Returns how many bytes were read, stops early only at the end of the file
+	static u32 ReadNative(file::NATIVE_HANDLE handle, u8 *bytes, u32 length)
+	{
+		u32 total = 0;
+		while (total < length)
+		{
+			DWORD read = 0;
+			if (!ReadFile(handle, bytes + total, length - total, &read, 0) || read == 0)
+			{
+				break;
+			}
+			total += read;
+		}
+		return total;
+	}
+
+	static bool SeekNative(file::NATIVE_HANDLE handle, u64 position, bool fromEnd, u64 &result)
+	{
+		LARGE_INTEGER distance;
+		LARGE_INTEGER moved;
+		distance.QuadPart = fromEnd ? 0 : static_cast<LONGLONG>(position);
+		if (!SetFilePointerEx(handle, distance, &moved, fromEnd ? FILE_END : FILE_BEGIN))
+		{
+			return false;
+		}
+		result = static_cast<u64>(moved.QuadPart);
+		return true;
+	}
+#else
+	static const file::NATIVE_HANDLE INVALID_NATIVE_HANDLE = -1;
+
+	static file::NATIVE_HANDLE OpenNative(const string &path, bool write, bool truncate)
+	{
+		int flags = O_CLOEXEC;
+		flags |= write ? (O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0)) : O_RDONLY;
+		return open(path.c_str(), flags, 0644);
+	}
+
+	static void CloseNative(file::NATIVE_HANDLE handle)
+	{
+		close(handle);
+	}
+
+	//Returns how many bytes were written, short only when the write failed
+	static u32 WriteNative(file::NATIVE_HANDLE handle, const u8 *bytes, u32 length)
+	{
+		u32 total = 0;
+		while (total < length)
+		{
+			ssize_t written = write(handle, bytes + total, length - total);
+			if (written < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (written <= 0)
+			{
+				break;
+			}
+			total += static_cast<u32>(written);
+		}
+		return total;
+	}
+
+	static u32 ReadNative(file::NATIVE_HANDLE handle, u8 *bytes, u32 length)
+	{
+		u32 total = 0;
+		while (total < length)
+		{
+			ssize_t read = ::read(handle, bytes + total, length - total);
+			if (read < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (read <= 0)
+			{
+				break;
+			}
+			total += static_cast<u32>(read);
+		}
+		return total;
+	}
+
+	static bool SeekNative(file::NATIVE_HANDLE handle, u64 position, bool fromEnd, u64 &result)
+	{
+		off_t moved = lseek(handle, fromEnd ? 0 : static_cast<off_t>(position), fromEnd ? SEEK_END : SEEK_SET);
+		if (moved < 0)
+		{
+			return false;
+		}
+		result = static_cast<u64>(moved);
+		return true;
+	}
+#endif
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	FileWriter::FileWriter(u32 bufferSize)
+	:m_handle(INVALID_NATIVE_HANDLE), m_open(false), m_failed(false), m_bufferSize(bufferSize), m_buffered(0), m_fileOffset(0)
+	{
+		p_buffer = AllocateBuffer(m_bufferSize, p_allocation);
+	}
+
+	FileReader::FileReader(u32 bufferSize)
+	:m_handle(INVALID_NATIVE_HANDLE), m_open(false), m_size(0), m_bufferSize(bufferSize), m_bufferLength(0), m_bufferPosition(0), m_bufferStart(0)
+	{
+		p_buffer = AllocateBuffer(m_bufferSize, p_allocation);
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	FileWriter::~FileWriter()
+	{
+		Close();
+		delete[] p_allocation;
+	}
+
+	FileReader::~FileReader()
+	{
+		Close();
+		delete[] p_allocation;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool FileWriter::Open(const string &path, file::OPEN_MODE mode)
+	{
+		Close();
+		m_handle = OpenNative(path, true, mode == file::WRITE);
+		if (m_handle == INVALID_NATIVE_HANDLE)
+		{
+			return false;
+		}
+		if (!SeekNative(m_handle, 0, mode == file::APPEND, m_fileOffset))
+		{
+			CloseNative(m_handle);
+			m_handle = INVALID_NATIVE_HANDLE;
+			return false;
+		}
+		m_open = true;
+		m_failed = false;
+		m_buffered = 0;
+		return true;
+	}
+
+	bool FileWriter::Open(File &file, file::OPEN_MODE mode)
+	{
+		return Open(file.GetPath(), mode);
+	}
+
+	bool FileWriter::Close()
+	{
+		if (!m_open)
+		{
+			return false;
+		}
+		Flush();
+		CloseNative(m_handle);
+		m_handle = INVALID_NATIVE_HANDLE;
+		m_open = false;
+		return !m_failed;
+	}
+
+	bool FileWriter::Append(const u8 *bytes, u32 length)
+	{
+		if (!m_open)
+		{
+			return false;
+		}
+
+		//Top up what's buffered first so writes land in order
+		if (m_buffered > 0 || length < m_bufferSize)
+		{
+			u32 room = m_bufferSize - m_buffered;
+			u32 copy = (length < room) ? length : room;
+			memcpy(p_buffer + m_buffered, bytes, copy);
+			m_buffered += copy;
+			bytes += copy;
+			length -= copy;
+			if (m_buffered == m_bufferSize && !Flush())
+			{
+				return false;
+			}
+		}
+
+		if (length >= m_bufferSize)
+		{
+			u32 written = WriteNative(m_handle, bytes, length);
+			m_fileOffset += written;
+			if (written != length)
+			{
+				m_failed = true;
+				return false;
+			}
+		}
+		else if (length > 0)
+		{
+			memcpy(p_buffer, bytes, length);
+			m_buffered = length;
+		}
+		return true;
+	}
+
+	bool FileWriter::Append(ByteArray &bytes)
+	{
+		return Append(bytes.GetRawBytes(), bytes.GetLength());
+	}
+
+	bool FileWriter::Flush()
+	{
+		if (!m_open || m_buffered == 0)
+		{
+			return m_open;
+		}
+		//A short write still moved the file position by what made it out
+		u32 written = WriteNative(m_handle, p_buffer, m_buffered);
+		m_fileOffset += written;
+		bool complete = (written == m_buffered);
+		m_buffered = 0;
+		m_failed = m_failed || !complete;
+		return complete;
+	}
+
+	bool FileWriter::Seek(u64 position)
+	{
+		if (!m_open || !Flush())
+		{
+			return false;
+		}
+		return SeekNative(m_handle, position, false, m_fileOffset);
+	}
+
+	u64 FileWriter::Tell()
+	{
+		return m_fileOffset + m_buffered;
+	}
+
+	bool FileReader::Open(const string &path)
+	{
+		Close();
+		m_handle = OpenNative(path, false, false);
+		if (m_handle == INVALID_NATIVE_HANDLE)
+		{
+			return false;
+		}
+		u64 start;
+		if (!SeekNative(m_handle, 0, true, m_size) || !SeekNative(m_handle, 0, false, start))
+		{
+			CloseNative(m_handle);
+			m_handle = INVALID_NATIVE_HANDLE;
+			return false;
+		}
+		m_open = true;
+		m_bufferStart = 0;
+		m_bufferLength = 0;
+		m_bufferPosition = 0;
+		return true;
+	}
+
+	bool FileReader::Open(File &file)
+	{
+		return Open(file.GetPath());
+	}
+
+	void FileReader::Close()
+	{
+		if (m_open)
+		{
+			CloseNative(m_handle);
+			m_handle = INVALID_NATIVE_HANDLE;
+			m_open = false;
+		}
+		m_size = 0;
+	}
+
+	u32 FileReader::Read(u8 *bytes, u32 length)
+	{
+		if (!m_open)
+		{
+			return 0;
+		}
+
+		u32 total = 0;
+		while (total < length)
+		{
+			u32 buffered = m_bufferLength - m_bufferPosition;
+			if (buffered > 0)
+			{
+				u32 copy = (length - total < buffered) ? length - total : buffered;
+				memcpy(bytes + total, p_buffer + m_bufferPosition, copy);
+				m_bufferPosition += copy;
+				total += copy;
+			}
+			else if (length - total >= m_bufferSize)
+			{
+				//Big reads skip the buffer, it's left empty just past what was read
+				u32 read = ReadNative(m_handle, bytes + total, length - total);
+				m_bufferStart += m_bufferLength + read;
+				m_bufferLength = 0;
+				m_bufferPosition = 0;
+				total += read;
+				break;
+			}
+			else if (!Refill())
+			{
+				break;
+			}
+		}
+		return total;
+	}
+
+	u32 FileReader::Read(ByteArray &bytes, u32 length)
+	{
+		u32 position = bytes.GetPosition();
+		u32 length32 = bytes.GetLength();
+		if (bytes.GetMode() == bytearray::GROWABLE)
+		{
+			u64 remaining = (m_size > Tell()) ? m_size - Tell() : 0;
+			length = (length < remaining) ? length : static_cast<u32>(remaining);
+			if (position + length > length32)
+			{
+				bytes.Resize(position + length);
+			}
+		}
+		else
+		{
+			u32 room = (position < length32) ? length32 - position : 0;
+			length = (length < room) ? length : room;
+		}
+		if (length == 0)
+		{
+			return 0;
+		}
+
+		u32 read = Read(bytes.GetRawBytes() + position, length);
+		if (read < length && bytes.GetMode() == bytearray::GROWABLE && position + length > length32)
+		{
+			u32 end = position + read;
+			bytes.Resize((end > length32) ? end : length32);
+		}
+		bytes.SetPosition(position + read);
+		return read;
+	}
+
+	bool FileReader::Refill()
+	{
+		m_bufferStart += m_bufferLength;
+		m_bufferPosition = 0;
+		m_bufferLength = ReadNative(m_handle, p_buffer, m_bufferSize);
+		return m_bufferLength > 0;
+	}
+
+	bool FileReader::Seek(u64 position)
+	{
+		if (!m_open)
+		{
+			return false;
+		}
+		if (position >= m_bufferStart && position <= m_bufferStart + m_bufferLength)
+		{
+			m_bufferPosition = static_cast<u32>(position - m_bufferStart);
+			return true;
+		}
+		if (!SeekNative(m_handle, position, false, m_bufferStart))
+		{
+			return false;
+		}
+		m_bufferLength = 0;
+		m_bufferPosition = 0;
+		return true;
+	}
+
+	u64 FileReader::Tell()
+	{
+		return m_bufferStart + m_bufferPosition;
+	}
+
+	bool FileReader::IsEndOfFile()
+	{
+		return Tell() >= m_size;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool FileWriter::IsOpen()
+	{
+		return m_open;
+	}
+
+	u32 FileWriter::GetBufferSize()
+	{
+		return m_bufferSize;
+	}
+
+	bool FileReader::IsOpen()
+	{
+		return m_open;
+	}
+
+	u64 FileReader::GetSize()
+	{
+		return m_size;
+	}
+
+	u32 FileReader::GetBufferSize()
+	{
+		return m_bufferSize;
+	}
+
+}
@@ -0,0 +1,190 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: FileWriter, FileReader
+*Description: Buffered streaming access to a file that stays open. Goes straight to the OS
+*handle with one large page aligned buffer, so small writes and reads don't each become a
+*system call the way they do through a nowide stream.
+*Author: jkeon
+**********************************/
+
+#ifndef _FILESTREAM_H_
+#define _FILESTREAM_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/file/File.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class ByteArray;
+
+	namespace file
+	{
+		//A HANDLE on Windows, a descriptor everywhere else
+#ifdef _WIN32
+		typedef void* NATIVE_HANDLE;
+#else
+		typedef int NATIVE_HANDLE;
+#endif
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Appends go to the buffer and reach the file when it fills, on Flush, Seek or Close.
+	 * Writes at least as big as the buffer skip it.
+	 */
+	class FileWriter {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//The buffer is allocated once here and rounded up to a whole number of pages
+		FileWriter(u32 bufferSize = DEFAULT_BUFFER_SIZE);
+		~FileWriter();
+
+		//WRITE truncates, APPEND starts at the end. Seek works in both.
+		bool Open(const string &path, file::OPEN_MODE mode);
+		bool Open(File &file, file::OPEN_MODE mode);
+		bool IsOpen();
+		//Flushes and closes, false if anything since the last check failed to write
+		bool Close();
+
+		bool Append(const u8 *bytes, u32 length);
+		//Everything in the array from 0 to its length, the position is ignored
+		bool Append(ByteArray &bytes);
+		//Hands the buffer to the OS, it's not forced to disk
+		bool Flush();
+
+		//Flushes first
+		bool Seek(u64 position);
+		u64 Tell();
+
+		u32 GetBufferSize();
+
+	//PRIVATE FUNCTIONS
+	private:
+		FileWriter(const FileWriter &other);
+		FileWriter& operator = (const FileWriter &other);
+
+	//PUBLIC VARIABLES
+	public:
+		static const u32 DEFAULT_BUFFER_SIZE = 1 << 20;
+
+	//PRIVATE VARIABLES
+	private:
+		file::NATIVE_HANDLE m_handle;
+		bool m_open;
+		bool m_failed;
+
+		u8 *p_allocation;
+		u8 *p_buffer;
+		u32 m_bufferSize;
+		u32 m_buffered;
+		//Where the first buffered byte goes
+		u64 m_fileOffset;
+
+	};
+
+	/**
+	 * Reads through the buffer, refilling it a whole buffer at a time. Reads at least as big as
+	 * the buffer go straight into the destination.
+	 */
+	class FileReader {
+
+	//PUBLIC FUNCTIONS
+	public:
+		FileReader(u32 bufferSize = DEFAULT_BUFFER_SIZE);
+		~FileReader();
+
+		bool Open(const string &path);
+		bool Open(File &file);
+		bool IsOpen();
+		void Close();
+
+		//Returns how many bytes were read, fewer than length only at the end of the file or on an error
+		u32 Read(u8 *bytes, u32 length);
+		//Reads into the array at its position and moves the position past what was read. A growable
+		//array is resized to fit, a fixed one takes what fits.
+		u32 Read(ByteArray &bytes, u32 length);
+
+		//Seeking inside what's buffered doesn't touch the file
+		bool Seek(u64 position);
+		u64 Tell();
+		u64 GetSize();
+		bool IsEndOfFile();
+
+		u32 GetBufferSize();
+
+	//PRIVATE FUNCTIONS
+	private:
+		FileReader(const FileReader &other);
+		FileReader& operator = (const FileReader &other);
+
+		bool Refill();
+
+	//PUBLIC VARIABLES
+	public:
+		static const u32 DEFAULT_BUFFER_SIZE = 1 << 20;
+
+	//PRIVATE VARIABLES
+	private:
+		file::NATIVE_HANDLE m_handle;
+		bool m_open;
+		u64 m_size;
+
+		u8 *p_allocation;
+		u8 *p_buffer;
+		u32 m_bufferSize;
+		u32 m_bufferLength;
+		u32 m_bufferPosition;
+		//File offset of the first byte in the buffer, the OS position is always just past the buffer
+		u64 m_bufferStart;
+
+	};
+}
+#endif
@@ -0,0 +1,344 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "MappedFile.h"
+#include <landan/util/ByteArray.h>
+#include <nowide/fstream.hpp>
+
+#ifdef _WIN32
+	#include <Windows.h>
+	#include <nowide/convert.hpp>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	MappedFile::MappedFile()
+	:p_base(0), m_baseLength(0), p_data(0), m_size(0), m_open(false), m_mapped(false)
+	{
+
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool MappedFile::Open(const string &path, u64 offset, u64 length)
+	{
+		Close();
+		m_open = Map(path, offset, length) || ReadIntoMemory(path, offset, length);
+		return m_open;
+	}
+
+	void MappedFile::Close()
+	{
+		if (p_base != 0)
+		{
+			if (m_mapped)
+			{
+#ifdef _WIN32
+				UnmapViewOfFile(p_base);
+#else
+				munmap(p_base, m_baseLength);
+#endif
+			}
+			else
+			{
+				delete[] p_base;
+			}
+		}
+		p_base = 0;
+		m_baseLength = 0;
+		p_data = 0;
+		m_size = 0;
+		m_open = false;
+		m_mapped = false;
+	}
+
+#ifdef _WIN32
+	bool MappedFile::Map(const string &path, u64 offset, u64 length)
+	{
+		HANDLE file = CreateFileW(nowide::widen(path).c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || offset > static_cast<u64>(fileSize.QuadPart))
+		{
+			CloseHandle(file);
+			return false;
+		}
+		u64 available = static_cast<u64>(fileSize.QuadPart) - offset;
+		length = (length < available) ? length : available;
+
+		//Views have to start on an allocation granularity boundary, not just a page
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		u64 base = offset - (offset % info.dwAllocationGranularity);
+		u64 baseLength = length + (offset - base);
+		if (length == 0 || baseLength > static_cast<u64>(static_cast<size_t>(-1)))
+		{
+			CloseHandle(file);
+			if (length == 0)
+			{
+				//Nothing to map, but it opened fine. There's no mapping behind it so IsMapped stays false.
+				return true;
+			}
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, 0, PAGE_READONLY, 0, 0, 0);
+		CloseHandle(file);
+		if (mapping == 0)
+		{
+			return false;
+		}
+		void *view = MapViewOfFile(mapping, FILE_MAP_READ, static_cast<DWORD>(base >> 32), static_cast<DWORD>(base), static_cast<SIZE_T>(baseLength));
+		//The view keeps the mapping alive on its own
+		CloseHandle(mapping);
+		if (view == 0)
+		{
+			return false;
+		}
+
+		p_base = static_cast<u8*>(view);
+		m_baseLength = static_cast<size_t>(baseLength);
+		p_data = p_base + (offset - base);
+		m_size = length;
+		m_mapped = true;
+		return true;
+	}
+
+	bool MappedFile::Advise(file::ACCESS_HINT hint, u64 offset, u64 length)
+	{
+		//PrefetchVirtualMemory and friends need Windows 8, the cache manager does its own read ahead
+		return false;
+	}
+
+	u32 MappedFile::GetPageSize()
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return static_cast<u32>(info.dwPageSize);
+	}
+#else
+	bool MappedFile::Map(const string &path, u64 offset, u64 length)
+	{
+		int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file < 0)
+		{
+			return false;
+		}
+
+		struct stat status;
+		if (fstat(file, &status) != 0 || offset > static_cast<u64>(status.st_size))
+		{
+			close(file);
+			return false;
+		}
+		u64 available = static_cast<u64>(status.st_size) - offset;
+		length = (length < available) ? length : available;
+
+		u64 base = offset - (offset % GetPageSize());
+		u64 baseLength = length + (offset - base);
+		if (length == 0)
+		{
+			//Nothing to map, but it opened fine. There's no mapping behind it so IsMapped stays false.
+			close(file);
+			return true;
+		}
+		if (baseLength > static_cast<u64>(static_cast<size_t>(-1)))
+		{
+			close(file);
+			return false;
+		}
+
+		void *view = mmap(0, static_cast<size_t>(baseLength), PROT_READ, MAP_PRIVATE, file, static_cast<off_t>(base));
+		//The mapping holds its own reference to the file
+		close(file);
+		if (view == MAP_FAILED)
+		{
+			return false;
+		}
+
+		p_base = static_cast<u8*>(view);
+		m_baseLength = static_cast<size_t>(baseLength);
+		p_data = p_base + (offset - base);
+		m_size = length;
+		m_mapped = true;
+		return true;
+	}
+
+	bool MappedFile::Advise(file::ACCESS_HINT hint, u64 offset, u64 length)
+	{
+		if (!m_mapped || p_base == 0 || offset >= m_size)
+		{
+			return false;
+		}
+		length = (length < m_size - offset) ? length : m_size - offset;
+
+		//madvise wants a page aligned start, widen the range down to one
+		u8 *start = const_cast<u8*>(p_data) + offset;
+		size_t misalignment = static_cast<size_t>(start - p_base) % GetPageSize();
+		start -= misalignment;
+
+		int advice = MADV_NORMAL;
+		switch (hint)
+		{
+			case file::SEQUENTIAL:
+				advice = MADV_SEQUENTIAL;
+				break;
+			case file::RANDOM:
+				advice = MADV_RANDOM;
+				break;
+			case file::WILL_NEED:
+				advice = MADV_WILLNEED;
+				break;
+			case file::DONT_NEED:
+				advice = MADV_DONTNEED;
+				break;
+			default:
+				break;
+		}
+		return madvise(start, static_cast<size_t>(length) + misalignment, advice) == 0;
+	}
+
+	u32 MappedFile::GetPageSize()
+	{
+		static u32 CACHED_PAGE_SIZE = static_cast<u32>(sysconf(_SC_PAGESIZE));
+		return CACHED_PAGE_SIZE;
+	}
+#endif
+
+	bool MappedFile::ReadIntoMemory(const string &path, u64 offset, u64 length)
+	{
+		nowide::ifstream stream(path.c_str(), nowide::ifstream::binary | nowide::ifstream::ate);
+		if (stream.fail())
+		{
+			return false;
+		}
+		u64 fileSize = static_cast<u64>(stream.tellg());
+		if (offset > fileSize)
+		{
+			return false;
+		}
+		length = (length < fileSize - offset) ? length : fileSize - offset;
+		if (length > static_cast<u64>(static_cast<size_t>(-1)))
+		{
+			return false;
+		}
+
+		u8 *data = (length > 0) ? new u8[static_cast<size_t>(length)] : 0;
+		stream.seekg(static_cast<std::streamoff>(offset));
+		stream.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(length));
+		if (static_cast<u64>(stream.gcount()) != length)
+		{
+			delete[] data;
+			return false;
+		}
+
+		p_base = data;
+		m_baseLength = static_cast<size_t>(length);
+		p_data = data;
+		m_size = length;
+		m_mapped = false;
+		return true;
+	}
+
+	bool MappedFile::Advise(file::ACCESS_HINT hint)
+	{
+		return Advise(hint, 0, m_size);
+	}
+
+	ByteArray MappedFile::GetView(u64 offset, u32 length)
+	{
+		if (offset >= m_size)
+		{
+			return ByteArray();
+		}
+		u64 available = m_size - offset;
+		length = (length < available) ? length : static_cast<u32>(available);
+		return ByteArray(const_cast<u8*>(p_data) + offset, length, bytearray::VIEW);
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool MappedFile::IsOpen()
+	{
+		return m_open;
+	}
+
+	bool MappedFile::IsMapped()
+	{
+		return m_open && m_mapped;
+	}
+
+	const u8* MappedFile::GetData()
+	{
+		return p_data;
+	}
+
+	u64 MappedFile::GetSize()
+	{
+		return m_size;
+	}
+
+}
@@ -0,0 +1,139 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: MappedFile
+*Description: Read only memory mapping of a file, or part of one. Pages are only read from disk
+*when touched, so opening a large pack costs next to nothing. Falls back to reading into memory
+*where the file can't be mapped.
+*Author: jkeon
+**********************************/
+
+#ifndef _MAPPEDFILE_H_
+#define _MAPPEDFILE_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <cstddef>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class ByteArray;
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace file
+	{
+		//How a range is about to be used, passed on to madvise
+		enum ACCESS_HINT
+		{
+			NORMAL = 0,
+			//Read front to back, the kernel reads ahead aggressively and drops pages behind
+			SEQUENTIAL = 1,
+			//No read ahead
+			RANDOM = 2,
+			//Start reading it in now
+			WILL_NEED = 3,
+			//Done with it for now, the pages can be dropped
+			DONT_NEED = 4
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class MappedFile {
+
+	//PUBLIC FUNCTIONS
+	public:
+		MappedFile();
+		~MappedFile();
+
+		//Maps length bytes from offset, clamped to the end of the file. The offset doesn't need
+		//to be page aligned. Closes whatever was open before. If the system refuses the mapping the
+		//range is read into memory instead, a range too big for the address space fails either way.
+		bool Open(const string &path, u64 offset = 0, u64 length = ~0ull);
+		void Close();
+		bool IsOpen();
+		//False for an empty range, or if Open had to fall back to reading the file into memory
+		bool IsMapped();
+
+		//Read only, writing through it crashes when the file is mapped
+		const u8* GetData();
+		u64 GetSize();
+
+		//Returns false where the hint isn't supported, it's only ever advice
+		bool Advise(file::ACCESS_HINT hint);
+		bool Advise(file::ACCESS_HINT hint, u64 offset, u64 length);
+
+		//A non owning ByteArray over part of the mapping, ByteArrays top out at 4GB so bigger files
+		//need several. Only valid while the mapping is open, and must only be read from.
+		ByteArray GetView(u64 offset = 0, u32 length = 0xFFFFFFFF);
+
+		static u32 GetPageSize();
+
+	//PRIVATE FUNCTIONS
+	private:
+		MappedFile(const MappedFile &other);
+		MappedFile& operator = (const MappedFile &other);
+
+		bool Map(const string &path, u64 offset, u64 length);
+		bool ReadIntoMemory(const string &path, u64 offset, u64 length);
+
+	//PRIVATE VARIABLES
+	private:
+		//What was actually mapped, starts on a page boundary at or before the requested offset
+		u8 *p_base;
+		size_t m_baseLength;
+		const u8 *p_data;
+		u64 m_size;
+		bool m_open;
+		bool m_mapped;
+
+	};
+}
+#endif
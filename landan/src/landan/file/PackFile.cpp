@@ -0,0 +1,550 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "PackFile.h"
+#include <algorithm>
+#include <cstring>
+#include <landan/file/FileStream.h>
+#include <landan/util/ByteArray.h>
+#include <landan/util/ByteStream.h>
+
+#ifdef _WIN32
+	#include <Windows.h>
+	#include <nowide/convert.hpp>
+#else
+	#include <dirent.h>
+	#include <sys/stat.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	typedef endian::ByteOrder<endian::SYSTEM_ENDIAN != endian::LITTLE_ENDIAN> LittleEndianOrder;
+
+	//Slots are read straight out of the mapping so lookups don't need a reader each
+	static u16 LoadUInt16(const u8 *bytes)
+	{
+		u16 value;
+		memcpy(&value, bytes, sizeof(value));
+		return LittleEndianOrder::Convert(value);
+	}
+
+	static u32 LoadUInt32(const u8 *bytes)
+	{
+		u32 value;
+		memcpy(&value, bytes, sizeof(value));
+		return LittleEndianOrder::Convert(value);
+	}
+
+	static u64 LoadUInt64(const u8 *bytes)
+	{
+		u64 value;
+		memcpy(&value, bytes, sizeof(value));
+		return LittleEndianOrder::Convert(value);
+	}
+
+	//Where the path starts once "./" and "/" prefixes are skipped
+	static u32 SkipPathPrefix(const char *path, u32 length)
+	{
+		u32 start = 0;
+		for (;;)
+		{
+			if (start + 1 < length && path[start] == '.' && (path[start + 1] == '/' || path[start + 1] == '\\'))
+			{
+				start += 2;
+			}
+			else if (start < length && (path[start] == '/' || path[start] == '\\'))
+			{
+				start++;
+			}
+			else
+			{
+				return start;
+			}
+		}
+	}
+
+	static u64 AlignBlob(u64 offset)
+	{
+		return (offset + pack::BLOB_ALIGNMENT - 1) & ~static_cast<u64>(pack::BLOB_ALIGNMENT - 1);
+	}
+
+	//Slot layout: hash u64, offset u64, size u32, original size u32, path offset u32, path length u16,
+	//compression u8, one spare byte. A path length of 0 marks an empty slot.
+	static const u32 SLOT_HASH = 0;
+	static const u32 SLOT_OFFSET = 8;
+	static const u32 SLOT_SIZE = 16;
+	static const u32 SLOT_ORIGINAL_SIZE = 20;
+	static const u32 SLOT_PATH_OFFSET = 24;
+	static const u32 SLOT_PATH_LENGTH = 28;
+	static const u32 SLOT_COMPRESSION = 30;
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	PackFile::PackFile()
+	:m_entryCount(0), m_slotMask(0), p_slots(0), p_strings(0), m_stringsSize(0)
+	{
+
+	}
+
+	PackWriter::PackWriter()
+	{
+
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	PackFile::~PackFile()
+	{
+		Close();
+	}
+
+	PackWriter::~PackWriter()
+	{
+
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool PackFile::Open(const string &path)
+	{
+		Close();
+		if (!m_mapping.Open(path) || m_mapping.GetSize() < pack::HEADER_SIZE)
+		{
+			Close();
+			return false;
+		}
+
+		ByteArray header = m_mapping.GetView(0, pack::HEADER_SIZE);
+		LittleEndianReader reader(header);
+		u32 magic = reader.ReadUInt32();
+		u16 version = reader.ReadUInt16();
+		reader.ReadUInt16();
+		u32 entryCount = reader.ReadUInt32();
+		u32 slotCount = reader.ReadUInt32();
+		u64 stringsOffset = reader.ReadUInt64();
+		u32 stringsSize = reader.ReadUInt32();
+
+		//The slot count has to be a power of two with room to spare or probing might never end
+		u64 slotsEnd = pack::HEADER_SIZE + static_cast<u64>(slotCount) * pack::ENTRY_SIZE;
+		bool valid = (magic == pack::MAGIC) && (version == pack::VERSION) && (slotCount > entryCount) && ((slotCount & (slotCount - 1)) == 0)
+			&& (stringsOffset >= slotsEnd) && (stringsOffset <= m_mapping.GetSize()) && (stringsSize <= m_mapping.GetSize() - stringsOffset);
+		if (!valid)
+		{
+			Close();
+			return false;
+		}
+
+		m_entryCount = entryCount;
+		m_slotMask = slotCount - 1;
+		p_slots = m_mapping.GetData() + pack::HEADER_SIZE;
+		p_strings = m_mapping.GetData() + stringsOffset;
+		m_stringsSize = stringsSize;
+		//Lookups land all over the table
+		m_mapping.Advise(file::RANDOM);
+		return true;
+	}
+
+	void PackFile::Close()
+	{
+		m_mapping.Close();
+		m_entryCount = 0;
+		m_slotMask = 0;
+		p_slots = 0;
+		p_strings = 0;
+		m_stringsSize = 0;
+	}
+
+	const u8* PackFile::FindSlot(const string &path)
+	{
+		if (p_slots == 0)
+		{
+			return 0;
+		}
+
+		u32 start = SkipPathPrefix(path.c_str(), static_cast<u32>(path.length()));
+		const char *name = path.c_str() + start;
+		u32 length = static_cast<u32>(path.length()) - start;
+		u64 hash = HashPath(name, length);
+
+		//Bounded so a corrupt pack with every slot taken can't probe forever
+		u32 index = static_cast<u32>(hash) & m_slotMask;
+		for (u32 probe = 0; probe <= m_slotMask; probe++, index = (index + 1) & m_slotMask)
+		{
+			const u8 *slot = p_slots + static_cast<size_t>(index) * pack::ENTRY_SIZE;
+			u32 pathLength = LoadUInt16(slot + SLOT_PATH_LENGTH);
+			if (pathLength == 0)
+			{
+				return 0;
+			}
+			if (LoadUInt64(slot + SLOT_HASH) != hash || pathLength != length)
+			{
+				continue;
+			}
+
+			u32 pathOffset = LoadUInt32(slot + SLOT_PATH_OFFSET);
+			if (static_cast<u64>(pathOffset) + pathLength > m_stringsSize)
+			{
+				return 0;
+			}
+			const char *stored = reinterpret_cast<const char*>(p_strings + pathOffset);
+			bool equal = true;
+			for (u32 i = 0; i < length && equal; i++)
+			{
+				char c = (name[i] == '\\') ? '/' : name[i];
+				equal = (c == stored[i]);
+			}
+			if (equal)
+			{
+				return slot;
+			}
+		}
+		return 0;
+	}
+
+	bool PackFile::Find(const string &path, PackEntry &entry)
+	{
+		const u8 *slot = FindSlot(path);
+		if (slot == 0)
+		{
+			return false;
+		}
+		entry.offset = LoadUInt64(slot + SLOT_OFFSET);
+		entry.size = LoadUInt32(slot + SLOT_SIZE);
+		entry.originalSize = LoadUInt32(slot + SLOT_ORIGINAL_SIZE);
+		entry.compression = static_cast<pack::COMPRESSION>(slot[SLOT_COMPRESSION]);
+		//A corrupt slot pointing outside the pack counts as missing
+		return entry.offset + entry.size <= m_mapping.GetSize();
+	}
+
+	bool PackFile::Contains(const string &path)
+	{
+		return FindSlot(path) != 0;
+	}
+
+	ByteArray PackFile::Get(const string &path)
+	{
+		PackEntry entry;
+		if (!Find(path, entry))
+		{
+			return ByteArray();
+		}
+		return m_mapping.GetView(entry.offset, entry.size);
+	}
+
+	u64 PackFile::HashPath(const char *path, u32 length)
+	{
+		u64 hash = 14695981039346656037ull;
+		for (u32 i = 0; i < length; i++)
+		{
+			u8 c = static_cast<u8>((path[i] == '\\') ? '/' : path[i]);
+			hash = (hash ^ c) * 1099511628211ull;
+		}
+		return hash;
+	}
+
+	string PackFile::NormalizePath(const string &path)
+	{
+		u32 start = SkipPathPrefix(path.c_str(), static_cast<u32>(path.length()));
+		string normalized = path.substr(start);
+		std::replace(normalized.begin(), normalized.end(), '\\', '/');
+		return normalized;
+	}
+
+	bool PackWriter::Add(const string &path, const u8 *bytes, u32 length)
+	{
+		Source source;
+		source.bytes.assign(bytes, bytes + length);
+		source.size = length;
+		return AddSource(path, source);
+	}
+
+	bool PackWriter::Add(const string &path, ByteArray &bytes)
+	{
+		return Add(path, bytes.GetRawBytes(), bytes.GetLength());
+	}
+
+	bool PackWriter::AddFile(const string &path, const string &filePath)
+	{
+		FileReader reader(FileReader::DEFAULT_BUFFER_SIZE / 256);
+		if (!reader.Open(filePath) || reader.GetSize() > 0xFFFFFFFF)
+		{
+			return false;
+		}
+		Source source;
+		source.filePath = filePath;
+		source.size = static_cast<u32>(reader.GetSize());
+		return AddSource(path, source);
+	}
+
+	bool PackWriter::AddSource(const string &path, Source &source)
+	{
+		source.path = PackFile::NormalizePath(path);
+		source.offset = 0;
+		if (source.path.empty() || source.path.length() > 0xFFFF || m_paths.count(source.path) > 0)
+		{
+			return false;
+		}
+		m_paths.insert(source.path);
+		m_sources.push_back(source);
+		return true;
+	}
+
+	u32 PackWriter::AddDirectory(const string &directory)
+	{
+		return AddDirectory(directory, "");
+	}
+
+#ifdef _WIN32
+	u32 PackWriter::AddDirectory(const string &directory, const string &prefix)
+	{
+		WIN32_FIND_DATAW data;
+		HANDLE find = FindFirstFileW(nowide::widen(directory + "\\*").c_str(), &data);
+		if (find == INVALID_HANDLE_VALUE)
+		{
+			return 0;
+		}
+
+		u32 count = 0;
+		do
+		{
+			string name = nowide::narrow(data.cFileName);
+			if (name == "." || name == "..")
+			{
+				continue;
+			}
+			//Junctions and directory links can loop back on themselves, only real directories are walked
+			if ((data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0)
+			{
+				continue;
+			}
+			if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+			{
+				count += AddDirectory(directory + "\\" + name, prefix + name + "/");
+			}
+			else if (AddFile(prefix + name, directory + "\\" + name))
+			{
+				count++;
+			}
+		} while (FindNextFileW(find, &data));
+		FindClose(find);
+		return count;
+	}
+#else
+	u32 PackWriter::AddDirectory(const string &directory, const string &prefix)
+	{
+		DIR *listing = opendir(directory.c_str());
+		if (listing == 0)
+		{
+			return 0;
+		}
+
+		u32 count = 0;
+		dirent *item;
+		while ((item = readdir(listing)) != 0)
+		{
+			string name = item->d_name;
+			if (name == "." || name == "..")
+			{
+				continue;
+			}
+			string filePath = directory + "/" + name;
+			//lstat so symlinks show up as links and get skipped, a link to a parent would recurse forever
+			struct stat info;
+			if (lstat(filePath.c_str(), &info) != 0 || S_ISLNK(info.st_mode))
+			{
+				continue;
+			}
+			if (S_ISDIR(info.st_mode))
+			{
+				count += AddDirectory(filePath, prefix + name + "/");
+			}
+			else if (S_ISREG(info.st_mode) && AddFile(prefix + name, filePath))
+			{
+				count++;
+			}
+		}
+		closedir(listing);
+		return count;
+	}
+#endif
+
+	bool PackWriter::Write(const string &path)
+	{
+		//Sorted so assets from the same directory sit next to each other in the pack
+		std::sort(m_sources.begin(), m_sources.end());
+
+		u32 count = static_cast<u32>(m_sources.size());
+		u32 slotCount = 2;
+		while (slotCount < count * 2)
+		{
+			slotCount <<= 1;
+		}
+		u32 slotMask = slotCount - 1;
+
+		u32 stringsSize = 0;
+		for (u32 i = 0; i < count; i++)
+		{
+			stringsSize += static_cast<u32>(m_sources[i].path.length());
+		}
+		u64 stringsOffset = pack::HEADER_SIZE + static_cast<u64>(slotCount) * pack::ENTRY_SIZE;
+
+		u64 offset = AlignBlob(stringsOffset + stringsSize);
+		for (u32 i = 0; i < count; i++)
+		{
+			m_sources[i].offset = offset;
+			offset = AlignBlob(offset + m_sources[i].size);
+		}
+
+		ByteArray header(pack::HEADER_SIZE);
+		LittleEndianWriter headerWriter(header);
+		headerWriter.WriteUInt32(pack::MAGIC);
+		headerWriter.WriteUInt16(pack::VERSION);
+		headerWriter.WriteUInt16(0);
+		headerWriter.WriteUInt32(count);
+		headerWriter.WriteUInt32(slotCount);
+		headerWriter.WriteUInt64(stringsOffset);
+		headerWriter.WriteUInt32(stringsSize);
+		headerWriter.WriteUInt32(0);
+
+		ByteArray slots(slotCount * pack::ENTRY_SIZE);
+		memset(slots.GetRawBytes(), 0, slots.GetLength());
+		LittleEndianWriter slotWriter(slots);
+		string strings;
+		strings.reserve(stringsSize);
+		for (u32 i = 0; i < count; i++)
+		{
+			Source &source = m_sources[i];
+			u64 hash = PackFile::HashPath(source.path.c_str(), static_cast<u32>(source.path.length()));
+			u32 index = static_cast<u32>(hash) & slotMask;
+			while (LoadUInt16(slots.GetRawBytes() + index * pack::ENTRY_SIZE + SLOT_PATH_LENGTH) != 0)
+			{
+				index = (index + 1) & slotMask;
+			}
+
+			slotWriter.SetPosition(index * pack::ENTRY_SIZE);
+			slotWriter.WriteUInt64(hash);
+			slotWriter.WriteUInt64(source.offset);
+			slotWriter.WriteUInt32(source.size);
+			slotWriter.WriteUInt32(source.size);
+			slotWriter.WriteUInt32(static_cast<u32>(strings.length()));
+			slotWriter.WriteUInt16(static_cast<u16>(source.path.length()));
+			slotWriter.WriteUInt8(pack::COMPRESSION_NONE);
+			strings += source.path;
+		}
+
+		FileWriter writer;
+		if (!writer.Open(path, file::WRITE))
+		{
+			return false;
+		}
+		writer.Append(header);
+		writer.Append(slots);
+		writer.Append(reinterpret_cast<const u8*>(strings.data()), stringsSize);
+
+		std::vector<u8> padding(pack::BLOB_ALIGNMENT, 0);
+		ByteArray chunk(FileReader::DEFAULT_BUFFER_SIZE);
+		FileReader reader;
+		bool success = true;
+		for (u32 i = 0; i < count && success; i++)
+		{
+			Source &source = m_sources[i];
+			writer.Append(&padding[0], static_cast<u32>(source.offset - writer.Tell()));
+
+			if (source.filePath.empty())
+			{
+				success = source.size == 0 || writer.Append(&source.bytes[0], source.size);
+				continue;
+			}
+
+			//Streamed through one chunk so big assets never sit in memory whole
+			success = reader.Open(source.filePath);
+			u32 remaining = source.size;
+			while (success && remaining > 0)
+			{
+				u32 length = (remaining < chunk.GetLength()) ? remaining : chunk.GetLength();
+				success = reader.Read(chunk.GetRawBytes(), length) == length && writer.Append(chunk.GetRawBytes(), length);
+				remaining -= length;
+			}
+			reader.Close();
+		}
+
+		//The last blob is padded out too so every blob is a whole number of pages
+		if (success)
+		{
+			writer.Append(&padding[0], static_cast<u32>(offset - writer.Tell()));
+		}
+		return writer.Close() && success;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool PackFile::IsOpen()
+	{
+		return m_mapping.IsOpen();
+	}
+
+	u32 PackFile::GetEntryCount()
+	{
+		return m_entryCount;
+	}
+
+	MappedFile& PackFile::GetMapping()
+	{
+		return m_mapping;
+	}
+
+	u32 PackWriter::GetEntryCount()
+	{
+		return static_cast<u32>(m_sources.size());
+	}
+
+}
@@ -0,0 +1,202 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: PackFile, PackWriter
+*Description: Read only archive of many small assets in one file. A hash table of paths sits at
+*the front so finding an asset is a hash and a probe or two, and every blob starts on a 4KB
+*boundary so the whole pack can be mapped once and handed out as views.
+*Author: jkeon
+**********************************/
+
+#ifndef _PACKFILE_H_
+#define _PACKFILE_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/file/MappedFile.h>
+#include <set>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class ByteArray;
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace pack
+	{
+		enum COMPRESSION
+		{
+			COMPRESSION_NONE = 0
+		};
+
+		//Everything is little endian. The header is followed by the slot table, then the path
+		//strings, then the blobs.
+		static const u32 MAGIC = 0x4B41504C;
+		static const u16 VERSION = 1;
+		static const u32 HEADER_SIZE = 32;
+		static const u32 ENTRY_SIZE = 32;
+		static const u32 BLOB_ALIGNMENT = 4096;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	struct PackEntry
+	{
+		//From the start of the pack
+		u64 offset;
+		//Bytes stored in the pack, and bytes once decompressed
+		u32 size;
+		u32 originalSize;
+		pack::COMPRESSION compression;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Paths use forward slashes and are relative to the directory that was packed. Lookups
+	 * also accept backslashes and a leading "./". Once open, lookups are safe from any thread.
+	 */
+	class PackFile {
+
+	//PUBLIC FUNCTIONS
+	public:
+		PackFile();
+		~PackFile();
+
+		//Maps the whole pack, false if it can't be mapped or isn't a pack
+		bool Open(const string &path);
+		void Close();
+		bool IsOpen();
+
+		bool Find(const string &path, PackEntry &entry);
+		bool Contains(const string &path);
+		//A view of the stored bytes, only valid while the pack is open. Empty if the path isn't in
+		//the pack.
+		ByteArray Get(const string &path);
+
+		u32 GetEntryCount();
+		MappedFile& GetMapping();
+
+		//FNV-1a over the normalized path
+		static u64 HashPath(const char *path, u32 length);
+		//Forward slashes, no leading "./" or "/"
+		static string NormalizePath(const string &path);
+
+	//PRIVATE FUNCTIONS
+	private:
+		PackFile(const PackFile &other);
+		PackFile& operator = (const PackFile &other);
+
+		//The slot holding the path, 0 if there isn't one
+		const u8* FindSlot(const string &path);
+
+	//PRIVATE VARIABLES
+	private:
+		MappedFile m_mapping;
+		u32 m_entryCount;
+		u32 m_slotMask;
+		const u8 *p_slots;
+		const u8 *p_strings;
+		u32 m_stringsSize;
+
+	};
+
+	/**
+	 * Collects assets and writes them out as a pack in one go. Assets added from disk are only
+	 * read when Write runs.
+	 */
+	class PackWriter {
+
+	//PUBLIC FUNCTIONS
+	public:
+		PackWriter();
+		~PackWriter();
+
+		//False for an empty path or one that's already been added. The bytes are copied.
+		bool Add(const string &path, const u8 *bytes, u32 length);
+		bool Add(const string &path, ByteArray &bytes);
+		bool AddFile(const string &path, const string &filePath);
+		//Every file below the directory, named by its path relative to it. Symlinks are skipped. Returns how many were added.
+		u32 AddDirectory(const string &directory);
+
+		bool Write(const string &path);
+
+		u32 GetEntryCount();
+
+	//PRIVATE FUNCTIONS
+	private:
+		PackWriter(const PackWriter &other);
+		PackWriter& operator = (const PackWriter &other);
+
+		struct Source
+		{
+			string path;
+			//Empty for assets added from memory
+			string filePath;
+			std::vector<u8> bytes;
+			u32 size;
+			u64 offset;
+
+			bool operator < (const Source &other) const { return path < other.path; }
+		};
+
+		bool AddSource(const string &path, Source &source);
+		u32 AddDirectory(const string &directory, const string &prefix);
+
+	//PRIVATE VARIABLES
+	private:
+		std::vector<Source> m_sources;
+		std::set<string> m_paths;
+
+	};
+}
+#endif
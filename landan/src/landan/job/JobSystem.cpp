@@ -0,0 +1,449 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "JobSystem.h"
+#include <landan/job/WorkStealingDeque.h>
+#include <landan/thread/Atomic.h>
+#include <landan/thread/Thread.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	struct JobSystem::Worker
+	{
+		Worker(u32 seed)
+		:deque(MAX_JOBS_PER_THREAD), jobs(new Job[MAX_JOBS_PER_THREAD]), nextJob(0), random(seed)
+		{
+			for (u32 i = 0; i < MAX_JOBS_PER_THREAD; i++)
+			{
+				jobs[i].unfinished = 0;
+			}
+		}
+
+		~Worker()
+		{
+			delete[] jobs;
+		}
+
+		WorkStealingDeque deque;
+		Job *jobs;
+		u32 nextJob;
+		//Picks who to steal from first so idle threads don't all pile onto the same victim
+		u32 random;
+	};
+
+	namespace
+	{
+		//One batch of a ParallelFor, lives on the calling thread's stack until the batches finish
+		struct ParallelForRange
+		{
+			Function<void (u32, u32)> body;
+			u32 begin;
+			u32 end;
+		};
+
+		u32 NextRandom(u32 &state)
+		{
+			//xorshift32
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return state;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	LANDAN_THREAD_LOCAL JobSystem *JobSystem::CURRENT_SYSTEM = 0;
+	LANDAN_THREAD_LOCAL u32 JobSystem::CURRENT_WORKER = 0;
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	JobSystem::JobSystem()
+	:m_running(0), m_nextWorker(0), m_shared(SHARED_QUEUE_CAPACITY), m_nextSharedJob(0)
+	{
+		p_sharedJobs = new Job[MAX_JOBS_PER_THREAD];
+		for (u32 i = 0; i < MAX_JOBS_PER_THREAD; i++)
+		{
+			p_sharedJobs[i].unfinished = 0;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	JobSystem::~JobSystem()
+	{
+		Stop();
+
+		if (p_sharedJobs != 0)
+		{
+			delete[] p_sharedJobs;
+			p_sharedJobs = 0;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// PUBLIC FUNCTIONS //////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool JobSystem::Start(u32 workerCount)
+	{
+		if (!m_workers.empty())
+		{
+			return false;
+		}
+
+		if (workerCount == job::AUTO_WORKER_COUNT)
+		{
+			workerCount = Thread::GetProcessorCount() - 1;
+		}
+
+		for (u32 i = 0; i <= workerCount; i++)
+		{
+			m_workers.push_back(new Worker(0x9E3779B9u * (i + 1)));
+		}
+		CURRENT_SYSTEM = this;
+		CURRENT_WORKER = 0;
+		AtomicStoreRelease(&m_nextWorker, 1);
+		AtomicStoreRelease(&m_running, 1);
+
+		for (u32 i = 0; i < workerCount; i++)
+		{
+			m_threads.push_back(new Thread(MEMBER_FUNCTION(&JobSystem::WorkerLoop, this)));
+		}
+		for (u32 i = 0; i < m_threads.size(); i++)
+		{
+			if (!m_threads[i]->Start())
+			{
+				Stop();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void JobSystem::Stop()
+	{
+		AtomicStoreRelease(&m_running, 0);
+		for (u32 i = 0; i < m_threads.size(); i++)
+		{
+			m_threads[i]->Join();
+			delete m_threads[i];
+		}
+		m_threads.clear();
+
+		for (u32 i = 0; i < m_workers.size(); i++)
+		{
+			delete m_workers[i];
+		}
+		m_workers.clear();
+
+		Job *dropped;
+		while (m_shared.TryPop(dropped))
+		{
+		}
+
+		if (CURRENT_SYSTEM == this)
+		{
+			CURRENT_SYSTEM = 0;
+		}
+	}
+
+	bool JobSystem::IsRunning()
+	{
+		return AtomicLoadAcquire(&m_running) == 1;
+	}
+
+	u32 JobSystem::GetWorkerCount()
+	{
+		return static_cast<u32>(m_threads.size());
+	}
+
+	Job* JobSystem::Create(Function<void (Job&)> function, void *data, Job *parent)
+	{
+		//Comes back already claimed with a count of 1
+		Job *job = AllocateJob(GetCurrentWorker());
+		job->function = function;
+		job->data = data;
+		job->parent = parent;
+
+		if (parent != 0)
+		{
+			AtomicFetchAdd(&parent->unfinished, 1);
+		}
+		return job;
+	}
+
+	void JobSystem::Run(Job *job)
+	{
+		Worker *worker = GetCurrentWorker();
+		bool queued = (worker != 0) ? worker->deque.Push(job) : m_shared.TryPush(job);
+		if (!queued)
+		{
+			Execute(job);
+		}
+	}
+
+	void JobSystem::Wait(Job *job)
+	{
+		Worker *worker = GetCurrentWorker();
+		while (!IsFinished(job))
+		{
+			Job *next = FindJob(worker);
+			if (next != 0)
+			{
+				Execute(next);
+			}
+			else
+			{
+				Thread::YieldThread();
+			}
+		}
+	}
+
+	bool JobSystem::IsFinished(Job *job)
+	{
+		return AtomicLoadAcquire(&job->unfinished) == 0;
+	}
+
+	bool JobSystem::RunQueuedJob()
+	{
+		Job *job = FindJob(GetCurrentWorker());
+		if (job == 0)
+		{
+			return false;
+		}
+		Execute(job);
+		return true;
+	}
+
+	void JobSystem::ParallelFor(u32 count, u32 batchSize, Function<void (u32, u32)> body)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (batchSize == 0)
+		{
+			u32 threadCount = m_workers.empty() ? 1 : static_cast<u32>(m_workers.size());
+			batchSize = count / (threadCount * 4);
+			batchSize = (batchSize > 0) ? batchSize : 1;
+		}
+
+		//Cap the batches at half the calling thread's job ring so one call can't fill it
+		u32 maxBatches = MAX_JOBS_PER_THREAD / 2;
+		u32 batchCount = (count - 1) / batchSize + 1;
+		if (batchCount > maxBatches)
+		{
+			batchSize = (count - 1) / maxBatches + 1;
+			batchCount = (count - 1) / batchSize + 1;
+		}
+
+		if (batchCount == 1)
+		{
+			body(0, count);
+			return;
+		}
+
+		std::vector<ParallelForRange> ranges(batchCount);
+		Job *root = Create(Function<void (Job&)>());
+		for (u32 i = 0; i < batchCount; i++)
+		{
+			ranges[i].body = body;
+			ranges[i].begin = i * batchSize;
+			ranges[i].end = (i == batchCount - 1) ? count : ranges[i].begin + batchSize;
+			Run(Create(FREE_FUNCTION(&JobSystem::RunRange), &ranges[i], root));
+		}
+
+		//The root has nothing to run itself, drop its own count and wait on the batches
+		Finish(root);
+		Wait(root);
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// PRIVATE FUNCTIONS /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	void JobSystem::WorkerLoop()
+	{
+		u32 index = AtomicFetchAdd(&m_nextWorker, 1);
+		CURRENT_SYSTEM = this;
+		CURRENT_WORKER = index;
+		Worker *worker = m_workers[index];
+
+		u32 idleCount = 0;
+		while (AtomicLoadAcquire(&m_running) == 1)
+		{
+			Job *job = FindJob(worker);
+			if (job != 0)
+			{
+				Execute(job);
+				idleCount = 0;
+			}
+			else if (idleCount < IDLE_YIELD_COUNT)
+			{
+				idleCount++;
+				Thread::YieldThread();
+			}
+			else
+			{
+				Thread::SleepFor(IDLE_SLEEP_MILLISECONDS);
+			}
+		}
+
+		CURRENT_SYSTEM = 0;
+	}
+
+	JobSystem::Worker* JobSystem::GetCurrentWorker()
+	{
+		if (CURRENT_SYSTEM != this || CURRENT_WORKER >= m_workers.size())
+		{
+			return 0;
+		}
+		return m_workers[CURRENT_WORKER];
+	}
+
+	Job* JobSystem::AllocateJob(Worker *worker)
+	{
+		//Pool threads take from their own ring, everyone else shares one. A slot is only free again once
+		//its job and all of its children have finished, by then it has left every deque and nobody runs it.
+		for (;;)
+		{
+			for (u32 i = 0; i < MAX_JOBS_PER_THREAD; i++)
+			{
+				u32 index = (worker != 0) ? worker->nextJob++ : AtomicFetchAdd(&m_nextSharedJob, 1);
+				Job *job = (worker != 0) ? &worker->jobs[index & (MAX_JOBS_PER_THREAD - 1)] : &p_sharedJobs[index & (MAX_JOBS_PER_THREAD - 1)];
+				//Claimed with a compare exchange since threads outside the pool race for the shared ring
+				if (AtomicLoadAcquire(&job->unfinished) == 0 && AtomicCompareExchange(&job->unfinished, 1u, 0u) == 0)
+				{
+					return job;
+				}
+			}
+
+			//Every slot is still live, help run queued jobs until one frees up
+			Job *next = FindJob(worker);
+			if (next != 0)
+			{
+				Execute(next);
+			}
+			else
+			{
+				Thread::YieldThread();
+			}
+		}
+	}
+
+	Job* JobSystem::FindJob(Worker *worker)
+	{
+		Job *job = 0;
+		if (worker != 0)
+		{
+			job = worker->deque.Pop();
+			if (job != 0)
+			{
+				return job;
+			}
+		}
+
+		if (m_shared.TryPop(job))
+		{
+			return job;
+		}
+
+		u32 workerCount = static_cast<u32>(m_workers.size());
+		if (workerCount == 0)
+		{
+			return 0;
+		}
+
+		u32 seed = Thread::GetCurrentId() * 0x9E3779B9u;
+		u32 start = NextRandom((worker != 0) ? worker->random : seed) % workerCount;
+		for (u32 i = 0; i < workerCount; i++)
+		{
+			Worker *victim = m_workers[(start + i) % workerCount];
+			if (victim == worker)
+			{
+				continue;
+			}
+			job = victim->deque.Steal();
+			if (job != 0)
+			{
+				return job;
+			}
+		}
+		return 0;
+	}
+
+	void JobSystem::Execute(Job *job)
+	{
+		if (job->function)
+		{
+			job->function(*job);
+		}
+		Finish(job);
+	}
+
+	void JobSystem::Finish(Job *job)
+	{
+		//Read before the count drops, the job can be recycled the moment it reaches zero
+		Job *parent = job->parent;
+		if (AtomicFetchAdd(&job->unfinished, 0xFFFFFFFF) == 1 && parent != 0)
+		{
+			Finish(parent);
+		}
+	}
+
+	void JobSystem::RunRange(Job &job)
+	{
+		ParallelForRange *range = static_cast<ParallelForRange*>(job.data);
+		range->body(range->begin, range->end);
+	}
+
+}
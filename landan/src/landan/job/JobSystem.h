@@ -0,0 +1,176 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: JobSystem
+ *Description: Fixed pool of worker threads running small jobs. Each thread pushes and pops jobs
+ *on its own WorkStealingDeque and steals from the others when it runs dry. A thread waiting on a
+ *job keeps running other jobs until it finishes, so waiting never idles a core.
+ *Author: jkeon
+ **********************************/
+
+#ifndef _JOBSYSTEM_H_
+#define _JOBSYSTEM_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/thread/BoundedQueue.h>
+#include <landan/thread/ThreadLocal.h>
+#include <landan/util/Function.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class Thread;
+	class WorkStealingDeque;
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTANTS /////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace job
+	{
+		//One worker per core, less the thread that starts the pool
+		const u32 AUTO_WORKER_COUNT = 0xFFFFFFFF;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Jobs are handed out by JobSystem::Create and the pointer is the handle to wait on. They come
+	 * from a ring per thread and a slot is reused as soon as its job and children have finished, so
+	 * don't hold on to one after waiting on it. A job that is created has to be run, otherwise its
+	 * slot never frees up.
+	 */
+	struct Job
+	{
+		Function<void (Job&)> function;
+		void *data;
+		//Has its count held open until this job finishes
+		Job *parent;
+		//This job plus its unfinished children, finished at zero
+		volatile u32 unfinished;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class JobSystem {
+
+	//PUBLIC FUNCTIONS
+	public:
+		JobSystem();
+		//Stops the pool if it's still running
+		~JobSystem();
+
+		//The calling thread joins the pool as well, it runs jobs whenever it waits on one. With no
+		//workers everything runs on that thread inside Wait.
+		bool Start(u32 workerCount = job::AUTO_WORKER_COUNT);
+		//Jobs that haven't started yet are dropped, wait on anything that has to finish first
+		void Stop();
+		bool IsRunning();
+		u32 GetWorkerCount();
+
+		//Nothing runs until the job is passed to Run. Adding children to a job is only safe
+		//before it's run or from inside its function. When every slot in the calling thread's ring
+		//is still live this runs queued jobs until one finishes.
+		Job* Create(Function<void (Job&)> function, void *data = 0, Job *parent = 0);
+		//Runs the job inline if there's no room left to queue it
+		void Run(Job *job);
+		void Wait(Job *job);
+		bool IsFinished(Job *job);
+		//Runs one queued job on the calling thread, false if there was nothing to take
+		bool RunQueuedJob();
+
+		//Calls body(begin, end) over [0, count) in batches of batchSize, 0 picks a size that gives
+		//each thread a few batches to balance with. Returns once every batch has finished.
+		void ParallelFor(u32 count, u32 batchSize, Function<void (u32, u32)> body);
+
+	//PRIVATE FUNCTIONS
+	private:
+		JobSystem(const JobSystem &other);
+		JobSystem& operator = (const JobSystem &other);
+
+		struct Worker;
+
+		void WorkerLoop();
+		//The calling thread's slot, 0 for threads outside the pool
+		Worker* GetCurrentWorker();
+		Job* AllocateJob(Worker *worker);
+		Job* FindJob(Worker *worker);
+		void Execute(Job *job);
+		void Finish(Job *job);
+
+		static void RunRange(Job &job);
+
+	//PUBLIC VARIABLES
+	public:
+		static const u32 MAX_JOBS_PER_THREAD = 4096;
+		//Jobs queued by threads outside the pool
+		static const u32 SHARED_QUEUE_CAPACITY = 1024;
+		//Empty polls a worker yields through before it starts sleeping
+		static const u32 IDLE_YIELD_COUNT = 1024;
+		static const u32 IDLE_SLEEP_MILLISECONDS = 1;
+
+	//PRIVATE VARIABLES
+	private:
+		volatile u32 m_running;
+		volatile u32 m_nextWorker;
+
+		//Slot 0 belongs to the thread that called Start, the rest to the pool threads
+		std::vector<Worker*> m_workers;
+		std::vector<Thread*> m_threads;
+
+		BoundedQueue<Job*> m_shared;
+		Job *p_sharedJobs;
+		volatile u32 m_nextSharedJob;
+
+		static LANDAN_THREAD_LOCAL JobSystem *CURRENT_SYSTEM;
+		static LANDAN_THREAD_LOCAL u32 CURRENT_WORKER;
+
+	};
+}
+#endif
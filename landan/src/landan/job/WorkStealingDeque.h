@@ -0,0 +1,186 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: WorkStealingDeque
+ *Description: Fixed capacity Chase-Lev deque of jobs. The owning thread pushes and pops at the
+ *bottom without any locked instructions except when racing for the last job, every other thread
+ *steals from the top with a single compare exchange.
+ *Author: jkeon
+ **********************************/
+
+#ifndef _WORKSTEALINGDEQUE_H_
+#define _WORKSTEALINGDEQUE_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/thread/Atomic.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	struct Job;
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class WorkStealingDeque {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//Capacity is rounded up to a power of two
+		WorkStealingDeque(u32 capacity)
+		:m_top(0), m_bottom(0)
+		{
+			m_capacity = 2;
+			while (m_capacity < capacity)
+			{
+				m_capacity <<= 1;
+			}
+			m_mask = m_capacity - 1;
+
+			p_jobs = new Job*[m_capacity];
+			for (u32 i = 0; i < m_capacity; i++)
+			{
+				p_jobs[i] = 0;
+			}
+		}
+
+		~WorkStealingDeque()
+		{
+			delete[] p_jobs;
+		}
+
+		//Owner only. Returns false if the deque is full.
+		bool Push(Job *job)
+		{
+			u32 bottom = m_bottom;
+			u32 top = AtomicLoadAcquire(&m_top);
+			if (static_cast<i32>(bottom - top) >= static_cast<i32>(m_capacity))
+			{
+				return false;
+			}
+			p_jobs[bottom & m_mask] = job;
+			//Publishes the job before thieves can see the new bottom
+			AtomicStoreRelease(&m_bottom, bottom + 1);
+			return true;
+		}
+
+		//Owner only. Takes the most recently pushed job, 0 if there's none.
+		Job* Pop()
+		{
+			u32 bottom = m_bottom - 1;
+			AtomicStoreRelease(&m_bottom, bottom);
+			//The bottom store has to be visible before top is read or a thief and the owner can both take the last job
+			AtomicThreadFence();
+			u32 top = AtomicLoadAcquire(&m_top);
+
+			i32 size = static_cast<i32>(bottom - top);
+			if (size < 0)
+			{
+				AtomicStoreRelease(&m_bottom, top);
+				return 0;
+			}
+
+			Job *job = p_jobs[bottom & m_mask];
+			if (size > 0)
+			{
+				return job;
+			}
+
+			//Last job, whoever moves top first gets it
+			if (AtomicCompareExchange(&m_top, top + 1, top) != top)
+			{
+				job = 0;
+			}
+			AtomicStoreRelease(&m_bottom, top + 1);
+			return job;
+		}
+
+		//Any thread. Takes the oldest job, 0 if there's none or another thread won the race for it.
+		Job* Steal()
+		{
+			u32 top = AtomicLoadAcquire(&m_top);
+			AtomicThreadFence();
+			u32 bottom = AtomicLoadAcquire(&m_bottom);
+			if (static_cast<i32>(bottom - top) <= 0)
+			{
+				return 0;
+			}
+
+			Job *job = static_cast<Job*>(AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile*>(&p_jobs[top & m_mask])));
+			if (AtomicCompareExchange(&m_top, top + 1, top) != top)
+			{
+				return 0;
+			}
+			return job;
+		}
+
+		//Only a snapshot when other threads are stealing
+		bool IsEmpty()
+		{
+			return static_cast<i32>(AtomicLoadAcquire(&m_bottom) - AtomicLoadAcquire(&m_top)) <= 0;
+		}
+
+		u32 GetCapacity()
+		{
+			return m_capacity;
+		}
+
+	//PRIVATE FUNCTIONS
+	private:
+		WorkStealingDeque(const WorkStealingDeque &other);
+		WorkStealingDeque& operator = (const WorkStealingDeque &other);
+
+	//PRIVATE VARIABLES
+	private:
+		//Thieves advance top, the owner moves bottom
+		volatile u32 m_top;
+		volatile u32 m_bottom;
+		u32 m_capacity;
+		u32 m_mask;
+		Job *volatile *p_jobs;
+
+	};
+}
+#endif
@@ -0,0 +1,225 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <vector>
+#include <landan/thread/Atomic.h>
+#include <landan/timer/Timer.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	FrameProfiler::FrameProfiler(u32 capacity)
+	:m_frameCount(0), m_lastFrameEndTicks(0)
+	{
+		//Power of two so the ring index is a mask instead of a divide
+		m_capacity = 1;
+		while (m_capacity < capacity)
+		{
+			m_capacity <<= 1;
+		}
+		m_mask = m_capacity - 1;
+
+		p_records = new FrameRecord[m_capacity];
+		for (u32 i = 0; i < m_capacity; i++)
+		{
+			p_records[i].sequence = 0;
+		}
+		for (u32 i = 0; i < profile::PHASE_COUNT; i++)
+		{
+			m_currentTicks[i] = 0;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	FrameProfiler::~FrameProfiler()
+	{
+		if (p_records != 0)
+		{
+			delete[] p_records;
+			p_records = 0;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	void FrameProfiler::AddTicks(profile::FRAME_PHASE phase, u64 ticks)
+	{
+		m_currentTicks[phase] += ticks;
+	}
+
+	void FrameProfiler::EndFrame()
+	{
+		//Total is measured end to end so it also catches time the phases don't account for
+		u64 currentTicks = Timer::GetTicks();
+		if (m_lastFrameEndTicks != 0)
+		{
+			m_currentTicks[profile::TOTAL] = currentTicks - m_lastFrameEndTicks;
+		}
+		else
+		{
+			m_currentTicks[profile::TOTAL] = m_currentTicks[profile::UPDATE] + m_currentTicks[profile::RENDER] + m_currentTicks[profile::IDLE];
+		}
+		m_lastFrameEndTicks = currentTicks;
+
+		//Only this thread writes so a plain read of the counter is fine here
+		FrameRecord &record = p_records[static_cast<u32>(m_frameCount) & m_mask];
+		u32 sequence = record.sequence;
+
+		AtomicStoreRelease(&record.sequence, sequence + 1);
+		AtomicThreadFence();
+		for (u32 i = 0; i < profile::PHASE_COUNT; i++)
+		{
+			record.ticks[i] = m_currentTicks[i];
+			m_currentTicks[i] = 0;
+		}
+		AtomicStoreRelease(&record.sequence, sequence + 2);
+
+		AtomicStoreRelease(&m_frameCount, m_frameCount + 1);
+	}
+
+	u32 FrameProfiler::Snapshot(profile::FRAME_PHASE phase, u64 *samples)
+	{
+		u32 count = 0;
+		for (u32 i = 0; i < m_capacity; i++)
+		{
+			FrameRecord &record = p_records[i];
+
+			//Zero means never written, odd means mid write
+			u32 before = AtomicLoadAcquire(&record.sequence);
+			if (before == 0 || (before & 1) != 0)
+			{
+				continue;
+			}
+			u64 ticks = record.ticks[phase];
+			AtomicThreadFence();
+			u32 after = AtomicLoadAcquire(&record.sequence);
+
+			//The writer lapped us while we were reading, skip it rather than report a torn value
+			if (before != after)
+			{
+				continue;
+			}
+			samples[count] = ticks;
+			count++;
+		}
+		return count;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	u64 FrameProfiler::GetFrameCount()
+	{
+		return AtomicLoadAcquire(&m_frameCount);
+	}
+
+	u32 FrameProfiler::GetCapacity()
+	{
+		return m_capacity;
+	}
+
+	void FrameProfiler::GetStats(profile::FRAME_PHASE phase, FrameStats &stats)
+	{
+		std::vector<u64> samples(m_capacity);
+		u32 count = Snapshot(phase, &samples[0]);
+
+		stats.sampleCount = count;
+		if (count == 0)
+		{
+			stats.minMilliSeconds = stats.averageMilliSeconds = stats.p50MilliSeconds = stats.p99MilliSeconds = stats.maxMilliSeconds = 0.0;
+			return;
+		}
+
+		std::sort(samples.begin(), samples.begin() + count);
+
+		u64 sum = 0;
+		for (u32 i = 0; i < count; i++)
+		{
+			sum += samples[i];
+		}
+
+		//Nearest rank percentiles
+		stats.minMilliSeconds = Timer::TicksToMilliSeconds(samples[0]);
+		stats.averageMilliSeconds = Timer::TicksToMilliSeconds(sum) / static_cast<f64>(count);
+		stats.p50MilliSeconds = Timer::TicksToMilliSeconds(samples[((count - 1) * 50) / 100]);
+		stats.p99MilliSeconds = Timer::TicksToMilliSeconds(samples[((count - 1) * 99) / 100]);
+		stats.maxMilliSeconds = Timer::TicksToMilliSeconds(samples[count - 1]);
+	}
+
+	void FrameProfiler::GetHistogram(profile::FRAME_PHASE phase, f64 bucketMilliSeconds, u32 *buckets, u32 bucketCount)
+	{
+		if (bucketCount == 0)
+		{
+			return;
+		}
+		for (u32 i = 0; i < bucketCount; i++)
+		{
+			buckets[i] = 0;
+		}
+		//Written so NaN is caught too, nothing sensible can be bucketed without a positive width
+		if (!(bucketMilliSeconds > 0.0))
+		{
+			return;
+		}
+
+		std::vector<u64> samples(m_capacity);
+		u32 count = Snapshot(phase, &samples[0]);
+
+		for (u32 i = 0; i < count; i++)
+		{
+			f64 bucket = Timer::TicksToMilliSeconds(samples[i]) / bucketMilliSeconds;
+			u32 index = (bucket < static_cast<f64>(bucketCount - 1)) ? static_cast<u32>(bucket) : bucketCount - 1;
+			buckets[index]++;
+		}
+	}
+
+}
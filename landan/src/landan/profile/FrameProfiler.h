@@ -0,0 +1,137 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: FrameProfiler
+*Description: Rolling per-frame timings of the scaffold loop. Written by the loop
+*thread, readable from any thread without locking.
+*Author: jkeon
+**********************************/
+
+#ifndef _FRAMEPROFILER_H_
+#define _FRAMEPROFILER_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace profile
+	{
+		enum FRAME_PHASE
+		{
+			UPDATE = 0,
+			RENDER = 1,
+			IDLE = 2,
+			TOTAL = 3,
+			PHASE_COUNT = 4
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	struct FrameStats
+	{
+		u32 sampleCount;
+		f64 minMilliSeconds;
+		f64 averageMilliSeconds;
+		f64 p50MilliSeconds;
+		f64 p99MilliSeconds;
+		f64 maxMilliSeconds;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class FrameProfiler {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//Capacity is rounded up to a power of two and is the number of frames the rolling stats cover
+		FrameProfiler(u32 capacity = 512);
+		~FrameProfiler();
+
+		//Called by the loop thread while a frame is in progress
+		void AddTicks(profile::FRAME_PHASE phase, u64 ticks);
+		void EndFrame();
+
+		//Safe to call from any thread
+		u64 GetFrameCount();
+		u32 GetCapacity();
+		void GetStats(profile::FRAME_PHASE phase, FrameStats &stats);
+		//Counts frames into buckets of bucketMilliSeconds width, the last bucket also takes everything longer.
+		//A width that isn't positive leaves every bucket at zero.
+		void GetHistogram(profile::FRAME_PHASE phase, f64 bucketMilliSeconds, u32 *buckets, u32 bucketCount);
+
+	//PRIVATE FUNCTIONS
+	private:
+		FrameProfiler(const FrameProfiler &other);
+		FrameProfiler& operator = (const FrameProfiler &other);
+
+		//Copies the valid samples of one phase out of the ring, returns how many were copied
+		u32 Snapshot(profile::FRAME_PHASE phase, u64 *samples);
+
+	//PRIVATE VARIABLES
+	private:
+		struct FrameRecord
+		{
+			//Odd while the slot is being written so readers can discard torn records
+			volatile u32 sequence;
+			u64 ticks[profile::PHASE_COUNT];
+		};
+
+		FrameRecord *p_records;
+		u32 m_capacity;
+		u32 m_mask;
+
+		volatile u64 m_frameCount;
+		u64 m_currentTicks[profile::PHASE_COUNT];
+		u64 m_lastFrameEndTicks;
+	
+	};
+}
+#endif
@@ -0,0 +1,293 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "Profiler.h"
+
+#include <iomanip>
+#include <nowide/fstream.hpp>
+#include <landan/thread/Atomic.h>
+#include <landan/timer/Timer.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	struct ProfileEvent
+	{
+		//Zero while the slot is empty or being written
+		volatile u32 handle;
+		u32 depth;
+		const char *name;
+		u64 beginTicks;
+		//Zero until the scope closes
+		volatile u64 endTicks;
+	};
+
+	struct Profiler::ThreadBuffer
+	{
+		u32 threadId;
+		u32 mask;
+		ProfileEvent *events;
+		u32 nextHandle;
+		u32 depth;
+		//Nonzero while a thread owns the buffer
+		volatile u32 inUse;
+		ThreadBuffer *next;
+	};
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	u32 Profiler::EVENTS_PER_THREAD = 16384;
+	volatile u32 Profiler::ENABLED = 1;
+	volatile u32 Profiler::THREAD_COUNT = 0;
+	volatile u32 Profiler::THREAD_BUFFER_COUNT = 0;
+	Profiler::ThreadBuffer *volatile Profiler::THREAD_BUFFERS = 0;
+	LANDAN_THREAD_LOCAL Profiler::ThreadBuffer *Profiler::THREAD_BUFFER = 0;
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+	{
+		if (THREAD_BUFFER != 0)
+		{
+			return THREAD_BUFFER;
+		}
+
+		//First event on this thread, take over a buffer left behind by a thread that has exited
+		ThreadBuffer *buffer = static_cast<ThreadBuffer*>(AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&THREAD_BUFFERS)));
+		while (buffer != 0)
+		{
+			if (buffer->mask == EVENTS_PER_THREAD - 1 && AtomicLoadAcquire(&buffer->inUse) == 0 && AtomicCompareExchange(&buffer->inUse, 1u, 0u) == 0)
+			{
+				buffer->depth = 0;
+				THREAD_BUFFER = buffer;
+				return buffer;
+			}
+			buffer = buffer->next;
+		}
+
+		//None free, allocate everything this thread will ever need up front
+		buffer = new ThreadBuffer();
+		buffer->threadId = AtomicFetchAdd(&THREAD_COUNT, 1) + 1;
+		buffer->mask = EVENTS_PER_THREAD - 1;
+		buffer->events = new ProfileEvent[EVENTS_PER_THREAD];
+		for (u32 i = 0; i < EVENTS_PER_THREAD; i++)
+		{
+			buffer->events[i].handle = 0;
+			buffer->events[i].endTicks = 0;
+		}
+		buffer->nextHandle = 1;
+		buffer->depth = 0;
+		buffer->inUse = 1;
+		AtomicFetchAdd(&THREAD_BUFFER_COUNT, 1);
+
+		//Push onto the global list so the dump can find it, buffers live as long as the process
+		void *head;
+		do
+		{
+			head = AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&THREAD_BUFFERS));
+			buffer->next = static_cast<ThreadBuffer*>(head);
+		} while (AtomicCompareExchangePointer(reinterpret_cast<void *volatile *>(&THREAD_BUFFERS), buffer, head) != head);
+
+		THREAD_BUFFER = buffer;
+		return buffer;
+	}
+
+	u32 Profiler::BeginScope(const char *name)
+	{
+		if (AtomicLoadAcquire(&ENABLED) == 0)
+		{
+			return 0;
+		}
+
+		ThreadBuffer *buffer = GetThreadBuffer();
+		u32 handle = buffer->nextHandle;
+		//Handle zero means no event so skip it when wrapping
+		buffer->nextHandle = (handle + 1 != 0) ? handle + 1 : 1;
+
+		//Oldest events get overwritten once the ring is full
+		ProfileEvent &event = buffer->events[handle & buffer->mask];
+		AtomicStoreRelease(&event.handle, 0);
+		event.name = name;
+		event.depth = buffer->depth;
+		event.endTicks = 0;
+		event.beginTicks = Timer::GetTicks();
+		AtomicStoreRelease(&event.handle, handle);
+
+		buffer->depth++;
+		return handle;
+	}
+
+	void Profiler::EndScope(u32 handle)
+	{
+		if (handle == 0)
+		{
+			return;
+		}
+
+		u64 endTicks = Timer::GetTicks();
+		ThreadBuffer *buffer = GetThreadBuffer();
+		buffer->depth--;
+
+		//Scopes that outlived a full lap of the ring have lost their slot
+		ProfileEvent &event = buffer->events[handle & buffer->mask];
+		if (AtomicLoadAcquire(&event.handle) == handle)
+		{
+			AtomicStoreRelease(&event.endTicks, endTicks);
+		}
+	}
+
+	bool Profiler::WriteChromeTrace(const string &path)
+	{
+		nowide::ofstream fileStream(path.c_str(), nowide::ofstream::out | nowide::ofstream::binary);
+		if (!fileStream)
+		{
+			return false;
+		}
+
+		fileStream << "{\"traceEvents\":[";
+		fileStream << std::fixed << std::setprecision(3);
+
+		bool first = true;
+		ThreadBuffer *buffer = static_cast<ThreadBuffer*>(AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&THREAD_BUFFERS)));
+		while (buffer != 0)
+		{
+			for (u32 i = 0; i <= buffer->mask; i++)
+			{
+				ProfileEvent &event = buffer->events[i];
+				u32 handle = AtomicLoadAcquire(&event.handle);
+				u64 endTicks = AtomicLoadAcquire(&event.endTicks);
+				if (handle == 0 || endTicks == 0)
+				{
+					continue;
+				}
+
+				//Complete events, Chrome rebuilds the hierarchy from the nesting of the time ranges
+				fileStream << (first ? "\n" : ",\n");
+				fileStream << "{\"name\":\"";
+				for (const char *c = event.name; *c != 0; c++)
+				{
+					if (*c == '"' || *c == '\\')
+					{
+						fileStream << '\\';
+					}
+					fileStream << *c;
+				}
+				fileStream << "\",\"cat\":\"landan\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId;
+				fileStream << ",\"ts\":" << Timer::TicksToMicroSeconds(event.beginTicks);
+				fileStream << ",\"dur\":" << Timer::TicksToMicroSeconds(endTicks - event.beginTicks);
+				fileStream << ",\"args\":{\"depth\":" << event.depth << "}}";
+				first = false;
+			}
+			buffer = buffer->next;
+		}
+
+		fileStream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+		fileStream.flush();
+		return !fileStream.fail();
+	}
+
+	void Profiler::Reset()
+	{
+		ThreadBuffer *buffer = static_cast<ThreadBuffer*>(AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&THREAD_BUFFERS)));
+		while (buffer != 0)
+		{
+			for (u32 i = 0; i <= buffer->mask; i++)
+			{
+				AtomicStoreRelease(&buffer->events[i].handle, 0);
+			}
+			buffer = buffer->next;
+		}
+	}
+
+	void Profiler::ReleaseThread()
+	{
+		ThreadBuffer *buffer = THREAD_BUFFER;
+		if (buffer == 0)
+		{
+			return;
+		}
+
+		THREAD_BUFFER = 0;
+		AtomicStoreRelease(&buffer->inUse, 0);
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	void Profiler::SetEventsPerThread(u32 eventsPerThread)
+	{
+		//Power of two so the ring index is a mask
+		u32 capacity = 1;
+		while (capacity < eventsPerThread)
+		{
+			capacity <<= 1;
+		}
+		EVENTS_PER_THREAD = capacity;
+	}
+
+	u32 Profiler::GetEventsPerThread()
+	{
+		return EVENTS_PER_THREAD;
+	}
+
+	void Profiler::SetEnabled(bool enabled)
+	{
+		AtomicStoreRelease(&ENABLED, enabled ? 1u : 0u);
+	}
+
+	bool Profiler::IsEnabled()
+	{
+		return AtomicLoadAcquire(&ENABLED) != 0;
+	}
+
+	u32 Profiler::GetThreadBufferCount()
+	{
+		return AtomicLoadAcquire(&THREAD_BUFFER_COUNT);
+	}
+
+}
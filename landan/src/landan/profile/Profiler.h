@@ -0,0 +1,142 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: Profiler
+*Description: Hierarchical scope profiler. Each thread records into its own
+*preallocated ring of events with no locking, the result can be dumped as a
+*Chrome trace (chrome://tracing or ui.perfetto.dev).
+*Author: jkeon
+**********************************/
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/thread/ThreadLocal.h>
+
+//////////////////////////////////////////////////////////////////////
+// MACROS ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#define LANDAN_PROFILE_CONCAT_INNER(a, b) a##b
+#define LANDAN_PROFILE_CONCAT(a, b) LANDAN_PROFILE_CONCAT_INNER(a, b)
+
+//Name must be a string literal or otherwise outlive the trace dump, only the pointer is stored
+#ifndef LANDAN_PROFILE_DISABLED
+#define LANDAN_PROFILE_SCOPE(name) landan::ProfileScope LANDAN_PROFILE_CONCAT(landanProfileScope, __LINE__)(name)
+#else
+#define LANDAN_PROFILE_SCOPE(name)
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class Profiler {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//Only affects threads that haven't recorded anything yet. Rounded up to a power of two.
+		static void SetEventsPerThread(u32 eventsPerThread);
+		static u32 GetEventsPerThread();
+
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		//Returns a handle for EndScope, prefer LANDAN_PROFILE_SCOPE over calling these directly
+		static u32 BeginScope(const char *name);
+		static void EndScope(u32 handle);
+
+		//Best called while the instrumented threads are quiet, scopes still open are left out
+		static bool WriteChromeTrace(const string &path);
+		static void Reset();
+		//Hands this thread's buffer back for the next new thread to reuse, its events stay in the dump
+		//until overwritten. Thread does this on exit, threads started any other way must call it themselves
+		static void ReleaseThread();
+		static u32 GetThreadBufferCount();
+
+	//PRIVATE FUNCTIONS
+	private:
+		Profiler();
+		~Profiler();
+		Profiler(const Profiler &other);
+		Profiler& operator = (const Profiler &other);
+
+		struct ThreadBuffer;
+		static ThreadBuffer* GetThreadBuffer();
+
+	//PRIVATE VARIABLES
+	private:
+		static u32 EVENTS_PER_THREAD;
+		static volatile u32 ENABLED;
+		static volatile u32 THREAD_COUNT;
+		static volatile u32 THREAD_BUFFER_COUNT;
+		static ThreadBuffer *volatile THREAD_BUFFERS;
+		static LANDAN_THREAD_LOCAL ThreadBuffer *THREAD_BUFFER;
+	
+	};
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class ProfileScope {
+
+	//PUBLIC FUNCTIONS
+	public:
+		ProfileScope(const char *name) : m_handle(Profiler::BeginScope(name)) {}
+		~ProfileScope() { Profiler::EndScope(m_handle); }
+
+	//PRIVATE FUNCTIONS
+	private:
+		ProfileScope(const ProfileScope &other);
+		ProfileScope& operator = (const ProfileScope &other);
+
+	//PRIVATE VARIABLES
+	private:
+		u32 m_handle;
+
+	};
+}
+#endif
@@ -0,0 +1,219 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: Atomic
+ *Description: Thin wrappers over the compiler's interlocked intrinsics.
+ *Author: jkeon
+ **********************************/
+
+#ifndef _ATOMIC_H_
+#define _ATOMIC_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// ATOMIC FUNCTIONS //////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#if defined(_MSC_VER)
+
+//Visual Studio gives volatile accesses acquire/release semantics, we only need to stop the compiler reordering around them
+inline u32 AtomicLoadAcquire(const volatile u32 *address)
+{
+	u32 value = *address;
+	_ReadWriteBarrier();
+	return value;
+}
+
+inline void AtomicStoreRelease(volatile u32 *address, u32 value)
+{
+	_ReadWriteBarrier();
+	*address = value;
+}
+
+//Plain 64 bit loads and stores can tear on 32 bit targets so go through the interlocked path
+inline u64 AtomicLoadAcquire(const volatile u64 *address)
+{
+	return static_cast<u64>(_InterlockedCompareExchange64(reinterpret_cast<volatile __int64*>(const_cast<volatile u64*>(address)), 0, 0));
+}
+
+inline u64 AtomicCompareExchange(volatile u64 *address, u64 exchange, u64 comparand)
+{
+	return static_cast<u64>(_InterlockedCompareExchange64(reinterpret_cast<volatile __int64*>(address), static_cast<__int64>(exchange), static_cast<__int64>(comparand)));
+}
+
+//The other 64 bit interlocked intrinsics only exist on x64 so build them from compare exchange
+inline void AtomicStoreRelease(volatile u64 *address, u64 value)
+{
+	u64 current = AtomicLoadAcquire(address);
+	u64 previous;
+	while ((previous = AtomicCompareExchange(address, value, current)) != current)
+	{
+		current = previous;
+	}
+}
+
+inline u32 AtomicFetchAdd(volatile u32 *address, u32 value)
+{
+	return static_cast<u32>(_InterlockedExchangeAdd(reinterpret_cast<volatile long*>(address), static_cast<long>(value)));
+}
+
+inline u64 AtomicFetchAdd(volatile u64 *address, u64 value)
+{
+	u64 current = AtomicLoadAcquire(address);
+	u64 previous;
+	while ((previous = AtomicCompareExchange(address, current + value, current)) != current)
+	{
+		current = previous;
+	}
+	return current;
+}
+
+inline u32 AtomicExchange(volatile u32 *address, u32 value)
+{
+	return static_cast<u32>(_InterlockedExchange(reinterpret_cast<volatile long*>(address), static_cast<long>(value)));
+}
+
+//Returns the value that was in address before the call, the swap happened if that equals comparand
+inline u32 AtomicCompareExchange(volatile u32 *address, u32 exchange, u32 comparand)
+{
+	return static_cast<u32>(_InterlockedCompareExchange(reinterpret_cast<volatile long*>(address), static_cast<long>(exchange), static_cast<long>(comparand)));
+}
+
+inline void* AtomicCompareExchangePointer(void *volatile *address, void *exchange, void *comparand)
+{
+#ifdef _WIN64
+	return _InterlockedCompareExchangePointer(address, exchange, comparand);
+#else
+	return reinterpret_cast<void*>(_InterlockedCompareExchange(reinterpret_cast<volatile long*>(address), reinterpret_cast<long>(exchange), reinterpret_cast<long>(comparand)));
+#endif
+}
+
+inline void* AtomicLoadAcquirePointer(void *const volatile *address)
+{
+	void *value = *address;
+	_ReadWriteBarrier();
+	return value;
+}
+
+inline void AtomicThreadFence()
+{
+	_ReadWriteBarrier();
+	_mm_mfence();
+}
+
+#elif defined(__GNUC__)
+
+inline u32 AtomicLoadAcquire(const volatile u32 *address)
+{
+	return __atomic_load_n(address, __ATOMIC_ACQUIRE);
+}
+
+inline void AtomicStoreRelease(volatile u32 *address, u32 value)
+{
+	__atomic_store_n(address, value, __ATOMIC_RELEASE);
+}
+
+inline u64 AtomicLoadAcquire(const volatile u64 *address)
+{
+	return __atomic_load_n(address, __ATOMIC_ACQUIRE);
+}
+
+inline void AtomicStoreRelease(volatile u64 *address, u64 value)
+{
+	__atomic_store_n(address, value, __ATOMIC_RELEASE);
+}
+
+inline u32 AtomicFetchAdd(volatile u32 *address, u32 value)
+{
+	return __atomic_fetch_add(address, value, __ATOMIC_SEQ_CST);
+}
+
+inline u64 AtomicFetchAdd(volatile u64 *address, u64 value)
+{
+	return __atomic_fetch_add(address, value, __ATOMIC_SEQ_CST);
+}
+
+inline u32 AtomicExchange(volatile u32 *address, u32 value)
+{
+	return __atomic_exchange_n(address, value, __ATOMIC_SEQ_CST);
+}
+
+//Returns the value that was in address before the call, the swap happened if that equals comparand
+inline u32 AtomicCompareExchange(volatile u32 *address, u32 exchange, u32 comparand)
+{
+	__atomic_compare_exchange_n(address, &comparand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return comparand;
+}
+
+inline u64 AtomicCompareExchange(volatile u64 *address, u64 exchange, u64 comparand)
+{
+	__atomic_compare_exchange_n(address, &comparand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return comparand;
+}
+
+inline void* AtomicCompareExchangePointer(void *volatile *address, void *exchange, void *comparand)
+{
+	__atomic_compare_exchange_n(address, &comparand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return comparand;
+}
+
+inline void* AtomicLoadAcquirePointer(void *const volatile *address)
+{
+	return __atomic_load_n(address, __ATOMIC_ACQUIRE);
+}
+
+inline void AtomicThreadFence()
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#endif
+
+}
+#endif
@@ -0,0 +1,197 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: BoundedQueue
+ *Description: Fixed capacity lock free queue, any number of threads can push and pop.
+ *Each slot carries a sequence number that says whose turn it is.
+ *Author: jkeon
+ **********************************/
+
+#ifndef _BOUNDEDQUEUE_H_
+#define _BOUNDEDQUEUE_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/thread/Atomic.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	template <typename T>
+	class BoundedQueue {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//Capacity is rounded up to a power of two
+		BoundedQueue(u32 capacity)
+		:m_enqueuePosition(0), m_dequeuePosition(0)
+		{
+			m_capacity = 2;
+			while (m_capacity < capacity)
+			{
+				m_capacity <<= 1;
+			}
+			m_mask = m_capacity - 1;
+
+			p_slots = new Slot[m_capacity];
+			for (u32 i = 0; i < m_capacity; i++)
+			{
+				p_slots[i].sequence = i;
+			}
+		}
+
+		~BoundedQueue()
+		{
+			delete[] p_slots;
+		}
+
+		//Returns false if the queue is full
+		bool TryPush(const T &value)
+		{
+			u32 position = AtomicLoadAcquire(&m_enqueuePosition);
+			Slot *slot;
+			for (;;)
+			{
+				slot = &p_slots[position & m_mask];
+				i32 difference = static_cast<i32>(AtomicLoadAcquire(&slot->sequence) - position);
+				if (difference == 0)
+				{
+					u32 previous = AtomicCompareExchange(&m_enqueuePosition, position + 1, position);
+					if (previous == position)
+					{
+						break;
+					}
+					position = previous;
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = AtomicLoadAcquire(&m_enqueuePosition);
+				}
+			}
+
+			slot->value = value;
+			AtomicStoreRelease(&slot->sequence, position + 1);
+			return true;
+		}
+
+		//Returns false if the queue is empty
+		bool TryPop(T &value)
+		{
+			u32 position = AtomicLoadAcquire(&m_dequeuePosition);
+			Slot *slot;
+			for (;;)
+			{
+				slot = &p_slots[position & m_mask];
+				i32 difference = static_cast<i32>(AtomicLoadAcquire(&slot->sequence) - (position + 1));
+				if (difference == 0)
+				{
+					u32 previous = AtomicCompareExchange(&m_dequeuePosition, position + 1, position);
+					if (previous == position)
+					{
+						break;
+					}
+					position = previous;
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = AtomicLoadAcquire(&m_dequeuePosition);
+				}
+			}
+
+			value = slot->value;
+			//Hand the slot to the producer that claims it a lap from now
+			AtomicStoreRelease(&slot->sequence, position + m_capacity);
+			return true;
+		}
+
+		//Only a snapshot while other threads are pushing and popping
+		bool IsEmpty()
+		{
+			return AtomicLoadAcquire(&m_enqueuePosition) == AtomicLoadAcquire(&m_dequeuePosition);
+		}
+
+		//Counts every successful push since construction and wraps. Positions are claimed in order, so anything
+		//pushed before the call sits below it.
+		u32 GetEnqueuePosition()
+		{
+			return AtomicLoadAcquire(&m_enqueuePosition);
+		}
+
+		u32 GetCapacity()
+		{
+			return m_capacity;
+		}
+
+	//PRIVATE FUNCTIONS
+	private:
+		BoundedQueue(const BoundedQueue &other);
+		BoundedQueue& operator = (const BoundedQueue &other);
+
+	//PRIVATE VARIABLES
+	private:
+		struct Slot
+		{
+			volatile u32 sequence;
+			T value;
+		};
+
+		Slot *p_slots;
+		u32 m_capacity;
+		u32 m_mask;
+
+		//Kept on separate cache lines so producers and consumers don't fight over one
+		volatile u32 m_enqueuePosition;
+		u8 m_padding[60];
+		volatile u32 m_dequeuePosition;
+
+	};
+}
+#endif
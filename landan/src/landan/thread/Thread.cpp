@@ -0,0 +1,196 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "Thread.h"
+#include <landan/profile/Profiler.h>
+#include <landan/thread/Atomic.h>
+#include <landan/util/DebugUtil.h>
+
+#ifndef _WIN32
+	#include <sched.h>
+	#include <time.h>
+	#include <unistd.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	volatile u32 Thread::NEXT_ID = 1;
+	LANDAN_THREAD_LOCAL u32 Thread::CURRENT_ID = 0;
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	Thread::Thread(Function<void ()> entry)
+	:m_entry(entry), m_started(false)
+	{
+
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	Thread::~Thread()
+	{
+		Join();
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+	bool Thread::Start()
+	{
+		if (m_started || !m_entry)
+		{
+			return false;
+		}
+		m_handle = CreateThread(0, 0, &Thread::Run, this, 0, 0);
+		m_started = (m_handle != 0);
+		return m_started;
+	}
+
+	void Thread::Join()
+	{
+		if (m_started)
+		{
+			WaitForSingleObject(m_handle, INFINITE);
+			CloseHandle(m_handle);
+			m_started = false;
+		}
+	}
+
+	DWORD WINAPI Thread::Run(LPVOID thread)
+	{
+		static_cast<Thread*>(thread)->m_entry();
+		Profiler::ReleaseThread();
+		DebugUtil::ReleaseThread();
+		return 0;
+	}
+
+	void Thread::SleepFor(u32 milliSeconds)
+	{
+		Sleep(milliSeconds);
+	}
+
+	void Thread::YieldThread()
+	{
+		SwitchToThread();
+	}
+
+	u32 Thread::GetProcessorCount()
+	{
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return static_cast<u32>(info.dwNumberOfProcessors);
+	}
+#else
+	bool Thread::Start()
+	{
+		if (m_started || !m_entry)
+		{
+			return false;
+		}
+		m_started = (pthread_create(&m_handle, 0, &Thread::Run, this) == 0);
+		return m_started;
+	}
+
+	void Thread::Join()
+	{
+		if (m_started)
+		{
+			pthread_join(m_handle, 0);
+			m_started = false;
+		}
+	}
+
+	void* Thread::Run(void *thread)
+	{
+		static_cast<Thread*>(thread)->m_entry();
+		Profiler::ReleaseThread();
+		DebugUtil::ReleaseThread();
+		return 0;
+	}
+
+	void Thread::SleepFor(u32 milliSeconds)
+	{
+		timespec ts;
+		ts.tv_sec = milliSeconds / 1000;
+		ts.tv_nsec = static_cast<long>(milliSeconds % 1000) * 1000000L;
+		nanosleep(&ts, 0);
+	}
+
+	void Thread::YieldThread()
+	{
+		sched_yield();
+	}
+
+	u32 Thread::GetProcessorCount()
+	{
+		long count = sysconf(_SC_NPROCESSORS_ONLN);
+		return (count > 0) ? static_cast<u32>(count) : 1;
+	}
+#endif
+
+	u32 Thread::GetCurrentId()
+	{
+		if (CURRENT_ID == 0)
+		{
+			CURRENT_ID = AtomicFetchAdd(&NEXT_ID, 1);
+		}
+		return CURRENT_ID;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool Thread::IsStarted()
+	{
+		return m_started;
+	}
+
+}
@@ -0,0 +1,112 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: Thread
+*Description: Minimal native thread wrapper that runs a landan::Function.
+*Author: jkeon
+**********************************/
+
+#ifndef _THREAD_H_
+#define _THREAD_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <landan/core/LandanTypes.h>
+#include <landan/util/Function.h>
+#include <landan/thread/ThreadLocal.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class Thread {
+
+	//PUBLIC FUNCTIONS
+	public:
+		Thread(Function<void ()> entry);
+		//Joins if the thread is still running
+		~Thread();
+
+		bool Start();
+		void Join();
+		bool IsStarted();
+
+		static void SleepFor(u32 milliSeconds);
+		static void YieldThread();
+		static u32 GetProcessorCount();
+		//Small sequential ID handed out the first time a thread asks, starting at 1
+		static u32 GetCurrentId();
+
+	//PRIVATE FUNCTIONS
+	private:
+		Thread(const Thread &other);
+		Thread& operator = (const Thread &other);
+
+#ifdef _WIN32
+		static DWORD WINAPI Run(LPVOID thread);
+#else
+		static void* Run(void *thread);
+#endif
+
+	//PRIVATE VARIABLES
+	private:
+		Function<void ()> m_entry;
+		bool m_started;
+
+		static volatile u32 NEXT_ID;
+		static LANDAN_THREAD_LOCAL u32 CURRENT_ID;
+
+#ifdef _WIN32
+		HANDLE m_handle;
+#else
+		pthread_t m_handle;
+#endif
+	
+	};
+}
+#endif
@@ -0,0 +1,177 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "FixedTimeStep.h"
+#include <landan/timer/Timer.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	FixedTimeStep::FixedTimeStep()
+	:m_stepMilliSeconds(0.0f), m_stepTicks(0), m_maxSteps(0), m_accumulatedTicks(0), m_lastTicks(0), m_frameSteps(0)
+	{
+
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	FixedTimeStep::~FixedTimeStep()
+	{
+
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// PUBLIC FUNCTIONS //////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool FixedTimeStep::SetStep(f32 stepMilliSeconds, u32 maxStepsPerFrame)
+	{
+		//Checked before the cast, a negative, NaN or out of range value can't be converted to a u64.
+		//Written so NaN fails too.
+		if (!(stepMilliSeconds > 0.0f) || maxStepsPerFrame == 0)
+		{
+			return false;
+		}
+		//f64 so steps of a frame or more keep their nanoseconds, an f32 only holds 24 bits of them
+		f64 ticks = static_cast<f64>(stepMilliSeconds) * static_cast<f64>(Timer::TICKS_PER_MILLISECOND);
+		if (ticks >= 18446744073709551616.0)
+		{
+			return false;
+		}
+		u64 stepTicks = static_cast<u64>(ticks);
+		if (stepTicks == 0)
+		{
+			return false;
+		}
+
+		m_stepMilliSeconds = stepMilliSeconds;
+		m_stepTicks = stepTicks;
+		m_maxSteps = maxStepsPerFrame;
+		return true;
+	}
+
+	void FixedTimeStep::Reset(u64 currentTicks)
+	{
+		m_accumulatedTicks = m_stepTicks;
+		m_lastTicks = currentTicks;
+		m_frameSteps = 0;
+	}
+
+	void FixedTimeStep::Advance(u64 currentTicks)
+	{
+		m_accumulatedTicks += currentTicks - m_lastTicks;
+		m_lastTicks = currentTicks;
+		m_frameSteps = 0;
+	}
+
+	bool FixedTimeStep::ConsumeStep()
+	{
+		if (m_stepTicks == 0 || m_accumulatedTicks < m_stepTicks || m_frameSteps >= m_maxSteps)
+		{
+			return false;
+		}
+		m_accumulatedTicks -= m_stepTicks;
+		m_frameSteps++;
+		return true;
+	}
+
+	u32 FixedTimeStep::EndFrame()
+	{
+		//Too far behind to catch up, drop the backlog rather than spiral
+		if (m_frameSteps == m_maxSteps && m_stepTicks != 0)
+		{
+			m_accumulatedTicks = m_accumulatedTicks % m_stepTicks;
+		}
+
+		u32 steps = m_frameSteps;
+		m_frameSteps = 0;
+		return steps;
+	}
+
+	u64 FixedTimeStep::GetTicksUntilStep(u64 currentTicks)
+	{
+		u64 accumulatedTicks = m_accumulatedTicks + (currentTicks - m_lastTicks);
+		return (accumulatedTicks < m_stepTicks) ? m_stepTicks - accumulatedTicks : 0;
+	}
+
+	f32 FixedTimeStep::GetInterpolationAlpha()
+	{
+		if (m_stepTicks == 0)
+		{
+			return 1.0f;
+		}
+		//Steps left unconsumed, e.g. by quitting mid frame, would push it past the newest state
+		if (m_accumulatedTicks >= m_stepTicks)
+		{
+			return 1.0f;
+		}
+		return static_cast<f32>(static_cast<f64>(m_accumulatedTicks) / static_cast<f64>(m_stepTicks));
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	f32 FixedTimeStep::GetStepMilliSeconds()
+	{
+		return m_stepMilliSeconds;
+	}
+
+	u64 FixedTimeStep::GetStepTicks()
+	{
+		return m_stepTicks;
+	}
+
+	u32 FixedTimeStep::GetMaxStepsPerFrame()
+	{
+		return m_maxSteps;
+	}
+
+	u64 FixedTimeStep::GetAccumulatedTicks()
+	{
+		return m_accumulatedTicks;
+	}
+
+}
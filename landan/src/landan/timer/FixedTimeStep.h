@@ -0,0 +1,107 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: FixedTimeStep
+*Description: Accumulator behind the FIXED_TIMESTEP loops. Frame time is banked in integer ticks
+*and paid out a step at a time, capped per frame so a slow frame drops its backlog instead of
+*snowballing.
+*Author: jkeon
+**********************************/
+
+#ifndef _FIXEDTIMESTEP_H_
+#define _FIXEDTIMESTEP_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class FixedTimeStep {
+
+	//PUBLIC FUNCTIONS
+	public:
+		FixedTimeStep();
+		~FixedTimeStep();
+
+		//Returns false if either is zero, the accumulator is unusable until this succeeds
+		bool SetStep(f32 stepMilliSeconds, u32 maxStepsPerFrame);
+		//Starts counting from currentTicks with one step already banked so the first frame Updates immediately
+		void Reset(u64 currentTicks);
+
+		//Banks the time since the last Advance or Reset and starts a new frame
+		void Advance(u64 currentTicks);
+		//True while a step is banked and the frame hasn't used up its steps, call once per Update
+		bool ConsumeStep();
+		//Drops the backlog if the frame hit the cap, returns the steps the frame took
+		u32 EndFrame();
+
+		//0 if a step is due at currentTicks, otherwise how long until one is. Doesn't bank anything.
+		u64 GetTicksUntilStep(u64 currentTicks);
+		//How far (0-1) the banked time sits into the next step, 1 while whole steps are still banked
+		f32 GetInterpolationAlpha();
+
+		f32 GetStepMilliSeconds();
+		u64 GetStepTicks();
+		u32 GetMaxStepsPerFrame();
+		u64 GetAccumulatedTicks();
+
+	//PRIVATE FUNCTIONS
+	private:
+		FixedTimeStep(const FixedTimeStep &other);
+		FixedTimeStep& operator = (const FixedTimeStep &other);
+
+	//PRIVATE VARIABLES
+	private:
+		f32 m_stepMilliSeconds;
+		u64 m_stepTicks;
+		u32 m_maxSteps;
+
+		u64 m_accumulatedTicks;
+		u64 m_lastTicks;
+		u32 m_frameSteps;
+
+	};
+}
+#endif
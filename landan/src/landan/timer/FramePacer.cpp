@@ -0,0 +1,230 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "FramePacer.h"
+
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <time.h>
+	#include <errno.h>
+#endif
+
+#include <cmath>
+#include <landan/timer/Timer.h>
+
+//////////////////////////////////////////////////////////////////////
+// MACROS ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+//Tell the CPU we're spinning so it can back off the pipeline and yield to a hyperthread sibling
+#if defined(_WIN32)
+	#define LANDAN_CPU_RELAX() YieldProcessor()
+#elif defined(__i386__) || defined(__x86_64__)
+	#define LANDAN_CPU_RELAX() __builtin_ia32_pause()
+#else
+	#define LANDAN_CPU_RELAX()
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	FramePacer::FramePacer(u64 spinTicks)
+	:m_spinTicks(spinTicks)
+	{
+		ResetStats();
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	FramePacer::~FramePacer()
+	{
+
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	void FramePacer::WaitUntil(u64 deadlineTicks)
+	{
+		u64 startTicks = Timer::GetTicks();
+
+		//Already late, nothing to wait for
+		if (startTicks >= deadlineTicks)
+		{
+			m_missedCount++;
+			return;
+		}
+
+		//Sleep through the coarse part of the wait
+		if (deadlineTicks - startTicks > m_spinTicks)
+		{
+			SleepUntil(deadlineTicks - m_spinTicks);
+		}
+		u64 spinStartTicks = Timer::GetTicks();
+
+		//Spin through whatever is left
+		u64 currentTicks = spinStartTicks;
+		while (currentTicks < deadlineTicks)
+		{
+			LANDAN_CPU_RELAX();
+			currentTicks = Timer::GetTicks();
+		}
+
+		//Track how late we woke up
+		u64 lateness = currentTicks - deadlineTicks;
+		m_waitCount++;
+		m_minLatenessTicks = (lateness < m_minLatenessTicks) ? lateness : m_minLatenessTicks;
+		m_maxLatenessTicks = (lateness > m_maxLatenessTicks) ? lateness : m_maxLatenessTicks;
+		m_latenessSum += static_cast<f64>(lateness);
+		m_latenessSquaredSum += static_cast<f64>(lateness) * static_cast<f64>(lateness);
+		m_totalSleptTicks += (spinStartTicks > startTicks) ? (spinStartTicks - startTicks) : 0;
+		m_totalSpunTicks += currentTicks - spinStartTicks;
+	}
+
+#ifdef _WIN32
+	void FramePacer::SleepUntil(u64 deadlineTicks)
+	{
+		u64 currentTicks = Timer::GetTicks();
+		if (currentTicks < deadlineTicks)
+		{
+			//Sleep() rounds to whole milliseconds, round down so we never oversleep the spin window
+			DWORD milliSeconds = static_cast<DWORD>((deadlineTicks - currentTicks) / Timer::TICKS_PER_MILLISECOND);
+			if (milliSeconds > 0)
+			{
+				Sleep(milliSeconds);
+			}
+		}
+	}
+#else
+	void FramePacer::SleepUntil(u64 deadlineTicks)
+	{
+		//Timer::GetTicks() reads CLOCK_MONOTONIC so the deadline can be handed to the kernel as an absolute time
+		timespec ts;
+		ts.tv_sec = static_cast<time_t>(deadlineTicks / Timer::TICKS_PER_SECOND);
+		ts.tv_nsec = static_cast<long>(deadlineTicks % Timer::TICKS_PER_SECOND);
+
+		//An absolute deadline means a signal interruption can just retry without accumulating error
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0) == EINTR)
+		{
+		}
+	}
+#endif
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	u64 FramePacer::GetSpinTicks()
+	{
+		return m_spinTicks;
+	}
+
+	void FramePacer::SetSpinTicks(u64 spinTicks)
+	{
+		m_spinTicks = spinTicks;
+	}
+
+	u64 FramePacer::GetWaitCount()
+	{
+		return m_waitCount;
+	}
+
+	u64 FramePacer::GetMissedCount()
+	{
+		return m_missedCount;
+	}
+
+	u64 FramePacer::GetMinLatenessTicks()
+	{
+		return (m_waitCount > 0) ? m_minLatenessTicks : 0;
+	}
+
+	u64 FramePacer::GetMaxLatenessTicks()
+	{
+		return m_maxLatenessTicks;
+	}
+
+	f64 FramePacer::GetAverageLatenessTicks()
+	{
+		return (m_waitCount > 0) ? m_latenessSum / static_cast<f64>(m_waitCount) : 0.0;
+	}
+
+	f64 FramePacer::GetJitterTicks()
+	{
+		if (m_waitCount == 0)
+		{
+			return 0.0;
+		}
+		//Standard deviation of the lateness
+		f64 mean = m_latenessSum / static_cast<f64>(m_waitCount);
+		f64 variance = (m_latenessSquaredSum / static_cast<f64>(m_waitCount)) - (mean * mean);
+		return (variance > 0.0) ? std::sqrt(variance) : 0.0;
+	}
+
+	u64 FramePacer::GetTotalSleptTicks()
+	{
+		return m_totalSleptTicks;
+	}
+
+	u64 FramePacer::GetTotalSpunTicks()
+	{
+		return m_totalSpunTicks;
+	}
+
+	void FramePacer::ResetStats()
+	{
+		m_waitCount = 0;
+		m_missedCount = 0;
+		m_minLatenessTicks = ~0ULL;
+		m_maxLatenessTicks = 0;
+		m_latenessSum = 0.0;
+		m_latenessSquaredSum = 0.0;
+		m_totalSleptTicks = 0;
+		m_totalSpunTicks = 0;
+	}
+
+}
@@ -0,0 +1,115 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: FramePacer
+*Description: Waits for frame deadlines by sleeping for the bulk of the wait and
+*spinning only for the last stretch, so limited framerates don't burn a core.
+*Author: jkeon
+**********************************/
+
+#ifndef _FRAMEPACER_H_
+#define _FRAMEPACER_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class FramePacer {
+
+	//PUBLIC FUNCTIONS
+	public:
+		FramePacer(u64 spinTicks = DEFAULT_SPIN_TICKS);
+		~FramePacer();
+
+		//Blocks until Timer::GetTicks() reaches deadlineTicks
+		void WaitUntil(u64 deadlineTicks);
+
+		u64 GetSpinTicks();
+		void SetSpinTicks(u64 spinTicks);
+
+		//Lateness is how far past the deadline we actually woke up, the spread of it is the pacing jitter
+		u64 GetWaitCount();
+		u64 GetMissedCount();
+		u64 GetMinLatenessTicks();
+		u64 GetMaxLatenessTicks();
+		f64 GetAverageLatenessTicks();
+		f64 GetJitterTicks();
+		u64 GetTotalSleptTicks();
+		u64 GetTotalSpunTicks();
+		void ResetStats();
+
+	//PRIVATE FUNCTIONS
+	private:
+		FramePacer(const FramePacer &other);
+		FramePacer& operator = (const FramePacer &other);
+
+		void SleepUntil(u64 deadlineTicks);
+
+	//PUBLIC VARIABLES
+	public:
+#ifdef _WIN32
+		//Sleep() is only accurate to the scheduler quantum on Windows so spin for longer
+		static const u64 DEFAULT_SPIN_TICKS = 2000000ULL;
+#else
+		static const u64 DEFAULT_SPIN_TICKS = 250000ULL;
+#endif
+
+	//PRIVATE VARIABLES
+	private:
+		u64 m_spinTicks;
+
+		u64 m_waitCount;
+		u64 m_missedCount;
+		u64 m_minLatenessTicks;
+		u64 m_maxLatenessTicks;
+		f64 m_latenessSum;
+		f64 m_latenessSquaredSum;
+		u64 m_totalSleptTicks;
+		u64 m_totalSpunTicks;
+	
+	};
+}
+#endif
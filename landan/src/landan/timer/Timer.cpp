@@ -38,6 +38,8 @@ or implied, of Karman Interactive Ltd.
 
 #ifdef _WIN32
 	#include <Windows.h>
+#else
+	#include <time.h>
 #endif
 
 #include <landan/util/DebugUtil.h>
@@ -55,6 +57,7 @@ namespace landan {
 	f64 Timer::RCP_FREQUENCY_SECONDS = 0.0;
 	f64 Timer::RCP_FREQUENCY_MILLISECONDS = 0.0;
 	f64 Timer::RCP_FREQUENCY_MICROSECONDS = 0.0;
+	u64 Timer::FREQUENCY = 1;
 
 #ifdef _WIN32
 	void Timer::Init()
@@ -70,6 +73,7 @@ namespace landan {
 			Timer::RCP_FREQUENCY_SECONDS = 1.0/denom;
 			Timer::RCP_FREQUENCY_MILLISECONDS = 1.0/denom*1000.0;
 			Timer::RCP_FREQUENCY_MICROSECONDS = 1.0/denom*1000000.0;
+			Timer::FREQUENCY = static_cast<u64>(li.QuadPart);
 		}
 	}
 
@@ -93,31 +97,80 @@ namespace landan {
 		QueryPerformanceCounter(&li);
 		return static_cast<f64>(li.QuadPart)*Timer::RCP_FREQUENCY_MICROSECONDS;
 	}
+
+	u64 Timer::GetTicks()
+	{
+		LARGE_INTEGER li;
+		QueryPerformanceCounter(&li);
+		u64 counter = static_cast<u64>(li.QuadPart);
+
+		//Split into whole seconds and remainder so the multiply by a billion can't overflow
+		u64 seconds = counter / Timer::FREQUENCY;
+		u64 remainder = counter % Timer::FREQUENCY;
+		return (seconds * TICKS_PER_SECOND) + ((remainder * TICKS_PER_SECOND) / Timer::FREQUENCY);
+	}
 #else
 	void Timer::Init()
 	{
-		//TODO: Implement for other platforms
+		//CLOCK_MONOTONIC is unaffected by wall clock changes and is vDSO backed on Linux so it never enters the kernel
+		timespec ts;
+		if (clock_getres(CLOCK_MONOTONIC, &ts) != 0)
+		{
+			LOG_ERROR("Unable to Query Monotonic Clock Resolution");
+		}
+		else
+		{
+			Timer::RCP_FREQUENCY_SECONDS = 1.0/static_cast<f64>(TICKS_PER_SECOND);
+			Timer::RCP_FREQUENCY_MILLISECONDS = 1.0/static_cast<f64>(TICKS_PER_MILLISECOND);
+			Timer::RCP_FREQUENCY_MICROSECONDS = 1.0/static_cast<f64>(TICKS_PER_MICROSECOND);
+			Timer::FREQUENCY = TICKS_PER_SECOND;
+		}
 	}
 
 	f64 Timer::GetSeconds()
 	{
-		//TODO: Implement for other platforms
-		return 0.0;
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<f64>(ts.tv_sec) + static_cast<f64>(ts.tv_nsec)*1.0e-9;
 	}
 
 	f64 Timer::GetMilliSeconds()
 	{
-		//TODO: Implement for other platforms
-		return 0.0;
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<f64>(ts.tv_sec)*1000.0 + static_cast<f64>(ts.tv_nsec)*1.0e-6;
 	}
 
 	f64 Timer::GetMicroSeconds()
 	{
-		//TODO: Implement for other platforms
-		return 0.0;
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<f64>(ts.tv_sec)*1000000.0 + static_cast<f64>(ts.tv_nsec)*1.0e-3;
+	}
+
+	u64 Timer::GetTicks()
+	{
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<u64>(ts.tv_sec)*TICKS_PER_SECOND + static_cast<u64>(ts.tv_nsec);
 	}
 #endif
 
+	f64 Timer::TicksToSeconds(u64 ticks)
+	{
+		return static_cast<f64>(ticks)*1.0e-9;
+	}
+
+	f64 Timer::TicksToMilliSeconds(u64 ticks)
+	{
+		return static_cast<f64>(ticks)*1.0e-6;
+	}
+
+	f64 Timer::TicksToMicroSeconds(u64 ticks)
+	{
+		return static_cast<f64>(ticks)*1.0e-3;
+	}
+
 	//////////////////////////////////////////////////////////////////////
 	// CONSTRUCTORS //////////////////////////////////////////////////////
 	//////////////////////////////////////////////////////////////////////
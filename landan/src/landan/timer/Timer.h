@@ -67,6 +67,13 @@ namespace landan {
 		static f64 GetMilliSeconds();
 		static f64 GetMicroSeconds();
 
+		//Monotonic nanosecond count. Prefer this in hot loops, it stays exact over long uptimes.
+		static u64 GetTicks();
+
+		static f64 TicksToSeconds(u64 ticks);
+		static f64 TicksToMilliSeconds(u64 ticks);
+		static f64 TicksToMicroSeconds(u64 ticks);
+
 		static void Init();
 
 	//PRIVATE FUNCTIONS
@@ -79,6 +86,13 @@ namespace landan {
 		static f64 RCP_FREQUENCY_SECONDS;
 		static f64 RCP_FREQUENCY_MILLISECONDS;
 		static f64 RCP_FREQUENCY_MICROSECONDS;
+		static u64 FREQUENCY;
+
+	//PUBLIC VARIABLES
+	public:
+		static const u64 TICKS_PER_SECOND = 1000000000ULL;
+		static const u64 TICKS_PER_MILLISECOND = 1000000ULL;
+		static const u64 TICKS_PER_MICROSECOND = 1000ULL;
 	
 	};
 }
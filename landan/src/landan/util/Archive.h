@@ -0,0 +1,353 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: BasicWriteArchive, BasicReadArchive
+*Description: Template based serialization into a ByteArray. A type lists its fields once with
+*LANDAN_SERIALIZE and the same function both writes and reads it, so encoders and decoders can't
+*drift apart. Everything is resolved at compile time, there are no virtual calls.
+*Author: jkeon
+**********************************/
+
+#ifndef _ARCHIVE_H_
+#define _ARCHIVE_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/util/ByteArray.h>
+#include <landan/util/ByteStream.h>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Appends to the array at its position in a fixed byte order.
+	 */
+	template<endian::ENDIAN_TYPE ENDIANESS>
+	class BasicWriteArchive {
+
+	//PUBLIC FUNCTIONS
+	public:
+		explicit BasicWriteArchive(ByteArray &bytes)
+		:m_writer(bytes)
+		{
+
+		}
+
+		ByteArray& GetByteArray() { return m_writer.GetByteArray(); }
+		bool HasError() { return m_writer.HasError(); }
+
+		void Value(u8 &value) { m_writer.WriteUInt8(value); }
+		void Value(u16 &value) { m_writer.WriteUInt16(value); }
+		void Value(u32 &value) { m_writer.WriteUInt32(value); }
+		void Value(u64 &value) { m_writer.WriteUInt64(value); }
+		void Value(i8 &value) { m_writer.WriteInt8(value); }
+		void Value(i16 &value) { m_writer.WriteInt16(value); }
+		void Value(i32 &value) { m_writer.WriteInt32(value); }
+		void Value(i64 &value) { m_writer.WriteInt64(value); }
+		void Value(f32 &value) { m_writer.WriteFloat32(value); }
+		void Value(f64 &value) { m_writer.WriteFloat64(value); }
+		void Value(bool &value) { m_writer.WriteUInt8(value ? 1 : 0); }
+		void Value(string &value) { m_writer.WriteString(value); }
+		//Enums and any other integer type the overloads above don't name
+		template<typename T>
+		void Value(T &value) { m_writer.WriteArray(&value, 1); }
+
+		template<typename T>
+		void Array(T *values, u32 count) { m_writer.WriteArray(values, count); }
+
+		//Element counts of containers, as varints
+		void Count(u32 &count) { m_writer.WriteVarUInt32(count); }
+
+	//PRIVATE FUNCTIONS
+	private:
+		BasicWriteArchive(const BasicWriteArchive &other);
+		BasicWriteArchive& operator = (const BasicWriteArchive &other);
+
+	//PUBLIC VARIABLES
+	public:
+		static const bool IS_READING = false;
+
+	//PRIVATE VARIABLES
+	private:
+		BasicByteWriter<ENDIANESS> m_writer;
+
+	};
+
+	/**
+	 * Reads from the array's position. Once anything fails the remaining values read as zero and
+	 * HasError is set, check it once at the end.
+	 */
+	template<endian::ENDIAN_TYPE ENDIANESS>
+	class BasicReadArchive {
+
+	//PUBLIC FUNCTIONS
+	public:
+		explicit BasicReadArchive(ByteArray &bytes)
+		:m_reader(bytes), m_error(false)
+		{
+
+		}
+
+		ByteArray& GetByteArray() { return m_reader.GetByteArray(); }
+		bool HasError() { return m_error || m_reader.HasError(); }
+
+		void Value(u8 &value) { value = m_reader.ReadUInt8(); }
+		void Value(u16 &value) { value = m_reader.ReadUInt16(); }
+		void Value(u32 &value) { value = m_reader.ReadUInt32(); }
+		void Value(u64 &value) { value = m_reader.ReadUInt64(); }
+		void Value(i8 &value) { value = m_reader.ReadInt8(); }
+		void Value(i16 &value) { value = m_reader.ReadInt16(); }
+		void Value(i32 &value) { value = m_reader.ReadInt32(); }
+		void Value(i64 &value) { value = m_reader.ReadInt64(); }
+		void Value(f32 &value) { value = m_reader.ReadFloat32(); }
+		void Value(f64 &value) { value = m_reader.ReadFloat64(); }
+		void Value(bool &value) { value = (m_reader.ReadUInt8() != 0); }
+		void Value(string &value) { value = m_reader.ReadString(); }
+		template<typename T>
+		void Value(T &value)
+		{
+			if (!m_reader.ReadArray(&value, 1))
+			{
+				memset(&value, 0, sizeof(T));
+			}
+		}
+
+		template<typename T>
+		void Array(T *values, u32 count)
+		{
+			if (!m_reader.ReadArray(values, count))
+			{
+				memset(values, 0, sizeof(T) * count);
+			}
+		}
+
+		//Every element takes at least a byte, so a count bigger than what's left is corrupt and
+		//reads as 0 instead of letting a bad length allocate gigabytes
+		void Count(u32 &count)
+		{
+			count = m_reader.ReadVarUInt32();
+			ByteArray &bytes = m_reader.GetByteArray();
+			u32 remaining = (bytes.GetPosition() < bytes.GetLength()) ? bytes.GetLength() - bytes.GetPosition() : 0;
+			if (count > remaining)
+			{
+				m_error = true;
+				count = 0;
+			}
+		}
+
+	//PRIVATE FUNCTIONS
+	private:
+		BasicReadArchive(const BasicReadArchive &other);
+		BasicReadArchive& operator = (const BasicReadArchive &other);
+
+	//PUBLIC VARIABLES
+	public:
+		static const bool IS_READING = true;
+
+	//PRIVATE VARIABLES
+	private:
+		BasicByteReader<ENDIANESS> m_reader;
+		bool m_error;
+
+	};
+
+	//Little endian like everything else Landan writes to disk or the network
+	typedef BasicWriteArchive<endian::LITTLE_ENDIAN> WriteArchive;
+	typedef BasicReadArchive<endian::LITTLE_ENDIAN> ReadArchive;
+
+	//////////////////////////////////////////////////////////////////////
+	// SERIALIZE /////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	//Integers, floats and enums of 1, 2, 4 or 8 bytes are copied whole, arrays of them in one
+	//memcpy or byte swap pass. bool isn't, any byte but 0 or 1 would be undefined.
+	template<typename T>
+	struct IsBitwiseSerializable
+	{
+		static const bool VALUE = (std::is_arithmetic<T>::value || std::is_enum<T>::value)
+			&& !std::is_same<T, bool>::value
+			&& (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+	};
+
+	//Everything is declared up front so the templates below see every overload, types in other
+	//namespaces can add their own Serialize(Archive&, T&) next to the type and it's found by ADL
+	template<typename ARCHIVE, typename T> void Serialize(ARCHIVE &archive, T &value);
+	template<typename ARCHIVE> void Serialize(ARCHIVE &archive, bool &value);
+	template<typename ARCHIVE> void Serialize(ARCHIVE &archive, string &value);
+	template<typename ARCHIVE, typename T> void Serialize(ARCHIVE &archive, std::vector<T> &values);
+	template<typename ARCHIVE> void Serialize(ARCHIVE &archive, std::vector<bool> &values);
+	template<typename ARCHIVE, typename T, size_t N> void Serialize(ARCHIVE &archive, T (&values)[N]);
+
+	template<typename T, bool BITWISE = IsBitwiseSerializable<T>::VALUE>
+	struct SerializeTraits
+	{
+		template<typename ARCHIVE>
+		static void One(ARCHIVE &archive, T &value) { value.Serialize(archive); }
+
+		template<typename ARCHIVE>
+		static void Many(ARCHIVE &archive, T *values, u32 count)
+		{
+			for (u32 i = 0; i < count; i++)
+			{
+				Serialize(archive, values[i]);
+			}
+		}
+	};
+
+	template<typename T>
+	struct SerializeTraits<T, true>
+	{
+		template<typename ARCHIVE>
+		static void One(ARCHIVE &archive, T &value) { archive.Value(value); }
+
+		template<typename ARCHIVE>
+		static void Many(ARCHIVE &archive, T *values, u32 count) { archive.Array(values, count); }
+	};
+
+	//Anything with a Serialize member, usually from LANDAN_SERIALIZE, or a bitwise type
+	template<typename ARCHIVE, typename T>
+	void Serialize(ARCHIVE &archive, T &value)
+	{
+		SerializeTraits<T>::One(archive, value);
+	}
+
+	template<typename ARCHIVE>
+	void Serialize(ARCHIVE &archive, bool &value)
+	{
+		archive.Value(value);
+	}
+
+	template<typename ARCHIVE>
+	void Serialize(ARCHIVE &archive, string &value)
+	{
+		archive.Value(value);
+	}
+
+	//Element count as a varint, then the elements
+	template<typename ARCHIVE, typename T>
+	void Serialize(ARCHIVE &archive, std::vector<T> &values)
+	{
+		u32 count = static_cast<u32>(values.size());
+		archive.Count(count);
+		values.resize(count);
+		if (count > 0)
+		{
+			SerializeTraits<T>::Many(archive, &values[0], count);
+		}
+	}
+
+	template<typename ARCHIVE>
+	void Serialize(ARCHIVE &archive, std::vector<bool> &values)
+	{
+		u32 count = static_cast<u32>(values.size());
+		archive.Count(count);
+		values.resize(count);
+		for (u32 i = 0; i < count; i++)
+		{
+			bool value = values[i];
+			archive.Value(value);
+			values[i] = value;
+		}
+	}
+
+	//Fixed size arrays have no count
+	template<typename ARCHIVE, typename T, size_t N>
+	void Serialize(ARCHIVE &archive, T (&values)[N])
+	{
+		SerializeTraits<T>::Many(archive, values, static_cast<u32>(N));
+	}
+
+	//What LANDAN_FIELD calls. Inside a Serialize member an unqualified Serialize would only find the
+	//member itself, from here it finds the overloads above and any the field's namespace has.
+	template<typename ARCHIVE, typename T>
+	void SerializeField(ARCHIVE &archive, T &field)
+	{
+		Serialize(archive, field);
+	}
+
+	//Writes value at the array's position
+	template<typename T>
+	void WriteObject(ByteArray &bytes, const T &value)
+	{
+		WriteArchive archive(bytes);
+		Serialize(archive, const_cast<T&>(value));
+	}
+
+	//Returns false if the data ran out or was malformed
+	template<typename T>
+	bool ReadObject(ByteArray &bytes, T &value)
+	{
+		ReadArchive archive(bytes);
+		Serialize(archive, value);
+		return !archive.HasError();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// MACROS ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+//Declares the fields of a struct or class, in order, for both directions:
+//
+//	struct Snapshot
+//	{
+//		u32 frame;
+//		std::vector<Entity> entities;
+//
+//		LANDAN_SERIALIZE(LANDAN_FIELD(frame) LANDAN_FIELD(entities))
+//	};
+#define LANDAN_SERIALIZE(fields) \
+	template<typename LANDAN_ARCHIVE> \
+	void Serialize(LANDAN_ARCHIVE &archive) \
+	{ \
+		fields \
+	}
+
+#define LANDAN_FIELD(field) ::landan::SerializeField(archive, field);
+
+#endif
@@ -0,0 +1,242 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "AsyncLogger.h"
+
+#include <cstring>
+#include <sstream>
+#include <landan/thread/Atomic.h>
+#include <landan/thread/Thread.h>
+#include <landan/util/DebugUtil.h>
+#include <landan/util/LogRecord.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	AsyncLogger::AsyncLogger(Function<void (const char*, u32)> sink, u32 capacity, logging::OVERFLOW_POLICY policy)
+	:m_sink(sink), m_policy(policy), m_records(capacity), m_writtenCount(0), m_droppedCount(0), m_reportedDroppedCount(0), m_running(0), p_writer(0)
+	{
+		p_batch = new char[BATCH_SIZE * RECORD_SIZE];
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	AsyncLogger::~AsyncLogger()
+	{
+		Stop();
+
+		if (p_batch != 0)
+		{
+			delete[] p_batch;
+			p_batch = 0;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool AsyncLogger::Start()
+	{
+		if (p_writer != 0)
+		{
+			return false;
+		}
+		AtomicStoreRelease(&m_running, 1);
+		p_writer = new Thread(MEMBER_FUNCTION(&AsyncLogger::WriterLoop, this));
+		if (!p_writer->Start())
+		{
+			delete p_writer;
+			p_writer = 0;
+			AtomicStoreRelease(&m_running, 0);
+			return false;
+		}
+		return true;
+	}
+
+	void AsyncLogger::Stop()
+	{
+		if (p_writer != 0)
+		{
+			AtomicStoreRelease(&m_running, 0);
+			p_writer->Join();
+			delete p_writer;
+			p_writer = 0;
+		}
+
+		//Anything pushed while the writer was winding down
+		while (Drain() > 0)
+		{
+		}
+	}
+
+	void AsyncLogger::SetRenderer(Function<u32 (const char*, u32, char*, u32)> renderer)
+	{
+		m_renderer = renderer;
+	}
+
+	bool AsyncLogger::Push(const char *text, u32 length)
+	{
+		Record record;
+		if (length > RECORD_SIZE)
+		{
+			memcpy(record.text, text, RECORD_SIZE - 4);
+			memcpy(record.text + RECORD_SIZE - 4, "...\n", 4);
+			record.length = RECORD_SIZE;
+		}
+		else
+		{
+			memcpy(record.text, text, length);
+			record.length = length;
+		}
+
+		if (!m_records.TryPush(record))
+		{
+			if (m_policy != logging::BLOCK || p_writer == 0)
+			{
+				AtomicFetchAdd(&m_droppedCount, 1);
+				return false;
+			}
+
+			//Back pressure, wait for the writer to free a slot
+			do
+			{
+				Thread::YieldThread();
+			} while (!m_records.TryPush(record));
+		}
+		return true;
+	}
+
+	void AsyncLogger::Flush()
+	{
+		//Every record pushed before the call has claimed a position below this one, even one whose producer
+		//hasn't finished publishing it yet. The writer drains in position order so it can't pass it early.
+		u32 target = m_records.GetEnqueuePosition();
+		if (p_writer == 0)
+		{
+			while (Drain() > 0)
+			{
+			}
+			return;
+		}
+		while (static_cast<i32>(AtomicLoadAcquire(&m_writtenCount) - target) < 0)
+		{
+			Thread::SleepFor(1);
+		}
+	}
+
+	void AsyncLogger::WriterLoop()
+	{
+		while (AtomicLoadAcquire(&m_running) == 1)
+		{
+			//Only sleep when there was nothing to do, a busy queue gets drained back to back
+			if (Drain() == 0)
+			{
+				Thread::SleepFor(WRITER_SLEEP_MILLISECONDS);
+			}
+		}
+	}
+
+	u32 AsyncLogger::Drain()
+	{
+		//Gather up to a batch of records into one contiguous block so the sink is hit once per batch
+		u32 count = 0;
+		u32 batchLength = 0;
+		Record record;
+		while (count < BATCH_SIZE && m_records.TryPop(record))
+		{
+			if (m_renderer)
+			{
+				batchLength += m_renderer(record.text, record.length, p_batch + batchLength, RECORD_SIZE);
+			}
+			else
+			{
+				memcpy(p_batch + batchLength, record.text, record.length);
+				batchLength += record.length;
+			}
+			count++;
+		}
+
+		if (batchLength > 0)
+		{
+			m_sink(p_batch, batchLength);
+		}
+
+		u64 dropped = AtomicLoadAcquire(&m_droppedCount);
+		if (dropped != m_reportedDroppedCount)
+		{
+			std::ostringstream warning;
+			warning << "WARN [AsyncLogger] - " << (dropped - m_reportedDroppedCount) << " log records dropped\n";
+			string text = warning.str();
+			if (m_renderer)
+			{
+				//Goes out as a record like any other so a framing renderer, e.g. the binary log, frames it too
+				char record[RECORD_SIZE];
+				char rendered[RECORD_SIZE];
+				u32 length = LogRecord::EncodeText(LANDAN_LOG_LEVEL_ERROR, text.c_str(), static_cast<u32>(text.length()), record, RECORD_SIZE);
+				m_sink(rendered, m_renderer(record, length, rendered, RECORD_SIZE));
+			}
+			else
+			{
+				m_sink(text.c_str(), static_cast<u32>(text.length()));
+			}
+			m_reportedDroppedCount = dropped;
+		}
+
+		//Only the writer, or Stop and Flush once it's gone, ever drains so a plain add is enough
+		AtomicStoreRelease(&m_writtenCount, m_writtenCount + count);
+		return count;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	u64 AsyncLogger::GetDroppedCount()
+	{
+		return AtomicLoadAcquire(&m_droppedCount);
+	}
+
+}
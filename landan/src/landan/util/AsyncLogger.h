@@ -0,0 +1,144 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: AsyncLogger
+*Description: Bounded multi producer queue of preformatted log records drained in
+*batches by a background writer thread. Producers never lock or touch I/O.
+*Author: jkeon
+**********************************/
+
+#ifndef _ASYNCLOGGER_H_
+#define _ASYNCLOGGER_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/thread/BoundedQueue.h>
+#include <landan/util/Function.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class Thread;
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace logging
+	{
+		//What a producer does when the queue is full
+		enum OVERFLOW_POLICY
+		{
+			DROP = 0,
+			BLOCK = 1
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class AsyncLogger {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//The sink is only ever called from the writer thread. Capacity is rounded up to a power of two.
+		AsyncLogger(Function<void (const char*, u32)> sink, u32 capacity = 4096, logging::OVERFLOW_POLICY policy = logging::DROP);
+		//Drains what is queued and joins the writer
+		~AsyncLogger();
+
+		bool Start();
+		void Stop();
+
+		//Optional, turns each record into text as it's batched. Returns the rendered length, at most
+		//RECORD_SIZE. Only set this before Start.
+		void SetRenderer(Function<u32 (const char*, u32, char*, u32)> renderer);
+
+		//Returns false if the record was dropped. Text longer than a record is truncated.
+		bool Push(const char *text, u32 length);
+		//Blocks until everything pushed before the call has reached the sink
+		void Flush();
+
+		u64 GetDroppedCount();
+
+	//PRIVATE FUNCTIONS
+	private:
+		AsyncLogger(const AsyncLogger &other);
+		AsyncLogger& operator = (const AsyncLogger &other);
+
+		void WriterLoop();
+		u32 Drain();
+
+	//PUBLIC VARIABLES
+	public:
+		static const u32 RECORD_SIZE = 504;
+		static const u32 BATCH_SIZE = 256;
+		static const u32 WRITER_SLEEP_MILLISECONDS = 2;
+
+	//PRIVATE VARIABLES
+	private:
+		struct Record
+		{
+			u32 length;
+			char text[RECORD_SIZE];
+		};
+
+		Function<void (const char*, u32)> m_sink;
+		Function<u32 (const char*, u32, char*, u32)> m_renderer;
+		logging::OVERFLOW_POLICY m_policy;
+
+		BoundedQueue<Record> m_records;
+		//Records that reached the sink, which is also the queue's dequeue position once they have.
+		//Flush waits for it to catch up with the enqueue position it saw.
+		volatile u32 m_writtenCount;
+		volatile u64 m_droppedCount;
+		u64 m_reportedDroppedCount;
+
+		volatile u32 m_running;
+		Thread *p_writer;
+		char *p_batch;
+	
+	};
+}
+#endif
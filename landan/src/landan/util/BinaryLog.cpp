@@ -0,0 +1,458 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "BinaryLog.h"
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <landan/file/File.h>
+#include <landan/file/FileStream.h>
+#include <landan/timer/Timer.h>
+#include <landan/util/AsyncLogger.h>
+#include <landan/util/ByteArray.h>
+#include <landan/util/ByteStream.h>
+#include <landan/util/DebugUtil.h>
+#include <landan/util/LogRecord.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	//Fixed part of a record frame, from the length up to and including the argument count
+	static const u32 RECORD_FRAME_SIZE = 21;
+
+	static void WriteString(LittleEndianWriter &bytes, const char *text, u32 maxLength)
+	{
+		u32 length = static_cast<u32>(strlen(text));
+		length = (length > maxLength) ? maxLength : length;
+		bytes.WriteUInt16(static_cast<u16>(length));
+		bytes.WriteBytes(reinterpret_cast<const u8*>(text), length);
+	}
+
+	static bool ReadString(ByteArray &bytes, u32 end, string &text)
+	{
+		if (bytes.GetPosition() + 2 > end)
+		{
+			return false;
+		}
+		u32 length = bytes.ReadUInt16();
+		if (bytes.GetPosition() + length > end)
+		{
+			return false;
+		}
+		text.assign(reinterpret_cast<const char*>(bytes.GetRawBytes() + bytes.GetPosition()), length);
+		bytes.SetPosition(bytes.GetPosition() + length);
+		return true;
+	}
+
+	struct DecodedSite
+	{
+		string type;
+		string file;
+		string function;
+		string format;
+		u32 line;
+	};
+
+	static string RotatedPath(const string &path, u32 index)
+	{
+		std::ostringstream stream;
+		stream << path << '.' << index;
+		return stream.str();
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	BinaryLogSink::BinaryLogSink(const string &path, u64 maxFileBytes, u32 maxFiles)
+	:m_path(path), m_maxFileBytes(maxFileBytes), m_maxFiles(maxFiles), m_fileBytes(0), m_rotationCount(0)
+	{
+		p_writer = new FileWriter();
+
+		p_frame = new ByteArray(AsyncLogger::RECORD_SIZE + RECORD_FRAME_SIZE);
+		p_siteFrame = new ByteArray(12 + 4 * (2 + MAX_SITE_STRING_LENGTH));
+
+		p_writtenSites = new u8[LogRecord::MAX_SITES];
+		memset(p_writtenSites, 0, LogRecord::MAX_SITES);
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	BinaryLogSink::~BinaryLogSink()
+	{
+		if (p_writer != 0)
+		{
+			delete p_writer;
+			p_writer = 0;
+		}
+
+		if (p_frame != 0)
+		{
+			delete p_frame;
+			p_frame = 0;
+		}
+
+		if (p_siteFrame != 0)
+		{
+			delete p_siteFrame;
+			p_siteFrame = 0;
+		}
+
+		if (p_writtenSites != 0)
+		{
+			delete[] p_writtenSites;
+			p_writtenSites = 0;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	bool BinaryLogSink::Open()
+	{
+		return StartFile();
+	}
+
+	u32 BinaryLogSink::Frame(const char *record, u32 length, char *out, u32 capacity)
+	{
+		LogRecordHeader header;
+		const char *text = record;
+		u32 textLength = length;
+		if (!LogRecord::DecodeHeader(record, length, header))
+		{
+			//Plain text pushed straight at the logger, stamp it as best we can
+			header.level = 0;
+			header.count = 0;
+			header.siteId = 0;
+			header.threadId = 0;
+			header.ticks = Timer::GetTicks();
+		}
+		else if (header.siteId == 0)
+		{
+			text = LogRecord::DecodeText(record, length, textLength);
+		}
+
+		LittleEndianWriter frame(*p_frame);
+		frame.SetPosition(2);
+		frame.WriteUInt8(logging::FRAME_RECORD);
+		frame.WriteUInt64(header.ticks);
+		frame.WriteUInt8(static_cast<u8>(header.level));
+		frame.WriteUInt32(header.siteId);
+		frame.WriteUInt32(header.threadId);
+
+		if (header.siteId == 0)
+		{
+			frame.WriteUInt8(0);
+			u32 room = capacity - RECORD_FRAME_SIZE - 2;
+			textLength = (textLength > room) ? room : textLength;
+			frame.WriteUInt16(static_cast<u16>(textLength));
+			frame.WriteBytes(reinterpret_cast<const u8*>(text), textLength);
+		}
+		else
+		{
+			LogArgument arguments[LogRecord::MAX_ARGUMENTS];
+			u32 count = LogRecord::DecodeArguments(record, length, arguments, LogRecord::MAX_ARGUMENTS);
+			u32 countPosition = frame.GetPosition();
+			frame.WriteUInt8(0);
+
+			u32 written = 0;
+			for (; written < count; written++)
+			{
+				const LogArgument &argument = arguments[written];
+				u32 size = (argument.type == logging::ARGUMENT_STRING) ? 3 + argument.length : 9;
+				if (frame.GetPosition() + size > capacity)
+				{
+					break;
+				}
+				frame.WriteUInt8(static_cast<u8>(argument.type));
+				if (argument.type == logging::ARGUMENT_STRING)
+				{
+					frame.WriteUInt16(static_cast<u16>(argument.length));
+					frame.WriteBytes(reinterpret_cast<const u8*>(argument.value.s), argument.length);
+				}
+				else
+				{
+					frame.WriteUInt64(argument.value.u);
+				}
+			}
+			p_frame->GetRawBytes()[countPosition] = static_cast<u8>(written);
+		}
+
+		u32 frameLength = frame.GetPosition();
+		frame.SetPosition(0);
+		frame.WriteUInt16(static_cast<u16>(frameLength - 2));
+		memcpy(out, p_frame->GetRawBytes(), frameLength);
+		return frameLength;
+	}
+
+	void BinaryLogSink::Write(const char *batch, u32 length)
+	{
+		if (!p_writer->IsOpen())
+		{
+			return;
+		}
+
+		if (m_fileBytes + length > m_maxFileBytes && m_fileBytes > FILE_HEADER_SIZE)
+		{
+			Rotate();
+		}
+
+		u32 position = 0;
+		while (position + RECORD_FRAME_SIZE <= length)
+		{
+			const u8 *bytes = reinterpret_cast<const u8*>(batch + position);
+			u32 frameLength = bytes[0] | (bytes[1] << 8);
+			if (bytes[2] == logging::FRAME_RECORD)
+			{
+				u32 siteId = bytes[12] | (bytes[13] << 8) | (bytes[14] << 16) | (bytes[15] << 24);
+				if (siteId != 0 && siteId < LogRecord::MAX_SITES && p_writtenSites[siteId] == 0)
+				{
+					WriteSite(siteId);
+				}
+			}
+			position += 2 + frameLength;
+		}
+
+		p_writer->Append(reinterpret_cast<const u8*>(batch), length);
+		p_writer->Flush();
+		m_fileBytes += length;
+	}
+
+	bool BinaryLogSink::StartFile()
+	{
+		if (!p_writer->Open(m_path, file::WRITE))
+		{
+			return false;
+		}
+
+		ByteArray header(FILE_HEADER_SIZE);
+		LittleEndianWriter writer(header);
+		writer.WriteUInt32(MAGIC);
+		writer.WriteUInt16(VERSION);
+		writer.WriteUInt16(0);
+		p_writer->Append(header.GetRawBytes(), FILE_HEADER_SIZE);
+
+		m_fileBytes = FILE_HEADER_SIZE;
+		memset(p_writtenSites, 0, LogRecord::MAX_SITES);
+		return true;
+	}
+
+	void BinaryLogSink::Rotate()
+	{
+		p_writer->Close();
+
+		if (m_maxFiles > 1)
+		{
+			File oldest(RotatedPath(m_path, m_maxFiles - 1));
+			oldest.Remove();
+			for (u32 i = m_maxFiles - 1; i > 1; i--)
+			{
+				File previous(RotatedPath(m_path, i - 1));
+				previous.Rename(RotatedPath(m_path, i));
+			}
+			File current(m_path);
+			current.Rename(RotatedPath(m_path, 1));
+		}
+
+		StartFile();
+		m_rotationCount++;
+	}
+
+	void BinaryLogSink::WriteSite(u32 siteId)
+	{
+		p_writtenSites[siteId] = 1;
+		LogSite *site = LogRecord::GetSite(siteId);
+		if (site == 0)
+		{
+			return;
+		}
+
+		LittleEndianWriter frame(*p_siteFrame);
+		frame.SetPosition(2);
+		frame.WriteUInt8(logging::FRAME_SITE);
+		frame.WriteUInt32(siteId);
+		frame.WriteUInt8(static_cast<u8>(site->level));
+		frame.WriteUInt32(site->line);
+		WriteString(frame, site->type, MAX_SITE_STRING_LENGTH);
+		WriteString(frame, DebugUtil::FileBaseName(site->file), MAX_SITE_STRING_LENGTH);
+		WriteString(frame, site->function, MAX_SITE_STRING_LENGTH);
+		WriteString(frame, site->format, MAX_SITE_STRING_LENGTH);
+
+		u32 frameLength = frame.GetPosition();
+		frame.SetPosition(0);
+		frame.WriteUInt16(static_cast<u16>(frameLength - 2));
+		p_writer->Append(p_siteFrame->GetRawBytes(), frameLength);
+		m_fileBytes += frameLength;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	u32 BinaryLogSink::GetRotationCount()
+	{
+		return m_rotationCount;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	u32 BinaryLogDecoder::Decode(ByteArray &bytes, std::ostream &out)
+	{
+		u32 length = bytes.GetLength();
+		if (length < BinaryLogSink::FILE_HEADER_SIZE)
+		{
+			return 0;
+		}
+
+		bytes.SetEndianess(endian::LITTLE_ENDIAN);
+		bytes.SetPosition(0);
+		if (bytes.ReadUInt32() != BinaryLogSink::MAGIC || bytes.ReadUInt16() != BinaryLogSink::VERSION)
+		{
+			return 0;
+		}
+		bytes.SetPosition(BinaryLogSink::FILE_HEADER_SIZE);
+
+		std::map<u32, DecodedSite> sites;
+		u32 count = 0;
+		while (bytes.GetPosition() + 3 <= length)
+		{
+			u32 frameLength = bytes.ReadUInt16();
+			u32 end = bytes.GetPosition() + frameLength;
+			if (frameLength == 0 || end > length)
+			{
+				break;
+			}
+
+			u8 type = bytes.ReadUInt8();
+			if (type == logging::FRAME_SITE && frameLength >= 10)
+			{
+				u32 siteId = bytes.ReadUInt32();
+				DecodedSite &site = sites[siteId];
+				bytes.ReadUInt8();
+				site.line = bytes.ReadUInt32();
+				ReadString(bytes, end, site.type);
+				ReadString(bytes, end, site.file);
+				ReadString(bytes, end, site.function);
+				ReadString(bytes, end, site.format);
+			}
+			else if (type == logging::FRAME_RECORD && frameLength >= RECORD_FRAME_SIZE - 2)
+			{
+				u64 ticks = bytes.ReadUInt64();
+				bytes.ReadUInt8();
+				u32 siteId = bytes.ReadUInt32();
+				u32 threadId = bytes.ReadUInt32();
+				u32 argumentCount = bytes.ReadUInt8();
+
+				std::ostringstream line;
+				line << '[' << std::fixed << std::setprecision(6) << (static_cast<f64>(ticks) / static_cast<f64>(Timer::TICKS_PER_SECOND)) << "] [T" << threadId << "] ";
+				line.unsetf(std::ios_base::floatfield);
+
+				if (siteId == 0)
+				{
+					string text;
+					ReadString(bytes, end, text);
+					line << text;
+					if (text.empty() || text[text.length() - 1] != '\n')
+					{
+						line << '\n';
+					}
+				}
+				else
+				{
+					std::map<u32, DecodedSite>::iterator site = sites.find(siteId);
+					if (site == sites.end())
+					{
+						line << "UNKNOWN [site " << siteId << "] - \n";
+					}
+					else
+					{
+						LogArgument arguments[LogRecord::MAX_ARGUMENTS];
+						u32 decoded = 0;
+						while (decoded < argumentCount && decoded < LogRecord::MAX_ARGUMENTS && bytes.GetPosition() < end)
+						{
+							LogArgument &argument = arguments[decoded];
+							argument.type = static_cast<logging::ARGUMENT_TYPE>(bytes.ReadUInt8());
+							if (argument.type == logging::ARGUMENT_STRING)
+							{
+								argument.length = bytes.ReadUInt16();
+								if (bytes.GetPosition() + argument.length > end)
+								{
+									break;
+								}
+								argument.value.s = reinterpret_cast<const char*>(bytes.GetRawBytes() + bytes.GetPosition());
+								bytes.SetPosition(bytes.GetPosition() + argument.length);
+							}
+							else
+							{
+								if (bytes.GetPosition() + 8 > end)
+								{
+									break;
+								}
+								argument.length = 8;
+								argument.value.u = bytes.ReadUInt64();
+							}
+							decoded++;
+						}
+
+						DebugUtil::PrepLogStream(line, site->second.type.c_str(), site->second.file.c_str(), site->second.function.c_str(), site->second.line);
+						LogRecord::WriteFormatted(line, site->second.format.c_str(), arguments, decoded);
+						line << '\n';
+					}
+				}
+
+				out << line.str();
+				count++;
+			}
+
+			bytes.SetPosition(end);
+		}
+		return count;
+	}
+
+}
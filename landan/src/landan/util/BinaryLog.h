@@ -0,0 +1,152 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: BinaryLogSink, BinaryLogDecoder
+*Description: Compact binary log files. The sink frames queued log records without
+*formatting them and writes them to a rotating file, the decoder turns a file back into text.
+*Author: jkeon
+**********************************/
+
+#ifndef _BINARYLOG_H_
+#define _BINARYLOG_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <iosfwd>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class ByteArray;
+	class FileWriter;
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace logging
+	{
+		//Every frame is a little endian u16 length, then one of these, then the body
+		enum FRAME_TYPE
+		{
+			//u64 ticks, u8 level, u32 site ID, u32 thread ID, u8 argument count, arguments or text
+			FRAME_RECORD = 0,
+			//u32 site ID, u8 level, u32 line, then type, file, function and format strings
+			FRAME_SITE = 1
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class BinaryLogSink {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//Once the file passes maxFileBytes it's renamed to path.1 (path.1 to path.2 and so on) and a
+		//new one is started, keeping at most maxFiles files.
+		BinaryLogSink(const string &path, u64 maxFileBytes = 64 * 1024 * 1024, u32 maxFiles = 4);
+		~BinaryLogSink();
+
+		bool Open();
+
+		//AsyncLogger renderer, frames one queued record
+		u32 Frame(const char *record, u32 length, char *out, u32 capacity);
+		//AsyncLogger sink. Each file is self contained, so sites the current file hasn't seen yet
+		//are written ahead of the batch.
+		void Write(const char *batch, u32 length);
+
+		u32 GetRotationCount();
+
+	//PRIVATE FUNCTIONS
+	private:
+		BinaryLogSink(const BinaryLogSink &other);
+		BinaryLogSink& operator = (const BinaryLogSink &other);
+
+		bool StartFile();
+		void Rotate();
+		void WriteSite(u32 siteId);
+
+	//PUBLIC VARIABLES
+	public:
+		//"LLOG" followed by a u16 version and a u16 of reserved space
+		static const u32 MAGIC = 0x474F4C4C;
+		static const u16 VERSION = 1;
+		static const u32 FILE_HEADER_SIZE = 8;
+		static const u32 MAX_SITE_STRING_LENGTH = 1024;
+
+	//PRIVATE VARIABLES
+	private:
+		string m_path;
+		u64 m_maxFileBytes;
+		u32 m_maxFiles;
+		u64 m_fileBytes;
+		u32 m_rotationCount;
+
+		FileWriter *p_writer;
+		ByteArray *p_frame;
+		ByteArray *p_siteFrame;
+		//One flag per site ID, cleared whenever a new file starts
+		u8 *p_writtenSites;
+	
+	};
+
+	class BinaryLogDecoder {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//Writes one line per record, prefixed with its timestamp in seconds and thread ID.
+		//Returns the number of records, a file cut off mid frame decodes up to the cut.
+		static u32 Decode(ByteArray &bytes, std::ostream &out);
+
+	//PRIVATE FUNCTIONS
+	private:
+		BinaryLogDecoder();
+		BinaryLogDecoder(const BinaryLogDecoder &other);
+		BinaryLogDecoder& operator = (const BinaryLogDecoder &other);
+	
+	};
+}
+#endif
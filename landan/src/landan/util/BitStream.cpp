@@ -0,0 +1,322 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "BitStream.h"
+#include <cstring>
+#include <landan/util/ByteStream.h>
+#include <landan/util/EndianUtil.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	static u64 LowBits(u32 bits)
+	{
+		return (bits >= 64) ? ~0ull : (1ull << bits) - 1;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// CONSTRUCTORS //////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	BitWriter::BitWriter(ByteArray &bytes)
+	:p_bytes(&bytes), m_scratch(0), m_scratchBits(0), m_bitsWritten(0)
+	{
+
+	}
+
+	BitReader::BitReader(ByteArray &bytes)
+	:p_bytes(&bytes), m_scratch(0), m_scratchBits(0), m_bitsRead(0), m_error(false)
+	{
+		u32 position = bytes.GetPosition();
+		m_end = (position < bytes.GetLength()) ? bytes.GetLength() : position;
+		m_totalBits = (m_end - position) * 8;
+	}
+
+	BitReader::BitReader(ByteArray &bytes, u32 length)
+	:p_bytes(&bytes), m_scratch(0), m_scratchBits(0), m_bitsRead(0), m_error(false)
+	{
+		u32 position = bytes.GetPosition();
+		u32 available = (position < bytes.GetLength()) ? bytes.GetLength() - position : 0;
+		length = (length > available) ? available : length;
+		m_end = position + length;
+		m_totalBits = length * 8;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// DESTRUCTOR ////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	BitWriter::~BitWriter()
+	{
+		Flush();
+	}
+
+	BitReader::~BitReader()
+	{
+
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	void BitWriter::WriteBits(u32 value, u32 bits)
+	{
+		if (bits == 0 || bits > 32)
+		{
+			return;
+		}
+		m_scratch |= (static_cast<u64>(value) & LowBits(bits)) << m_scratchBits;
+		m_scratchBits += bits;
+		m_bitsWritten += bits;
+
+		if (m_scratchBits >= 32)
+		{
+			LittleEndianWriter writer(*p_bytes);
+			writer.WriteUInt32(static_cast<u32>(m_scratch));
+			m_scratch >>= 32;
+			m_scratchBits -= 32;
+		}
+	}
+
+	void BitWriter::WriteBits64(u64 value, u32 bits)
+	{
+		if (bits > 32)
+		{
+			WriteBits(static_cast<u32>(value), 32);
+			WriteBits(static_cast<u32>(value >> 32), bits - 32);
+		}
+		else
+		{
+			WriteBits(static_cast<u32>(value), bits);
+		}
+	}
+
+	void BitWriter::WriteBool(bool value)
+	{
+		WriteBits(value ? 1 : 0, 1);
+	}
+
+	void BitWriter::WriteFloat32(f32 value)
+	{
+		u32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		WriteBits(bits, 32);
+	}
+
+	void BitWriter::WriteQuantizedFloat32(f32 value, f32 min, f32 max, u32 bits)
+	{
+		WriteBits(QuantizeFloat32(value, min, max, bits), bits);
+	}
+
+	void BitWriter::Align()
+	{
+		u32 padding = (8 - (m_bitsWritten & 7)) & 7;
+		if (padding > 0)
+		{
+			WriteBits(0, padding);
+		}
+	}
+
+	void BitWriter::Flush()
+	{
+		if (m_scratchBits > 0)
+		{
+			u32 bytes = (m_scratchBits + 7) / 8;
+			for (u32 i = 0; i < bytes; i++)
+			{
+				p_bytes->WriteUInt8(static_cast<u8>(m_scratch >> (i * 8)));
+			}
+		}
+		m_scratch = 0;
+		m_scratchBits = 0;
+		m_bitsWritten = (m_bitsWritten + 7) & ~7u;
+	}
+
+	u32 BitWriter::BitsRequired(u32 maxValue)
+	{
+		u32 bits = 0;
+		while (maxValue > 0)
+		{
+			bits++;
+			maxValue >>= 1;
+		}
+		return (bits == 0) ? 1 : bits;
+	}
+
+	u32 BitWriter::QuantizeFloat32(f32 value, f32 min, f32 max, u32 bits)
+	{
+		if (bits == 0 || !(max > min))
+		{
+			return 0;
+		}
+		f64 normalized = (static_cast<f64>(value) - min) / (static_cast<f64>(max) - min);
+		//NaN fails both comparisons and lands on min
+		normalized = (normalized > 0.0) ? normalized : 0.0;
+		normalized = (normalized < 1.0) ? normalized : 1.0;
+		f64 steps = static_cast<f64>(LowBits(bits > 32 ? 32 : bits));
+		return static_cast<u32>(normalized * steps + 0.5);
+	}
+
+	u32 BitReader::ReadBits(u32 bits)
+	{
+		if (bits == 0 || bits > 32)
+		{
+			return 0;
+		}
+		if (m_scratchBits < bits)
+		{
+			Refill();
+			if (m_scratchBits < bits)
+			{
+				m_error = true;
+				return 0;
+			}
+		}
+		u32 value = static_cast<u32>(m_scratch & LowBits(bits));
+		m_scratch >>= bits;
+		m_scratchBits -= bits;
+		m_bitsRead += bits;
+		return value;
+	}
+
+	u64 BitReader::ReadBits64(u32 bits)
+	{
+		if (bits > 32)
+		{
+			u64 low = ReadBits(32);
+			return low | (static_cast<u64>(ReadBits(bits - 32)) << 32);
+		}
+		return ReadBits(bits);
+	}
+
+	bool BitReader::ReadBool()
+	{
+		return ReadBits(1) != 0;
+	}
+
+	f32 BitReader::ReadFloat32()
+	{
+		u32 bits = ReadBits(32);
+		f32 value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	f32 BitReader::ReadQuantizedFloat32(f32 min, f32 max, u32 bits)
+	{
+		return DequantizeFloat32(ReadBits(bits), min, max, bits);
+	}
+
+	void BitReader::Align()
+	{
+		u32 padding = (8 - (m_bitsRead & 7)) & 7;
+		if (padding > 0)
+		{
+			ReadBits(padding);
+		}
+	}
+
+	void BitReader::Refill()
+	{
+		LittleEndianReader reader(*p_bytes);
+		while (p_bytes->GetPosition() < m_end)
+		{
+			u32 remaining = m_end - p_bytes->GetPosition();
+			if (remaining >= 4 && m_scratchBits <= 32)
+			{
+				m_scratch |= static_cast<u64>(reader.ReadUInt32()) << m_scratchBits;
+				m_scratchBits += 32;
+			}
+			else if (remaining < 4 && m_scratchBits <= 56)
+			{
+				m_scratch |= static_cast<u64>(reader.ReadUInt8()) << m_scratchBits;
+				m_scratchBits += 8;
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+	f32 BitReader::DequantizeFloat32(u32 value, f32 min, f32 max, u32 bits)
+	{
+		if (bits == 0)
+		{
+			return min;
+		}
+		f64 steps = static_cast<f64>(LowBits(bits > 32 ? 32 : bits));
+		return static_cast<f32>(min + (static_cast<f64>(max) - min) * (value / steps));
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// GETTERS/SETTERS ///////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	u32 BitWriter::GetBitsWritten()
+	{
+		return m_bitsWritten;
+	}
+
+	u32 BitWriter::GetByteCount()
+	{
+		return (m_bitsWritten + 7) / 8;
+	}
+
+	u32 BitReader::GetBitsRead()
+	{
+		return m_bitsRead;
+	}
+
+	u32 BitReader::GetBitsRemaining()
+	{
+		return m_totalBits - m_bitsRead;
+	}
+
+	bool BitReader::HasError()
+	{
+		return m_error;
+	}
+
+}
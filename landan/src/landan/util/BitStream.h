@@ -0,0 +1,158 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: BitWriter, BitReader
+*Description: Fields of any width from 1 to 32 bits packed back to back into a ByteArray.
+*Bits gather in a 64 bit scratch word that is written out 32 bits at a time, least significant
+*bit first and little endian whatever the array's endianess.
+*Author: jkeon
+**********************************/
+
+#ifndef _BITSTREAM_H_
+#define _BITSTREAM_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/util/ByteArray.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Appends at the array's position. Nothing is visible in the array until a word fills up or
+	 * Flush is called, the destructor flushes.
+	 */
+	class BitWriter {
+
+	//PUBLIC FUNCTIONS
+	public:
+		explicit BitWriter(ByteArray &bytes);
+		~BitWriter();
+
+		//Only the low bits of value are kept
+		void WriteBits(u32 value, u32 bits);
+		void WriteBits64(u64 value, u32 bits);
+		void WriteBool(bool value);
+		void WriteFloat32(f32 value);
+		//Clamps value to [min, max] and stores it in bits bits, the error is at most (max - min) / (2^(bits + 1) - 2)
+		void WriteQuantizedFloat32(f32 value, f32 min, f32 max, u32 bits);
+
+		//Pads with zeros to the next byte boundary of the stream
+		void Align();
+		//Writes out what's still in the scratch word, padded to a whole byte. Writing can carry on
+		//afterwards, as if Align had been called.
+		void Flush();
+
+		u32 GetBitsWritten();
+		//What the stream takes up in the array once flushed
+		u32 GetByteCount();
+
+		//Bits needed for values 0 to maxValue, e.g. 3 for an enum with 8 entries
+		static u32 BitsRequired(u32 maxValue);
+		static u32 QuantizeFloat32(f32 value, f32 min, f32 max, u32 bits);
+
+	//PRIVATE FUNCTIONS
+	private:
+		BitWriter(const BitWriter &other);
+		BitWriter& operator = (const BitWriter &other);
+
+	//PRIVATE VARIABLES
+	private:
+		ByteArray *p_bytes;
+		u64 m_scratch;
+		u32 m_scratchBits;
+		u32 m_bitsWritten;
+
+	};
+
+	/**
+	 * Reads a stream written by BitWriter starting at the array's position. Reads never go past
+	 * length bytes, so whatever follows the stream in the array is left for the caller.
+	 * A read past the end returns 0 and sets the error.
+	 */
+	class BitReader {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//Everything from the position to the end of the array
+		explicit BitReader(ByteArray &bytes);
+		BitReader(ByteArray &bytes, u32 length);
+		~BitReader();
+
+		u32 ReadBits(u32 bits);
+		u64 ReadBits64(u32 bits);
+		bool ReadBool();
+		f32 ReadFloat32();
+		f32 ReadQuantizedFloat32(f32 min, f32 max, u32 bits);
+
+		//Skips to the next byte boundary of the stream
+		void Align();
+
+		u32 GetBitsRead();
+		u32 GetBitsRemaining();
+		bool HasError();
+
+		static f32 DequantizeFloat32(u32 value, f32 min, f32 max, u32 bits);
+
+	//PRIVATE FUNCTIONS
+	private:
+		BitReader(const BitReader &other);
+		BitReader& operator = (const BitReader &other);
+
+		//Tops the scratch word up from the array, whole words while it can
+		void Refill();
+
+	//PRIVATE VARIABLES
+	private:
+		ByteArray *p_bytes;
+		u64 m_scratch;
+		u32 m_scratchBits;
+		u32 m_bitsRead;
+		u32 m_end;
+		u32 m_totalBits;
+		bool m_error;
+
+	};
+}
+#endif
@@ -35,6 +35,10 @@ or implied, of Karman Interactive Ltd.
 //////////////////////////////////////////////////////////////////////
 
 #include "ByteArray.h"
+#include <cstring>
+#include <landan/util/ByteSwap.h>
+#include <landan/util/VarInt.h>
+#include <nowide/utf.hpp>
 
 //////////////////////////////////////////////////////////////////////
 // NAMESPACE /////////////////////////////////////////////////////////
@@ -47,19 +51,43 @@ namespace landan {
 	// CONSTRUCTORS //////////////////////////////////////////////////////
 	//////////////////////////////////////////////////////////////////////
 
-	ByteArray::ByteArray(u32 length)
-	:m_length(length)
+	ByteArray::ByteArray(u32 length, bytearray::MODE mode)
+	:p_data(0), m_length(0), m_capacity(0), m_position(0), m_mode(mode), m_ownership(bytearray::OWNED), m_error(false)
 	{
-		if (m_length > 0)
+		if (length > 0)
 		{
-			p_data = new u8[m_length];
+			Reallocate(length);
 		}
-		else
+		m_length = (m_mode == bytearray::FIXED) ? length : 0;
+		m_endianess = m_systemEndianess = DetermineSystemEndianess();
+	}
+
+	ByteArray::ByteArray(u8 *bytes, u32 length, bytearray::OWNERSHIP ownership, bytearray::MODE mode)
+	:p_data(bytes), m_length(length), m_capacity(length), m_position(0), m_mode(mode), m_ownership(ownership), m_error(false)
+	{
+		m_endianess = m_systemEndianess = DetermineSystemEndianess();
+	}
+
+	ByteArray::ByteArray(u8 *bytes, u32 length, Function<void (u8*)> deleter, bytearray::MODE mode)
+	:p_data(bytes), m_length(length), m_capacity(length), m_position(0), m_mode(mode), m_ownership(bytearray::OWNED), m_deleter(deleter), m_error(false)
+	{
+		m_endianess = m_systemEndianess = DetermineSystemEndianess();
+	}
+
+	ByteArray::ByteArray(ByteArray &&other)
+	:p_data(0)
+	{
+		Take(other);
+	}
+
+	ByteArray& ByteArray::operator = (ByteArray &&other)
+	{
+		if (this != &other)
 		{
-			p_data = 0;
+			Free();
+			Take(other);
 		}
-		m_position = 0;
-		m_endianess = m_systemEndianess = DetermineSystemEndianess();
+		return *this;
 	}
 
 	//////////////////////////////////////////////////////////////////////
@@ -67,258 +95,662 @@ namespace landan {
 	//////////////////////////////////////////////////////////////////////
 
 	ByteArray::~ByteArray() {
-		if (p_data != 0) 
-		{
-			delete p_data;
-			p_data = 0;
-		}
+		Free();
 	}
 
 	//////////////////////////////////////////////////////////////////////
 	// BODY //////////////////////////////////////////////////////////////
 	//////////////////////////////////////////////////////////////////////
 
+	u8* ByteArray::PrepareWrite(u32 size)
+	{
+		u32 end = m_position + size;
+		if (end > m_length || end < m_position)
+		{
+			if (m_mode == bytearray::FIXED || end < m_position)
+			{
+				m_error = true;
+				return 0;
+			}
+			if (end > m_capacity)
+			{
+				//Geometric growth so a run of small writes costs amortized constant time
+				u32 capacity = (m_capacity < MIN_CAPACITY) ? MIN_CAPACITY : m_capacity;
+				while (capacity < end)
+				{
+					capacity = (capacity > 0x7FFFFFFF) ? end : capacity * 2;
+				}
+				Reallocate(capacity);
+			}
+			//Writing after a SetPosition past the end leaves a gap, don't leave it uninitialized
+			if (m_position > m_length)
+			{
+				memset(p_data + m_length, 0, m_position - m_length);
+			}
+			m_length = end;
+		}
+
+		u8 *cursor = p_data + m_position;
+		m_position = end;
+		return cursor;
+	}
+
+	const u8* ByteArray::PrepareRead(u32 size)
+	{
+		u32 end = m_position + size;
+		if (end > m_length || end < m_position)
+		{
+			m_error = true;
+			return 0;
+		}
+
+		const u8 *cursor = p_data + m_position;
+		m_position = end;
+		return cursor;
+	}
+
+	void ByteArray::Reallocate(u32 capacity)
+	{
+		u8 *data = new u8[capacity];
+		u32 keep = (m_length < capacity) ? m_length : capacity;
+		if (p_data != 0)
+		{
+			memcpy(data, p_data, keep);
+		}
+		Free();
+
+		//Whatever the old buffer was, the new one is ours
+		p_data = data;
+		m_capacity = capacity;
+		m_ownership = bytearray::OWNED;
+		m_deleter = Function<void (u8*)>();
+	}
+
+	void ByteArray::Free()
+	{
+		if (p_data != 0 && m_ownership == bytearray::OWNED)
+		{
+			if (m_deleter)
+			{
+				m_deleter(p_data);
+			}
+			else
+			{
+				delete[] p_data;
+			}
+		}
+		p_data = 0;
+	}
+
+	void ByteArray::Take(ByteArray &other)
+	{
+		p_data = other.p_data;
+		m_length = other.m_length;
+		m_capacity = other.m_capacity;
+		m_position = other.m_position;
+		m_mode = other.m_mode;
+		m_ownership = other.m_ownership;
+		m_deleter = other.m_deleter;
+		m_error = other.m_error;
+		m_endianess = other.m_endianess;
+		m_systemEndianess = other.m_systemEndianess;
+
+		other.p_data = 0;
+		other.m_length = 0;
+		other.m_capacity = 0;
+		other.m_position = 0;
+		other.m_ownership = bytearray::OWNED;
+		other.m_deleter = Function<void (u8*)>();
+	}
+
+	void ByteArray::WriteElements(const void *values, u32 size, u32 count)
+	{
+		//count * size overflowing u32 can't fit anyway
+		if (count > 0xFFFFFFFF / size)
+		{
+			m_error = true;
+			return;
+		}
+		u8 *cursor = PrepareWrite(count * size);
+		if (cursor != 0)
+		{
+			CopyElements(cursor, values, size, count);
+		}
+	}
+
+	bool ByteArray::ReadElements(void *values, u32 size, u32 count)
+	{
+		if (count > 0xFFFFFFFF / size)
+		{
+			m_error = true;
+			return false;
+		}
+		const u8 *cursor = PrepareRead(count * size);
+		if (cursor == 0)
+		{
+			return false;
+		}
+		CopyElements(values, cursor, size, count);
+		return true;
+	}
+
+	void ByteArray::CopyElements(void *destination, const void *source, u32 size, u32 count)
+	{
+		if (size == 1 || m_endianess == m_systemEndianess)
+		{
+			memcpy(destination, source, size * count);
+			return;
+		}
+
+		switch (size)
+		{
+			case 2:
+				ByteSwap::Copy16(destination, source, count);
+				break;
+			case 4:
+				ByteSwap::Copy32(destination, source, count);
+				break;
+			case 8:
+				ByteSwap::Copy64(destination, source, count);
+				break;
+		}
+	}
+
+	bool ByteArray::ReadVarUInt(u64 &value)
+	{
+		u32 size = (m_position < m_length) ? VarInt::Decode(p_data + m_position, m_length - m_position, value) : 0;
+		if (size == 0)
+		{
+			m_error = true;
+			return false;
+		}
+		m_position += size;
+		return true;
+	}
+
+	bool ByteArray::ReadStringBytes(StringView &view, bytearray::STRING_VALIDATION validation)
+	{
+		u32 start = m_position;
+		u64 length;
+		const u8 *cursor = 0;
+		if (ReadVarUInt(length) && length <= 0xFFFFFFFF)
+		{
+			cursor = PrepareRead(static_cast<u32>(length));
+		}
+		if (cursor == 0 || (validation == bytearray::VALIDATE_UTF8 && !IsValidUTF8(reinterpret_cast<const char*>(cursor), static_cast<u32>(length))))
+		{
+			m_error = true;
+			m_position = start;
+			return false;
+		}
+		view.data = reinterpret_cast<const char*>(cursor);
+		view.length = static_cast<u32>(length);
+		return true;
+	}
+
+	u8* ByteArray::Release()
+	{
+		u8 *data = p_data;
+		p_data = 0;
+		m_length = 0;
+		m_capacity = 0;
+		m_position = 0;
+		m_ownership = bytearray::OWNED;
+		m_deleter = Function<void (u8*)>();
+		return data;
+	}
+
+	void ByteArray::Reserve(u32 capacity)
+	{
+		if (capacity > m_capacity)
+		{
+			Reallocate(capacity);
+		}
+	}
+
+	void ByteArray::Resize(u32 length)
+	{
+		Reserve(length);
+		if (length > m_length)
+		{
+			memset(p_data + m_length, 0, length - m_length);
+		}
+		m_length = length;
+		m_position = (m_position > m_length) ? m_length : m_position;
+	}
+
+	void ByteArray::ShrinkToFit()
+	{
+		if (m_capacity == m_length)
+		{
+			return;
+		}
+		if (m_length == 0)
+		{
+			Free();
+			m_capacity = 0;
+			return;
+		}
+		Reallocate(m_length);
+	}
+
 	void ByteArray::WriteUInt8(u8 value)
 	{
-		p_data[m_position] = value;
-		m_position++;
+		u8 *cursor = PrepareWrite(1);
+		if (cursor != 0)
+		{
+			*cursor = value;
+		}
 	}
 	
 	u8 ByteArray::ReadUInt8()
 	{
-		u8 value = p_data[m_position];
-		m_position++;
-		return value;
+		const u8 *cursor = PrepareRead(1);
+		return (cursor != 0) ? *cursor : 0;
 	}
 
 	void ByteArray::WriteUInt16(u16 value)
 	{
 		//Handle Endianess
 		value = (m_endianess == m_systemEndianess) ? value : SwapUInt16(value);
-		
-		//Copy the entire value into the position as dictated by the byte arrays position.
-		memcpy(&p_data[m_position], &value, sizeof(value));
 
-		//Update the position
-		m_position += 2;
+		u8 *cursor = PrepareWrite(sizeof(value));
+		if (cursor != 0)
+		{
+			memcpy(cursor, &value, sizeof(value));
+		}
 	}
 
 	u16 ByteArray::ReadUInt16()
 	{
-		//Extract the result by getting the memory address of current position in the byte array and reinterpreting that pointer as a pointer to a uint16 pointer.
-		//Then simply dereference the pointer to get the actual value as a uint16
-		u16 value = *(reinterpret_cast<u16 *>(&p_data[m_position]));
-		
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapUInt16(value);
+		const u8 *cursor = PrepareRead(sizeof(u16));
+		if (cursor == 0)
+		{
+			return 0;
+		}
 
-		//Update the position
-		m_position += 2;
+		//memcpy rather than dereferencing a cast pointer, the position is rarely aligned
+		u16 value;
+		memcpy(&value, cursor, sizeof(value));
 
-		return value;
+		//Handle Endianess
+		return (m_endianess == m_systemEndianess) ? value : SwapUInt16(value);
 	}
 
 	void ByteArray::WriteUInt32(u32 value)
 	{
 		//Handle Endianess
 		value = (m_endianess == m_systemEndianess) ? value : SwapUInt32(value);
-		
-		//Copy the entire value into the position as dictated by the byte arrays position.
-		memcpy(&p_data[m_position], &value, sizeof(value));
 
-		//Update the position
-		m_position += 4;
+		u8 *cursor = PrepareWrite(sizeof(value));
+		if (cursor != 0)
+		{
+			memcpy(cursor, &value, sizeof(value));
+		}
 	}
 
 	u32 ByteArray::ReadUInt32()
 	{
-		//Extract the result by getting the memory address of current position in the byte array and reinterpreting that pointer as a pointer to a uint16 pointer.
-		//Then simply dereference the pointer to get the actual value as a uint32
-		u32 value = *(reinterpret_cast<u32 *>(&p_data[m_position]));
-		
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapUInt32(value);
+		const u8 *cursor = PrepareRead(sizeof(u32));
+		if (cursor == 0)
+		{
+			return 0;
+		}
 
-		//Update the position
-		m_position += 4;
+		u32 value;
+		memcpy(&value, cursor, sizeof(value));
 
-		return value;
+		//Handle Endianess
+		return (m_endianess == m_systemEndianess) ? value : SwapUInt32(value);
 	}
 	
 	void ByteArray::WriteUInt64(u64 value)
 	{
 		//Handle Endianess
 		value = (m_endianess == m_systemEndianess) ? value : SwapUInt64(value);
-		
-		//Copy the entire value into the position as dictated by the byte arrays position.
-		memcpy(&p_data[m_position], &value, sizeof(value));
 
-		//Update the position
-		m_position += 8;
+		u8 *cursor = PrepareWrite(sizeof(value));
+		if (cursor != 0)
+		{
+			memcpy(cursor, &value, sizeof(value));
+		}
 	}
 
 	u64 ByteArray::ReadUInt64()
 	{
-		//Extract the result by getting the memory address of current position in the byte array and reinterpreting that pointer as a pointer to a uint16 pointer.
-		//Then simply dereference the pointer to get the actual value as a uint64
-		u64 value = *(reinterpret_cast<u64 *>(&p_data[m_position]));
-		
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapUInt64(value);
+		const u8 *cursor = PrepareRead(sizeof(u64));
+		if (cursor == 0)
+		{
+			return 0;
+		}
 
-		//Update the position
-		m_position += 8;
+		u64 value;
+		memcpy(&value, cursor, sizeof(value));
 
-		return value;
+		//Handle Endianess
+		return (m_endianess == m_systemEndianess) ? value : SwapUInt64(value);
 	}
 	
 	
 	void ByteArray::WriteInt8(i8 value)
 	{
-		p_data[m_position] = value;
-		m_position++;
+		WriteUInt8(static_cast<u8>(value));
 	}
 	
 	i8 ByteArray::ReadInt8()
 	{
-		i8 value = p_data[m_position];
-		m_position++;
-		return value;
+		return static_cast<i8>(ReadUInt8());
 	}
 
 	void ByteArray::WriteInt16(i16 value)
 	{
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapInt16(value);
-		
-		//Copy the entire value into the position as dictated by the byte arrays position.
-		memcpy(&p_data[m_position], &value, sizeof(value));
-
-		//Update the position
-		m_position += 2;
+		WriteUInt16(static_cast<u16>(value));
 	}
 
 	i16 ByteArray::ReadInt16()
 	{
-		//Extract the result by getting the memory address of current position in the byte array and reinterpreting that pointer as a pointer to a uint16 pointer.
-		//Then simply dereference the pointer to get the actual value as a int16
-		i16 value = *(reinterpret_cast<i16 *>(&p_data[m_position]));
-		
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapInt16(value);
+		return static_cast<i16>(ReadUInt16());
+	}
 
-		//Update the position
-		m_position += 2;
+	void ByteArray::WriteInt32(i32 value)
+	{
+		WriteUInt32(static_cast<u32>(value));
+	}
 
-		return value;
+	i32 ByteArray::ReadInt32()
+	{
+		return static_cast<i32>(ReadUInt32());
+	}
+	
+	void ByteArray::WriteInt64(i64 value)
+	{
+		WriteUInt64(static_cast<u64>(value));
 	}
 
-	void ByteArray::WriteInt32(i32 value)
+	i64 ByteArray::ReadInt64()
 	{
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapInt32(value);
-		
-		//Copy the entire value into the position as dictated by the byte arrays position.
-		memcpy(&p_data[m_position], &value, sizeof(value));
+		return static_cast<i64>(ReadUInt64());
+	}
 
-		//Update the position
-		m_position += 4;
+	void ByteArray::WriteFloat32(f32 value)
+	{
+		//Swap the bit pattern, not the value
+		u32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		WriteUInt32(bits);
 	}
 
-	i32 ByteArray::ReadInt32()
+	f32 ByteArray::ReadFloat32()
 	{
-		//Extract the result by getting the memory address of current position in the byte array and reinterpreting that pointer as a pointer to a uint16 pointer.
-		//Then simply dereference the pointer to get the actual value as a int32
-		i32 value = *(reinterpret_cast<i32 *>(&p_data[m_position]));
-		
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapInt32(value);
+		u32 bits = ReadUInt32();
+		f32 value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
 
-		//Update the position
-		m_position += 4;
+	void ByteArray::WriteFloat64(f64 value)
+	{
+		u64 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		WriteUInt64(bits);
+	}
 
+	f64 ByteArray::ReadFloat64()
+	{
+		u64 bits = ReadUInt64();
+		f64 value;
+		memcpy(&value, &bits, sizeof(value));
 		return value;
 	}
-	
-	void ByteArray::WriteInt64(i64 value)
+
+	void ByteArray::WriteBytes(const u8 *bytes, u32 length)
 	{
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapInt64(value);
-		
-		//Copy the entire value into the position as dictated by the byte arrays position.
-		memcpy(&p_data[m_position], &value, sizeof(value));
+		u8 *cursor = PrepareWrite(length);
+		if (cursor != 0)
+		{
+			memcpy(cursor, bytes, length);
+		}
+	}
 
-		//Update the position
-		m_position += 8;
+	bool ByteArray::ReadBytes(u8 *bytes, u32 length)
+	{
+		const u8 *cursor = PrepareRead(length);
+		if (cursor == 0)
+		{
+			return false;
+		}
+		memcpy(bytes, cursor, length);
+		return true;
 	}
 
-	i64 ByteArray::ReadInt64()
+	void ByteArray::WriteUInt8Array(const u8 *values, u32 count)
 	{
-		//Extract the result by getting the memory address of current position in the byte array and reinterpreting that pointer as a pointer to a uint16 pointer.
-		//Then simply dereference the pointer to get the actual value as a int64
-		i64 value = *(reinterpret_cast<i64 *>(&p_data[m_position]));
-		
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapInt64(value);
+		WriteElements(values, sizeof(u8), count);
+	}
 
-		//Update the position
-		m_position += 8;
+	void ByteArray::WriteUInt16Array(const u16 *values, u32 count)
+	{
+		WriteElements(values, sizeof(u16), count);
+	}
 
-		return value;
+	void ByteArray::WriteUInt32Array(const u32 *values, u32 count)
+	{
+		WriteElements(values, sizeof(u32), count);
 	}
 
-	void ByteArray::WriteFloat32(f32 value)
+	void ByteArray::WriteUInt64Array(const u64 *values, u32 count)
 	{
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapFloat32(value);
+		WriteElements(values, sizeof(u64), count);
+	}
 
-		//Copy the entire value into the position as dictated by the byte arrays position.
-		memcpy(&p_data[m_position], &value, sizeof(value));
+	void ByteArray::WriteInt8Array(const i8 *values, u32 count)
+	{
+		WriteElements(values, sizeof(i8), count);
+	}
 
-		//Update the position
-		m_position += 4;
+	void ByteArray::WriteInt16Array(const i16 *values, u32 count)
+	{
+		WriteElements(values, sizeof(i16), count);
 	}
 
-	f32 ByteArray::ReadFloat32()
+	void ByteArray::WriteInt32Array(const i32 *values, u32 count)
 	{
-		//Extract the result by getting the memory address of current position in the byte array and reinterpreting that pointer as a pointer to a float32 pointer.
-		//Then simply dereference the pointer to get the actual value as a float32
-		f32 value = *(reinterpret_cast<f32 *>(&p_data[m_position]));
+		WriteElements(values, sizeof(i32), count);
+	}
 
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapFloat32(value);
+	void ByteArray::WriteInt64Array(const i64 *values, u32 count)
+	{
+		WriteElements(values, sizeof(i64), count);
+	}
 
-		//Update the position
-		m_position += 4;
+	void ByteArray::WriteFloat32Array(const f32 *values, u32 count)
+	{
+		WriteElements(values, sizeof(f32), count);
+	}
 
-		return value;
+	void ByteArray::WriteFloat64Array(const f64 *values, u32 count)
+	{
+		WriteElements(values, sizeof(f64), count);
 	}
 
-	void ByteArray::WriteFloat64(f64 value)
+	bool ByteArray::ReadUInt8Array(u8 *values, u32 count)
 	{
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapFloat64(value);
+		return ReadElements(values, sizeof(u8), count);
+	}
 
-		//Copy the entire value into the position as dictated by the byte arrays position.
-		memcpy(&p_data[m_position], &value, sizeof(value));
+	bool ByteArray::ReadUInt16Array(u16 *values, u32 count)
+	{
+		return ReadElements(values, sizeof(u16), count);
+	}
 
-		//Update the position
-		m_position += 8;
+	bool ByteArray::ReadUInt32Array(u32 *values, u32 count)
+	{
+		return ReadElements(values, sizeof(u32), count);
 	}
 
-	f64 ByteArray::ReadFloat64()
+	bool ByteArray::ReadUInt64Array(u64 *values, u32 count)
 	{
-		//Extract the result by getting the memory address of current position in the byte array and reinterpreting that pointer as a pointer to a float32 pointer.
-		//Then simply dereference the pointer to get the actual value as a float32
-		f64 value = *(reinterpret_cast<f64 *>(&p_data[m_position]));
+		return ReadElements(values, sizeof(u64), count);
+	}
 
-		//Handle Endianess
-		value = (m_endianess == m_systemEndianess) ? value : SwapFloat64(value);
+	bool ByteArray::ReadInt8Array(i8 *values, u32 count)
+	{
+		return ReadElements(values, sizeof(i8), count);
+	}
 
-		//Update the position
-		m_position += 8;
+	bool ByteArray::ReadInt16Array(i16 *values, u32 count)
+	{
+		return ReadElements(values, sizeof(i16), count);
+	}
 
-		return value;
+	bool ByteArray::ReadInt32Array(i32 *values, u32 count)
+	{
+		return ReadElements(values, sizeof(i32), count);
+	}
+
+	bool ByteArray::ReadInt64Array(i64 *values, u32 count)
+	{
+		return ReadElements(values, sizeof(i64), count);
+	}
+
+	bool ByteArray::ReadFloat32Array(f32 *values, u32 count)
+	{
+		return ReadElements(values, sizeof(f32), count);
+	}
+
+	bool ByteArray::ReadFloat64Array(f64 *values, u32 count)
+	{
+		return ReadElements(values, sizeof(f64), count);
+	}
+
+	void ByteArray::WriteVarUInt32(u32 value)
+	{
+		WriteVarUInt64(value);
+	}
+
+	void ByteArray::WriteVarUInt64(u64 value)
+	{
+		if (value < 0x80)
+		{
+			WriteUInt8(static_cast<u8>(value));
+			return;
+		}
+		u8 encoded[VarInt::MAX_SIZE];
+		u32 size = VarInt::Encode(value, encoded);
+		u8 *cursor = PrepareWrite(size);
+		if (cursor != 0)
+		{
+			memcpy(cursor, encoded, size);
+		}
+	}
+
+	void ByteArray::WriteVarInt32(i32 value)
+	{
+		WriteVarUInt64(VarInt::ZigZag32(value));
+	}
+
+	void ByteArray::WriteVarInt64(i64 value)
+	{
+		WriteVarUInt64(VarInt::ZigZag64(value));
+	}
+
+	u32 ByteArray::ReadVarUInt32()
+	{
+		u64 value;
+		if (!ReadVarUInt(value))
+		{
+			return 0;
+		}
+		if (value > 0xFFFFFFFF)
+		{
+			m_error = true;
+			return 0;
+		}
+		return static_cast<u32>(value);
+	}
+
+	u64 ByteArray::ReadVarUInt64()
+	{
+		u64 value;
+		return ReadVarUInt(value) ? value : 0;
+	}
+
+	i32 ByteArray::ReadVarInt32()
+	{
+		return VarInt::UnZigZag32(ReadVarUInt32());
+	}
+
+	i64 ByteArray::ReadVarInt64()
+	{
+		return VarInt::UnZigZag64(ReadVarUInt64());
+	}
+
+	void ByteArray::WriteString(const string &value)
+	{
+		WriteString(value.data(), static_cast<u32>(value.size()));
+	}
+
+	void ByteArray::WriteString(const char *value)
+	{
+		WriteString(value, static_cast<u32>(strlen(value)));
+	}
+
+	void ByteArray::WriteString(const char *value, u32 length)
+	{
+		WriteVarUInt32(length);
+		WriteBytes(reinterpret_cast<const u8*>(value), length);
+	}
+
+	string ByteArray::ReadString(bytearray::STRING_VALIDATION validation)
+	{
+		StringView view;
+		return ReadStringBytes(view, validation) ? string(view.data, view.length) : string();
+	}
+
+	StringView ByteArray::ReadStringView(bytearray::STRING_VALIDATION validation)
+	{
+		StringView view;
+		if (!ReadStringBytes(view, validation))
+		{
+			view.data = 0;
+			view.length = 0;
+		}
+		return view;
+	}
+
+	bool ByteArray::IsValidUTF8(const char *text, u32 length)
+	{
+		const char *cursor = text;
+		const char *end = text + length;
+		while (cursor != end)
+		{
+			//Skip ASCII a word at a time, it's most of what we store
+			while (end - cursor >= 8)
+			{
+				u64 word;
+				memcpy(&word, cursor, sizeof(word));
+				if ((word & 0x8080808080808080ull) != 0)
+				{
+					break;
+				}
+				cursor += 8;
+			}
+			if (cursor == end)
+			{
+				break;
+			}
+			if (static_cast<u8>(*cursor) < 0x80)
+			{
+				cursor++;
+				continue;
+			}
+			nowide::utf::code_point codePoint = nowide::utf::utf_traits<char>::decode(cursor, end);
+			if (codePoint == nowide::utf::illegal || codePoint == nowide::utf::incomplete)
+			{
+				return false;
+			}
+		}
+		return true;
 	}
 
 	//////////////////////////////////////////////////////////////////////
@@ -355,4 +787,24 @@ namespace landan {
 		return m_length;
 	}
 
+	u32 ByteArray::GetCapacity()
+	{
+		return m_capacity;
+	}
+
+	bytearray::MODE ByteArray::GetMode()
+	{
+		return m_mode;
+	}
+
+	bool ByteArray::HasError()
+	{
+		return m_error;
+	}
+
+	void ByteArray::ClearError()
+	{
+		m_error = false;
+	}
+
 }
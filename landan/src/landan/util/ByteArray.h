@@ -46,6 +46,7 @@ or implied, of Karman Interactive Ltd.
 
 #include <landan/core/LandanTypes.h>
 #include <landan/util/EndianUtil.h>
+#include <landan/util/Function.h>
 
 //////////////////////////////////////////////////////////////////////
 // NAMESPACE /////////////////////////////////////////////////////////
@@ -53,24 +54,106 @@ or implied, of Karman Interactive Ltd.
 
 namespace landan {
 
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	template<endian::ENDIAN_TYPE ENDIANESS> class BasicByteWriter;
+	template<endian::ENDIAN_TYPE ENDIANESS> class BasicByteReader;
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace bytearray
+	{
+		enum MODE
+		{
+			//Length is set at construction, writes past it fail
+			FIXED = 0,
+			//Length follows the furthest write and the buffer grows to fit
+			GROWABLE = 1
+		};
+
+		//Who frees a buffer handed to the constructor
+		enum OWNERSHIP
+		{
+			//The array takes it over and frees it with delete[]
+			OWNED = 0,
+			//The caller keeps it alive and frees it, the array only reads and writes through it
+			VIEW = 1
+		};
+
+		enum STRING_VALIDATION
+		{
+			//Bytes are taken as they are
+			TRUST_UTF8 = 0,
+			//Malformed UTF-8 fails the read
+			VALIDATE_UTF8 = 1
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	//Characters that live in someone else's buffer, not null terminated
+	struct StringView
+	{
+		const char *data;
+		u32 length;
+	};
+
 	//////////////////////////////////////////////////////////////////////
 	// CLASS DECLARATION /////////////////////////////////////////////////
 	//////////////////////////////////////////////////////////////////////
 
 	/**
 	 * A ByteArray is an Array of Bytes you can manipulate
+	 *
+	 * Reads and writes are bounds checked. One that would run off the end does nothing, reads return 0,
+	 * and the array remembers the failure until ClearError so a whole message can be checked once at the end.
 	 */
 	class ByteArray {
 
+		//They go straight to PrepareWrite/PrepareRead, see ByteStream.h
+		template<endian::ENDIAN_TYPE ENDIANESS> friend class BasicByteWriter;
+		template<endian::ENDIAN_TYPE ENDIANESS> friend class BasicByteReader;
+
 	//PUBLIC FUNCTIONS
 	public:
-		ByteArray(u32 length = 0);
+		//FIXED allocates length bytes, GROWABLE starts empty with length bytes reserved
+		ByteArray(u32 length = 0, bytearray::MODE mode = bytearray::FIXED);
+		//Wraps length bytes that already exist. A growable array that outgrows a buffer it doesn't
+		//own copies into one it does, the original is left untouched.
+		ByteArray(u8 *bytes, u32 length, bytearray::OWNERSHIP ownership, bytearray::MODE mode = bytearray::FIXED);
+		//Takes over a buffer that has to be freed some other way, the deleter is called with it
+		ByteArray(u8 *bytes, u32 length, Function<void (u8*)> deleter, bytearray::MODE mode = bytearray::FIXED);
+		//Moving transfers the buffer, the source is left empty
+		ByteArray(ByteArray &&other);
+		ByteArray& operator = (ByteArray &&other);
 		~ByteArray();
 
+		//Hands the buffer to the caller, who frees it however it was allocated (delete[] unless it
+		//was adopted with a deleter). The array is left empty.
+		u8* Release();
+
 		u32 GetPosition();
 		void SetPosition(u32 position);
 
 		u32 GetLength();
+		u32 GetCapacity();
+		bytearray::MODE GetMode();
+
+		//Makes room for at least capacity bytes without changing the length
+		void Reserve(u32 capacity);
+		//Grows or truncates to length, new bytes are zeroed
+		void Resize(u32 length);
+		//Drops any capacity past the length
+		void ShrinkToFit();
+
+		bool HasError();
+		void ClearError();
 
 		endian::ENDIAN_TYPE GetEndianess();
 		void SetEndianess(endian::ENDIAN_TYPE endianess);
@@ -103,16 +186,112 @@ namespace landan {
 		f32 ReadFloat32();
 		f64 ReadFloat64();
 
+		void WriteBytes(const u8 *bytes, u32 length);
+		//Returns false and copies nothing if fewer than length bytes remain
+		bool ReadBytes(u8 *bytes, u32 length);
+
+		//Whole arrays at once. A straight copy when the array's endianess matches the system's,
+		//otherwise one vectorised byte swap pass (see ByteSwap). Reads return false and copy nothing
+		//if fewer than count elements remain.
+		void WriteUInt8Array(const u8 *values, u32 count);
+		void WriteUInt16Array(const u16 *values, u32 count);
+		void WriteUInt32Array(const u32 *values, u32 count);
+		void WriteUInt64Array(const u64 *values, u32 count);
+
+		void WriteInt8Array(const i8 *values, u32 count);
+		void WriteInt16Array(const i16 *values, u32 count);
+		void WriteInt32Array(const i32 *values, u32 count);
+		void WriteInt64Array(const i64 *values, u32 count);
+
+		void WriteFloat32Array(const f32 *values, u32 count);
+		void WriteFloat64Array(const f64 *values, u32 count);
+
+		bool ReadUInt8Array(u8 *values, u32 count);
+		bool ReadUInt16Array(u16 *values, u32 count);
+		bool ReadUInt32Array(u32 *values, u32 count);
+		bool ReadUInt64Array(u64 *values, u32 count);
+
+		bool ReadInt8Array(i8 *values, u32 count);
+		bool ReadInt16Array(i16 *values, u32 count);
+		bool ReadInt32Array(i32 *values, u32 count);
+		bool ReadInt64Array(i64 *values, u32 count);
+
+		bool ReadFloat32Array(f32 *values, u32 count);
+		bool ReadFloat64Array(f64 *values, u32 count);
+
+		//Any trivially copyable element of 1, 2, 4 or 8 bytes, such as an enum or a typedef'd id
+		template<typename T>
+		void WriteArray(const T *values, u32 count)
+		{
+			WriteElements(values, sizeof(T), count);
+		}
+
+		template<typename T>
+		bool ReadArray(T *values, u32 count)
+		{
+			return ReadElements(values, sizeof(T), count);
+		}
+
+		//LEB128 varints, one byte below 128 and at most 5 (32 bit) or 10 (64 bit). The signed versions
+		//zig-zag first so small negative values are short too. Endianess doesn't apply.
+		void WriteVarUInt32(u32 value);
+		void WriteVarUInt64(u64 value);
+		void WriteVarInt32(i32 value);
+		void WriteVarInt64(i64 value);
+
+		//A truncated varint, or one too big for the type, reads as 0 and sets the error
+		u32 ReadVarUInt32();
+		u64 ReadVarUInt64();
+		i32 ReadVarInt32();
+		i64 ReadVarInt64();
+
+		//Strings are a varint byte length followed by the raw UTF-8, no terminator
+		void WriteString(const string &value);
+		void WriteString(const char *value);
+		void WriteString(const char *value, u32 length);
+		//A failed read returns an empty string, sets the error and leaves the position where it was
+		string ReadString(bytearray::STRING_VALIDATION validation = bytearray::TRUST_UTF8);
+		//Same without copying, the view points into the array and is only good until it's written
+		//to, resized or destroyed
+		StringView ReadStringView(bytearray::STRING_VALIDATION validation = bytearray::TRUST_UTF8);
+
+		//Well formed UTF-8 with no overlong forms, surrogates or code points past U+10FFFF
+		static bool IsValidUTF8(const char *text, u32 length);
+
 	//PRIVATE FUNCTIONS
 	private:
 		ByteArray(const ByteArray& other);
 		ByteArray& operator = (const ByteArray& other);
 
+		//Pointers to size bytes at the position, advancing it, or 0 with the error set
+		u8* PrepareWrite(u32 size);
+		const u8* PrepareRead(u32 size);
+		void Reallocate(u32 capacity);
+		void Free();
+		void Take(ByteArray &other);
+
+		//size is 1, 2, 4 or 8
+		void WriteElements(const void *values, u32 size, u32 count);
+		bool ReadElements(void *values, u32 size, u32 count);
+		void CopyElements(void *destination, const void *source, u32 size, u32 count);
+		bool ReadVarUInt(u64 &value);
+		bool ReadStringBytes(StringView &view, bytearray::STRING_VALIDATION validation);
+
+	//PUBLIC VARIABLES
+	public:
+		//Smallest allocation a growable array makes
+		static const u32 MIN_CAPACITY = 64;
+
 	//PRIVATE VARIABLES
 	private:
 		u8 *p_data;
 		u32 m_length;
+		u32 m_capacity;
 		u32 m_position;
+		bytearray::MODE m_mode;
+		bytearray::OWNERSHIP m_ownership;
+		Function<void (u8*)> m_deleter;
+		bool m_error;
 
 		endian::ENDIAN_TYPE m_endianess;
 		endian::ENDIAN_TYPE m_systemEndianess;
@@ -0,0 +1,324 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: BasicByteWriter, BasicByteReader
+*Description: Reads and writes a ByteArray in a byte order fixed at compile time. Unlike the
+*ByteArray functions there's no per call endianess check, the native order compiles down to
+*plain stores and loads and the other one to a bswap.
+*Author: jkeon
+**********************************/
+
+#ifndef _BYTESTREAM_H_
+#define _BYTESTREAM_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/util/ByteArray.h>
+#include <landan/util/ByteSwap.h>
+#include <landan/util/EndianUtil.h>
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace endian
+	{
+		//Conversion between the system byte order and another one, SWAP is whether they differ
+		template<bool SWAP>
+		struct ByteOrder
+		{
+			static u16 Convert(u16 value) { return value; }
+			static u32 Convert(u32 value) { return value; }
+			static u64 Convert(u64 value) { return value; }
+
+			static void Copy(void *destination, const void *source, u32 size, u32 count)
+			{
+				memcpy(destination, source, size * count);
+			}
+		};
+
+		template<>
+		struct ByteOrder<true>
+		{
+			static u16 Convert(u16 value) { return SwapUInt16(value); }
+			static u32 Convert(u32 value) { return SwapUInt32(value); }
+			static u64 Convert(u64 value) { return SwapUInt64(value); }
+
+			static void Copy(void *destination, const void *source, u32 size, u32 count)
+			{
+				switch (size)
+				{
+					case 2:
+						ByteSwap::Copy16(destination, source, count);
+						break;
+					case 4:
+						ByteSwap::Copy32(destination, source, count);
+						break;
+					case 8:
+						ByteSwap::Copy64(destination, source, count);
+						break;
+					default:
+						memcpy(destination, source, size * count);
+						break;
+				}
+			}
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Writes at the array's position and shares its bounds checks, growth and error flag.
+	 * The array's own endianess setting is ignored.
+	 */
+	template<endian::ENDIAN_TYPE ENDIANESS>
+	class BasicByteWriter {
+
+	//PUBLIC FUNCTIONS
+	public:
+		explicit BasicByteWriter(ByteArray &bytes)
+		:p_bytes(&bytes)
+		{
+
+		}
+
+		ByteArray& GetByteArray() { return *p_bytes; }
+		u32 GetPosition() { return p_bytes->GetPosition(); }
+		void SetPosition(u32 position) { p_bytes->SetPosition(position); }
+		bool HasError() { return p_bytes->HasError(); }
+
+		void WriteUInt8(u8 value)
+		{
+			u8 *cursor = p_bytes->PrepareWrite(1);
+			if (cursor != 0)
+			{
+				*cursor = value;
+			}
+		}
+		void WriteUInt16(u16 value) { Store(Order::Convert(value)); }
+		void WriteUInt32(u32 value) { Store(Order::Convert(value)); }
+		void WriteUInt64(u64 value) { Store(Order::Convert(value)); }
+
+		void WriteInt8(i8 value) { WriteUInt8(static_cast<u8>(value)); }
+		void WriteInt16(i16 value) { WriteUInt16(static_cast<u16>(value)); }
+		void WriteInt32(i32 value) { WriteUInt32(static_cast<u32>(value)); }
+		void WriteInt64(i64 value) { WriteUInt64(static_cast<u64>(value)); }
+
+		void WriteFloat32(f32 value)
+		{
+			u32 bits;
+			memcpy(&bits, &value, sizeof(bits));
+			WriteUInt32(bits);
+		}
+
+		void WriteFloat64(f64 value)
+		{
+			u64 bits;
+			memcpy(&bits, &value, sizeof(bits));
+			WriteUInt64(bits);
+		}
+
+		void WriteBytes(const u8 *bytes, u32 length) { p_bytes->WriteBytes(bytes, length); }
+
+		void WriteVarUInt32(u32 value) { p_bytes->WriteVarUInt32(value); }
+		void WriteVarUInt64(u64 value) { p_bytes->WriteVarUInt64(value); }
+		void WriteVarInt32(i32 value) { p_bytes->WriteVarInt32(value); }
+		void WriteVarInt64(i64 value) { p_bytes->WriteVarInt64(value); }
+
+		void WriteString(const string &value) { p_bytes->WriteString(value); }
+		void WriteString(const char *value) { p_bytes->WriteString(value); }
+		void WriteString(const char *value, u32 length) { p_bytes->WriteString(value, length); }
+
+		//Elements of 1, 2, 4 or 8 bytes
+		template<typename T>
+		void WriteArray(const T *values, u32 count)
+		{
+			if (count > 0xFFFFFFFF / sizeof(T))
+			{
+				p_bytes->m_error = true;
+				return;
+			}
+			u8 *cursor = p_bytes->PrepareWrite(static_cast<u32>(count * sizeof(T)));
+			if (cursor != 0)
+			{
+				Order::Copy(cursor, values, sizeof(T), count);
+			}
+		}
+
+	//PRIVATE FUNCTIONS
+	private:
+		BasicByteWriter(const BasicByteWriter &other);
+		BasicByteWriter& operator = (const BasicByteWriter &other);
+
+		template<typename T>
+		void Store(T value)
+		{
+			u8 *cursor = p_bytes->PrepareWrite(sizeof(T));
+			if (cursor != 0)
+			{
+				memcpy(cursor, &value, sizeof(T));
+			}
+		}
+
+	//PRIVATE VARIABLES
+	private:
+		typedef endian::ByteOrder<ENDIANESS != endian::SYSTEM_ENDIAN> Order;
+
+		ByteArray *p_bytes;
+
+	};
+
+	/**
+	 * Reads from the array's position. Like ByteArray, a read past the end returns 0 and sets the error.
+	 */
+	template<endian::ENDIAN_TYPE ENDIANESS>
+	class BasicByteReader {
+
+	//PUBLIC FUNCTIONS
+	public:
+		explicit BasicByteReader(ByteArray &bytes)
+		:p_bytes(&bytes)
+		{
+
+		}
+
+		ByteArray& GetByteArray() { return *p_bytes; }
+		u32 GetPosition() { return p_bytes->GetPosition(); }
+		void SetPosition(u32 position) { p_bytes->SetPosition(position); }
+		bool HasError() { return p_bytes->HasError(); }
+
+		u8 ReadUInt8()
+		{
+			const u8 *cursor = p_bytes->PrepareRead(1);
+			return (cursor != 0) ? *cursor : 0;
+		}
+		u16 ReadUInt16() { return Order::Convert(Load<u16>()); }
+		u32 ReadUInt32() { return Order::Convert(Load<u32>()); }
+		u64 ReadUInt64() { return Order::Convert(Load<u64>()); }
+
+		i8 ReadInt8() { return static_cast<i8>(ReadUInt8()); }
+		i16 ReadInt16() { return static_cast<i16>(ReadUInt16()); }
+		i32 ReadInt32() { return static_cast<i32>(ReadUInt32()); }
+		i64 ReadInt64() { return static_cast<i64>(ReadUInt64()); }
+
+		f32 ReadFloat32()
+		{
+			u32 bits = ReadUInt32();
+			f32 value;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		f64 ReadFloat64()
+		{
+			u64 bits = ReadUInt64();
+			f64 value;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		bool ReadBytes(u8 *bytes, u32 length) { return p_bytes->ReadBytes(bytes, length); }
+
+		u32 ReadVarUInt32() { return p_bytes->ReadVarUInt32(); }
+		u64 ReadVarUInt64() { return p_bytes->ReadVarUInt64(); }
+		i32 ReadVarInt32() { return p_bytes->ReadVarInt32(); }
+		i64 ReadVarInt64() { return p_bytes->ReadVarInt64(); }
+
+		string ReadString(bytearray::STRING_VALIDATION validation = bytearray::TRUST_UTF8) { return p_bytes->ReadString(validation); }
+		StringView ReadStringView(bytearray::STRING_VALIDATION validation = bytearray::TRUST_UTF8) { return p_bytes->ReadStringView(validation); }
+
+		//Returns false and copies nothing if fewer than count elements remain
+		template<typename T>
+		bool ReadArray(T *values, u32 count)
+		{
+			if (count > 0xFFFFFFFF / sizeof(T))
+			{
+				p_bytes->m_error = true;
+				return false;
+			}
+			const u8 *cursor = p_bytes->PrepareRead(static_cast<u32>(count * sizeof(T)));
+			if (cursor == 0)
+			{
+				return false;
+			}
+			Order::Copy(values, cursor, sizeof(T), count);
+			return true;
+		}
+
+	//PRIVATE FUNCTIONS
+	private:
+		BasicByteReader(const BasicByteReader &other);
+		BasicByteReader& operator = (const BasicByteReader &other);
+
+		template<typename T>
+		T Load()
+		{
+			T value = 0;
+			const u8 *cursor = p_bytes->PrepareRead(sizeof(T));
+			if (cursor != 0)
+			{
+				memcpy(&value, cursor, sizeof(T));
+			}
+			return value;
+		}
+
+	//PRIVATE VARIABLES
+	private:
+		typedef endian::ByteOrder<ENDIANESS != endian::SYSTEM_ENDIAN> Order;
+
+		ByteArray *p_bytes;
+
+	};
+
+	typedef BasicByteWriter<endian::LITTLE_ENDIAN> LittleEndianWriter;
+	typedef BasicByteWriter<endian::BIG_ENDIAN> BigEndianWriter;
+	typedef BasicByteWriter<endian::SYSTEM_ENDIAN> NativeEndianWriter;
+
+	typedef BasicByteReader<endian::LITTLE_ENDIAN> LittleEndianReader;
+	typedef BasicByteReader<endian::BIG_ENDIAN> BigEndianReader;
+	typedef BasicByteReader<endian::SYSTEM_ENDIAN> NativeEndianReader;
+}
+#endif
@@ -0,0 +1,318 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "ByteSwap.h"
+#include <cstring>
+#include <landan/util/EndianUtil.h>
+
+//Vector kernels are only built for x86. GCC compiles each one for its own instruction set through
+//a target attribute so the rest of the library doesn't need -mssse3/-mavx2, MSVC needs nothing
+//for SSSE3 and only has AVX2 intrinsics from Visual Studio 2012 on.
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define LANDAN_BYTESWAP_X86
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#include <tmmintrin.h>
+		#if _MSC_VER >= 1700
+			#include <immintrin.h>
+			#define LANDAN_BYTESWAP_AVX2
+		#endif
+		#define LANDAN_TARGET(isa)
+	#else
+		#include <cpuid.h>
+		#include <immintrin.h>
+		#define LANDAN_BYTESWAP_AVX2
+		#define LANDAN_TARGET(isa) __attribute__((target(isa)))
+	#endif
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// KERNELS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	static void Swap16Scalar(u8 *destination, const u8 *source, u32 count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			u16 value;
+			memcpy(&value, source + i * 2, 2);
+			value = SwapUInt16(value);
+			memcpy(destination + i * 2, &value, 2);
+		}
+	}
+
+	static void Swap32Scalar(u8 *destination, const u8 *source, u32 count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			u32 value;
+			memcpy(&value, source + i * 4, 4);
+			value = SwapUInt32(value);
+			memcpy(destination + i * 4, &value, 4);
+		}
+	}
+
+	static void Swap64Scalar(u8 *destination, const u8 *source, u32 count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			u64 value;
+			memcpy(&value, source + i * 8, 8);
+			value = SwapUInt64(value);
+			memcpy(destination + i * 8, &value, 8);
+		}
+	}
+
+#ifdef LANDAN_BYTESWAP_X86
+	//pshufb masks, output byte i takes input byte mask[i]. AVX2 shuffles within each 16 byte lane
+	//so the same mask is used twice.
+	static const u8 SHUFFLE16[32] = { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 };
+	static const u8 SHUFFLE32[32] = { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 };
+	static const u8 SHUFFLE64[32] = { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 };
+
+	//Returns how many bytes it handled, always a multiple of 16
+	LANDAN_TARGET("ssse3") static size_t ShuffleSSSE3(u8 *destination, const u8 *source, size_t bytes, const u8 *shuffle)
+	{
+		const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle));
+		size_t i = 0;
+		for (; i + 16 <= bytes; i += 16)
+		{
+			__m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_shuffle_epi8(value, mask));
+		}
+		return i;
+	}
+
+	static void Swap16SSSE3(u8 *destination, const u8 *source, u32 count)
+	{
+		size_t done = ShuffleSSSE3(destination, source, static_cast<size_t>(count) * 2, SHUFFLE16);
+		Swap16Scalar(destination + done, source + done, count - static_cast<u32>(done / 2));
+	}
+
+	static void Swap32SSSE3(u8 *destination, const u8 *source, u32 count)
+	{
+		size_t done = ShuffleSSSE3(destination, source, static_cast<size_t>(count) * 4, SHUFFLE32);
+		Swap32Scalar(destination + done, source + done, count - static_cast<u32>(done / 4));
+	}
+
+	static void Swap64SSSE3(u8 *destination, const u8 *source, u32 count)
+	{
+		size_t done = ShuffleSSSE3(destination, source, static_cast<size_t>(count) * 8, SHUFFLE64);
+		Swap64Scalar(destination + done, source + done, count - static_cast<u32>(done / 8));
+	}
+#endif
+
+#ifdef LANDAN_BYTESWAP_AVX2
+	//Two vectors per iteration to keep both load ports busy, then SSSE3 and scalar mop up the tail
+	LANDAN_TARGET("avx2") static size_t ShuffleAVX2(u8 *destination, const u8 *source, size_t bytes, const u8 *shuffle)
+	{
+		const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(shuffle));
+		size_t i = 0;
+		for (; i + 64 <= bytes; i += 64)
+		{
+			__m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+			__m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 32));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_shuffle_epi8(first, mask));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 32), _mm256_shuffle_epi8(second, mask));
+		}
+		return i + ShuffleSSSE3(destination + i, source + i, bytes - i, shuffle);
+	}
+
+	static void Swap16AVX2(u8 *destination, const u8 *source, u32 count)
+	{
+		size_t done = ShuffleAVX2(destination, source, static_cast<size_t>(count) * 2, SHUFFLE16);
+		Swap16Scalar(destination + done, source + done, count - static_cast<u32>(done / 2));
+	}
+
+	static void Swap32AVX2(u8 *destination, const u8 *source, u32 count)
+	{
+		size_t done = ShuffleAVX2(destination, source, static_cast<size_t>(count) * 4, SHUFFLE32);
+		Swap32Scalar(destination + done, source + done, count - static_cast<u32>(done / 4));
+	}
+
+	static void Swap64AVX2(u8 *destination, const u8 *source, u32 count)
+	{
+		size_t done = ShuffleAVX2(destination, source, static_cast<size_t>(count) * 8, SHUFFLE64);
+		Swap64Scalar(destination + done, source + done, count - static_cast<u32>(done / 8));
+	}
+
+	LANDAN_TARGET("xsave") static u64 ReadXCR0()
+	{
+	#ifdef _MSC_VER
+		return _xgetbv(0);
+	#else
+		u32 eax;
+		u32 edx;
+		__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return (static_cast<u64>(edx) << 32) | eax;
+	#endif
+	}
+#endif
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	ByteSwap::SwapFunction ByteSwap::SWAP16 = &ByteSwap::Resolve16;
+	ByteSwap::SwapFunction ByteSwap::SWAP32 = &ByteSwap::Resolve32;
+	ByteSwap::SwapFunction ByteSwap::SWAP64 = &ByteSwap::Resolve64;
+	byteswap::KERNEL ByteSwap::KERNEL = byteswap::SCALAR;
+
+	void ByteSwap::Copy16(void *destination, const void *source, u32 count)
+	{
+		SWAP16(static_cast<u8*>(destination), static_cast<const u8*>(source), count);
+	}
+
+	void ByteSwap::Copy32(void *destination, const void *source, u32 count)
+	{
+		SWAP32(static_cast<u8*>(destination), static_cast<const u8*>(source), count);
+	}
+
+	void ByteSwap::Copy64(void *destination, const void *source, u32 count)
+	{
+		SWAP64(static_cast<u8*>(destination), static_cast<const u8*>(source), count);
+	}
+
+	byteswap::KERNEL ByteSwap::GetSupportedKernel()
+	{
+#ifdef LANDAN_BYTESWAP_X86
+		u32 leaf1Ecx = 0;
+		u32 leaf7Ebx = 0;
+	#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+		__cpuid(info, 1);
+		leaf1Ecx = static_cast<u32>(info[2]);
+		if (maxLeaf >= 7)
+		{
+			__cpuidex(info, 7, 0);
+			leaf7Ebx = static_cast<u32>(info[1]);
+		}
+	#else
+		unsigned int eax, ebx, ecx, edx;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		{
+			return byteswap::SCALAR;
+		}
+		leaf1Ecx = ecx;
+		if (__get_cpuid_max(0, 0) >= 7)
+		{
+			__cpuid_count(7, 0, eax, ebx, ecx, edx);
+			leaf7Ebx = ebx;
+		}
+	#endif
+
+	#ifdef LANDAN_BYTESWAP_AVX2
+		bool osSavesYmm = (leaf1Ecx & (1 << 27)) != 0 && (ReadXCR0() & 6) == 6;
+		if ((leaf7Ebx & (1 << 5)) != 0 && (leaf1Ecx & (1 << 28)) != 0 && osSavesYmm)
+		{
+			return byteswap::AVX2;
+		}
+	#endif
+		if ((leaf1Ecx & (1 << 9)) != 0)
+		{
+			return byteswap::SSSE3;
+		}
+#endif
+		return byteswap::SCALAR;
+	}
+
+	byteswap::KERNEL ByteSwap::GetKernel()
+	{
+		if (SWAP16 == &ByteSwap::Resolve16)
+		{
+			SetKernel(GetSupportedKernel());
+		}
+		return KERNEL;
+	}
+
+	void ByteSwap::SetKernel(byteswap::KERNEL kernel)
+	{
+		byteswap::KERNEL supported = GetSupportedKernel();
+		kernel = (kernel > supported) ? supported : kernel;
+
+		switch (kernel)
+		{
+#ifdef LANDAN_BYTESWAP_AVX2
+			case byteswap::AVX2:
+				SWAP16 = &Swap16AVX2;
+				SWAP32 = &Swap32AVX2;
+				SWAP64 = &Swap64AVX2;
+				break;
+#endif
+#ifdef LANDAN_BYTESWAP_X86
+			case byteswap::SSSE3:
+				SWAP16 = &Swap16SSSE3;
+				SWAP32 = &Swap32SSSE3;
+				SWAP64 = &Swap64SSSE3;
+				break;
+#endif
+			default:
+				kernel = byteswap::SCALAR;
+				SWAP16 = &Swap16Scalar;
+				SWAP32 = &Swap32Scalar;
+				SWAP64 = &Swap64Scalar;
+				break;
+		}
+		KERNEL = kernel;
+	}
+
+	void ByteSwap::Resolve16(u8 *destination, const u8 *source, u32 count)
+	{
+		SetKernel(GetSupportedKernel());
+		SWAP16(destination, source, count);
+	}
+
+	void ByteSwap::Resolve32(u8 *destination, const u8 *source, u32 count)
+	{
+		SetKernel(GetSupportedKernel());
+		SWAP32(destination, source, count);
+	}
+
+	void ByteSwap::Resolve64(u8 *destination, const u8 *source, u32 count)
+	{
+		SetKernel(GetSupportedKernel());
+		SWAP64(destination, source, count);
+	}
+
+}
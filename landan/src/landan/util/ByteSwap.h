@@ -0,0 +1,112 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: ByteSwap
+*Description: Bulk byte reversal of 16, 32 and 64 bit elements. Picks an SSSE3 or AVX2
+*kernel at runtime based on what the CPU supports, with a scalar fallback everywhere else.
+*Author: jkeon
+**********************************/
+
+#ifndef _BYTESWAP_H_
+#define _BYTESWAP_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace byteswap
+	{
+		enum KERNEL
+		{
+			SCALAR = 0,
+			SSSE3 = 1,
+			AVX2 = 2
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class ByteSwap {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//Copies count elements reversing the bytes of each. Source and destination may be the same
+		//buffer but must not otherwise overlap, neither needs to be aligned.
+		static void Copy16(void *destination, const void *source, u32 count);
+		static void Copy32(void *destination, const void *source, u32 count);
+		static void Copy64(void *destination, const void *source, u32 count);
+
+		//The fastest kernel this CPU and OS can run
+		static byteswap::KERNEL GetSupportedKernel();
+		static byteswap::KERNEL GetKernel();
+		//Forces a kernel, mostly for tests and benchmarks. Anything the CPU can't run falls back to the best it can.
+		static void SetKernel(byteswap::KERNEL kernel);
+
+	//PRIVATE FUNCTIONS
+	private:
+		ByteSwap();
+		ByteSwap(const ByteSwap &other);
+		ByteSwap& operator = (const ByteSwap &other);
+
+		static void Resolve16(u8 *destination, const u8 *source, u32 count);
+		static void Resolve32(u8 *destination, const u8 *source, u32 count);
+		static void Resolve64(u8 *destination, const u8 *source, u32 count);
+
+	//PRIVATE VARIABLES
+	private:
+		typedef void (*SwapFunction)(u8 *destination, const u8 *source, u32 count);
+
+		//Start out pointing at the Resolve functions, which detect the CPU on first use
+		static SwapFunction SWAP16;
+		static SwapFunction SWAP32;
+		static SwapFunction SWAP64;
+		static byteswap::KERNEL KERNEL;
+	
+	};
+}
+#endif
@@ -0,0 +1,610 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "Compression.h"
+#include <cstring>
+#include <vector>
+#include <landan/thread/Atomic.h>
+#include <landan/thread/Thread.h>
+#include <landan/util/ByteArray.h>
+#include <landan/util/ByteStream.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	typedef endian::ByteOrder<endian::SYSTEM_ENDIAN != endian::LITTLE_ENDIAN> LittleEndianOrder;
+
+	//The format's limits, a match needs 4 bytes and the last 5 bytes of a block are always literals
+	static const u32 MIN_MATCH = 4;
+	static const u32 LAST_LITERALS = 5;
+	static const u32 MATCH_SEARCH_MARGIN = 12;
+	static const u32 MAX_DISTANCE = 65535;
+	static const u32 HASH_LOG = 12;
+	//Incompressible data gets skipped through faster the longer it goes without a match
+	static const u32 SKIP_TRIGGER = 6;
+
+	static u32 Load32(const u8 *bytes)
+	{
+		u32 value;
+		memcpy(&value, bytes, sizeof(value));
+		return value;
+	}
+
+	static u32 LoadLittle32(const u8 *bytes)
+	{
+		return LittleEndianOrder::Convert(Load32(bytes));
+	}
+
+	static void StoreLittle32(u8 *bytes, u32 value)
+	{
+		value = LittleEndianOrder::Convert(value);
+		memcpy(bytes, &value, sizeof(value));
+	}
+
+	static u32 HashSequence(u32 sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - HASH_LOG);
+	}
+
+	//Lengths of 15 and up spill into extra bytes of 255 each and a remainder
+	static u8* WriteLength(u8 *out, u32 length)
+	{
+		while (length >= 255)
+		{
+			*out++ = 255;
+			length -= 255;
+		}
+		*out++ = static_cast<u8>(length);
+		return out;
+	}
+
+	//Returns 0 if the sequence doesn't fit. A match length of 0 writes the closing literals.
+	static u8* WriteSequence(u8 *out, u8 *end, const u8 *literals, u32 literalLength, u32 offset, u32 matchLength)
+	{
+		if (static_cast<size_t>(end - out) < static_cast<size_t>(literalLength) + literalLength / 255 + matchLength / 255 + 8)
+		{
+			return 0;
+		}
+
+		u8 *token = out++;
+		*token = static_cast<u8>(((literalLength < 15) ? literalLength : 15) << 4);
+		if (literalLength >= 15)
+		{
+			out = WriteLength(out, literalLength - 15);
+		}
+		memcpy(out, literals, literalLength);
+		out += literalLength;
+
+		if (matchLength == 0)
+		{
+			return out;
+		}
+
+		*out++ = static_cast<u8>(offset);
+		*out++ = static_cast<u8>(offset >> 8);
+		u32 extra = matchLength - MIN_MATCH;
+		*token |= static_cast<u8>((extra < 15) ? extra : 15);
+		if (extra >= 15)
+		{
+			out = WriteLength(out, extra - 15);
+		}
+		return out;
+	}
+
+	//Returns false if the length runs off the end of the input
+	static bool ReadLength(const u8 *bytes, u32 length, u32 &position, u32 &value)
+	{
+		u8 next;
+		do
+		{
+			if (position >= length)
+			{
+				return false;
+			}
+			next = bytes[position++];
+			value += next;
+			//Nothing legitimate gets near this, it only stops a crafted length wrapping around
+			if (value > Lz4::MAX_INPUT_SIZE)
+			{
+				return false;
+			}
+		} while (next == 255);
+		return true;
+	}
+
+	//One call's worth of chunks, claimed a chunk at a time by however many threads are running it
+	struct ChunkBatch
+	{
+		volatile u32 next;
+		volatile u32 failed;
+		u32 count;
+		bool encode;
+
+		//Encoding reads chunk i from input + i * chunkSize and writes it to output + i * stride
+		const u8 *input;
+		u32 inputLength;
+		u32 chunkSize;
+		u8 *output;
+		u32 stride;
+		std::vector<u32> encodedLengths;
+
+		//Decoding works from the chunk table built while checking the stream
+		std::vector<compression::CODEC> codecs;
+		std::vector<u32> inputOffsets;
+		std::vector<u32> storedSizes;
+		std::vector<u32> outputOffsets;
+		std::vector<u32> originalSizes;
+
+		void Run()
+		{
+			for (;;)
+			{
+				u32 i = AtomicFetchAdd(&next, 1);
+				if (i >= count)
+				{
+					return;
+				}
+				if (encode)
+				{
+					u32 offset = i * chunkSize;
+					u32 length = (inputLength - offset < chunkSize) ? inputLength - offset : chunkSize;
+					encodedLengths[i] = Compression::EncodeChunk(input + offset, length, output + static_cast<size_t>(i) * stride);
+				}
+				else if (!Compression::DecodeChunk(codecs[i], input + inputOffsets[i], storedSizes[i], output + outputOffsets[i], originalSizes[i]))
+				{
+					AtomicExchange(&failed, 1);
+				}
+			}
+		}
+	};
+
+	//The calling thread always works too, so one thread means no threads are started
+	static void RunBatch(ChunkBatch &batch, u32 threadCount)
+	{
+		batch.next = 0;
+		batch.failed = 0;
+		u32 helpers = ((threadCount < batch.count) ? threadCount : batch.count);
+		helpers = (helpers > 0) ? helpers - 1 : 0;
+
+		std::vector<Thread*> threads;
+		for (u32 i = 0; i < helpers; i++)
+		{
+			Thread *thread = new Thread(MEMBER_FUNCTION(&ChunkBatch::Run, &batch));
+			thread->Start();
+			threads.push_back(thread);
+		}
+		batch.Run();
+		for (u32 i = 0; i < threads.size(); i++)
+		{
+			threads[i]->Join();
+			delete threads[i];
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// BODY //////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	u32 Lz4::GetMaxCompressedSize(u32 length)
+	{
+		return length + length / 255 + 16;
+	}
+
+	u32 Lz4::Compress(const u8 *bytes, u32 length, u8 *out, u32 capacity)
+	{
+		if (length > MAX_INPUT_SIZE)
+		{
+			return 0;
+		}
+
+		u8 *op = out;
+		u8 *end = out + capacity;
+		u32 anchor = 0;
+
+		if (length > MATCH_SEARCH_MARGIN)
+		{
+			u32 table[1 << HASH_LOG];
+			memset(table, 0, sizeof(table));
+			u32 matchLimit = length - LAST_LITERALS;
+			u32 searchLimit = length - MATCH_SEARCH_MARGIN;
+
+			u32 ip = 1;
+			while (ip < searchLimit)
+			{
+				u32 sequence = Load32(bytes + ip);
+				u32 &entry = table[HashSequence(sequence)];
+				u32 candidate = entry;
+				entry = ip;
+				if (ip - candidate > MAX_DISTANCE || Load32(bytes + candidate) != sequence)
+				{
+					ip += 1 + ((ip - anchor) >> SKIP_TRIGGER);
+					continue;
+				}
+
+				//Pull the match back over literals that also match
+				while (ip > anchor && candidate > 0 && bytes[ip - 1] == bytes[candidate - 1])
+				{
+					ip--;
+					candidate--;
+				}
+
+				u32 matchLength = MIN_MATCH;
+				while (ip + matchLength + 4 <= matchLimit && Load32(bytes + ip + matchLength) == Load32(bytes + candidate + matchLength))
+				{
+					matchLength += 4;
+				}
+				while (ip + matchLength < matchLimit && bytes[ip + matchLength] == bytes[candidate + matchLength])
+				{
+					matchLength++;
+				}
+
+				op = WriteSequence(op, end, bytes + anchor, ip - anchor, ip - candidate, matchLength);
+				if (op == 0)
+				{
+					return 0;
+				}
+				ip += matchLength;
+				anchor = ip;
+
+				//Positions inside the match are never hashed, catch the one just before its end
+				if (ip < searchLimit)
+				{
+					table[HashSequence(Load32(bytes + ip - 2))] = ip - 2;
+				}
+			}
+		}
+
+		op = WriteSequence(op, end, bytes + anchor, length - anchor, 0, 0);
+		return (op == 0) ? 0 : static_cast<u32>(op - out);
+	}
+
+	i32 Lz4::Decompress(const u8 *bytes, u32 length, u8 *out, u32 capacity)
+	{
+		u32 ip = 0;
+		u32 op = 0;
+		while (ip < length)
+		{
+			u8 token = bytes[ip++];
+
+			u32 literalLength = token >> 4;
+			if (literalLength == 15 && !ReadLength(bytes, length, ip, literalLength))
+			{
+				return -1;
+			}
+			if (literalLength > length - ip || literalLength > capacity - op)
+			{
+				return -1;
+			}
+			memcpy(out + op, bytes + ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+
+			//The last sequence is only literals
+			if (ip == length)
+			{
+				break;
+			}
+
+			if (length - ip < 2)
+			{
+				return -1;
+			}
+			u32 offset = bytes[ip] | (bytes[ip + 1] << 8);
+			ip += 2;
+			if (offset == 0 || offset > op)
+			{
+				return -1;
+			}
+
+			u32 matchLength = token & 15;
+			if (matchLength == 15 && !ReadLength(bytes, length, ip, matchLength))
+			{
+				return -1;
+			}
+			matchLength += MIN_MATCH;
+			if (matchLength > capacity - op)
+			{
+				return -1;
+			}
+
+			//Matches can overlap what they're writing, which repeats the last offset bytes
+			u8 *target = out + op;
+			const u8 *source = target - offset;
+			if (offset >= matchLength)
+			{
+				memcpy(target, source, matchLength);
+			}
+			else if (offset >= 8)
+			{
+				u32 copied = 0;
+				for (; copied + 8 <= matchLength; copied += 8)
+				{
+					memcpy(target + copied, source + copied, 8);
+				}
+				for (; copied < matchLength; copied++)
+				{
+					target[copied] = source[copied];
+				}
+			}
+			else
+			{
+				for (u32 i = 0; i < matchLength; i++)
+				{
+					target[i] = source[i];
+				}
+			}
+			op += matchLength;
+		}
+		return static_cast<i32>(op);
+	}
+
+	bool Compression::Compress(ByteArray &in, ByteArray &out, u32 chunkSize, u32 threadCount)
+	{
+		chunkSize = (chunkSize == 0) ? DEFAULT_CHUNK_SIZE : ((chunkSize > MAX_CHUNK_SIZE) ? MAX_CHUNK_SIZE : chunkSize);
+		u32 inPosition = in.GetPosition();
+		u32 length = (inPosition < in.GetLength()) ? in.GetLength() - inPosition : 0;
+
+		ChunkBatch batch;
+		batch.encode = true;
+		batch.count = (length + chunkSize - 1) / chunkSize;
+		batch.input = in.GetRawBytes() + inPosition;
+		batch.inputLength = length;
+		batch.chunkSize = chunkSize;
+		batch.stride = GetMaxChunkSize((length < chunkSize) ? length : chunkSize);
+		batch.encodedLengths.resize(batch.count);
+
+		u64 maxSize = compression::HEADER_SIZE + static_cast<u64>(batch.count) * batch.stride + compression::CHUNK_HEADER_SIZE;
+		u32 outPosition = out.GetPosition();
+		u32 outLength = out.GetLength();
+		if (outPosition + maxSize > 0xFFFFFFFF)
+		{
+			return false;
+		}
+
+		//Growable arrays are compressed into place, fixed ones go through scratch in case they're too small
+		std::vector<u8> scratch;
+		u8 *target;
+		if (out.GetMode() == bytearray::GROWABLE)
+		{
+			if (outPosition + maxSize > outLength)
+			{
+				out.Resize(static_cast<u32>(outPosition + maxSize));
+			}
+			target = out.GetRawBytes() + outPosition;
+		}
+		else
+		{
+			scratch.resize(static_cast<size_t>(maxSize));
+			target = &scratch[0];
+		}
+
+		WriteHeader(target, chunkSize);
+		batch.output = target + compression::HEADER_SIZE;
+		RunBatch(batch, threadCount);
+
+		//Chunks were written a stride apart, close the gaps. Each one only ever moves backwards.
+		u32 size = compression::HEADER_SIZE;
+		for (u32 i = 0; i < batch.count; i++)
+		{
+			memmove(target + size, batch.output + static_cast<size_t>(i) * batch.stride, batch.encodedLengths[i]);
+			size += batch.encodedLengths[i];
+		}
+		WriteEndChunk(target + size);
+		size += compression::CHUNK_HEADER_SIZE;
+
+		if (out.GetMode() == bytearray::GROWABLE)
+		{
+			out.Resize((outPosition + size > outLength) ? outPosition + size : outLength);
+		}
+		else
+		{
+			if (outPosition > outLength || size > outLength - outPosition)
+			{
+				return false;
+			}
+			memcpy(out.GetRawBytes() + outPosition, target, size);
+		}
+
+		out.SetPosition(outPosition + size);
+		in.SetPosition(inPosition + length);
+		return true;
+	}
+
+	bool Compression::Decompress(ByteArray &in, ByteArray &out, u32 threadCount)
+	{
+		u32 inPosition = in.GetPosition();
+		u32 inLength = in.GetLength();
+		if (inPosition > inLength || inLength - inPosition < compression::HEADER_SIZE)
+		{
+			return false;
+		}
+		const u8 *input = in.GetRawBytes() + inPosition;
+		u32 length = inLength - inPosition;
+		u32 chunkSize = ReadHeader(input);
+		if (chunkSize == 0)
+		{
+			return false;
+		}
+
+		//Walk the chunk headers first so every chunk knows where it lands
+		ChunkBatch batch;
+		batch.encode = false;
+		batch.input = input;
+		u32 position = compression::HEADER_SIZE;
+		u64 total = 0;
+		for (;;)
+		{
+			if (length - position < compression::CHUNK_HEADER_SIZE)
+			{
+				return false;
+			}
+			compression::CODEC codec;
+			u32 originalSize;
+			u32 storedSize;
+			ReadChunkHeader(input + position, codec, originalSize, storedSize);
+			position += compression::CHUNK_HEADER_SIZE;
+			if (codec == compression::CODEC_END)
+			{
+				break;
+			}
+			if ((codec != compression::CODEC_STORED && codec != compression::CODEC_LZ4) || originalSize > chunkSize || storedSize > GetMaxChunkSize(chunkSize) || storedSize > length - position)
+			{
+				return false;
+			}
+			batch.codecs.push_back(codec);
+			batch.inputOffsets.push_back(position);
+			batch.storedSizes.push_back(storedSize);
+			batch.outputOffsets.push_back(static_cast<u32>(total));
+			batch.originalSizes.push_back(originalSize);
+			position += storedSize;
+			total += originalSize;
+		}
+		batch.count = static_cast<u32>(batch.codecs.size());
+
+		u32 outPosition = out.GetPosition();
+		u32 outLength = out.GetLength();
+		if (outPosition + total > 0xFFFFFFFF)
+		{
+			return false;
+		}
+		if (outPosition + total > outLength)
+		{
+			if (out.GetMode() != bytearray::GROWABLE)
+			{
+				return false;
+			}
+			out.Resize(static_cast<u32>(outPosition + total));
+		}
+
+		batch.output = out.GetRawBytes() + outPosition;
+		RunBatch(batch, threadCount);
+		if (batch.failed != 0)
+		{
+			if (out.GetLength() != outLength)
+			{
+				out.Resize(outLength);
+			}
+			out.SetPosition(outPosition);
+			return false;
+		}
+
+		out.SetPosition(static_cast<u32>(outPosition + total));
+		in.SetPosition(inPosition + position);
+		return true;
+	}
+
+	void Compression::WriteHeader(u8 *out, u32 chunkSize)
+	{
+		StoreLittle32(out, compression::MAGIC);
+		out[4] = static_cast<u8>(compression::VERSION);
+		out[5] = static_cast<u8>(compression::VERSION >> 8);
+		out[6] = 0;
+		out[7] = 0;
+		StoreLittle32(out + 8, chunkSize);
+	}
+
+	u32 Compression::ReadHeader(const u8 *bytes)
+	{
+		u16 version = static_cast<u16>(bytes[4] | (bytes[5] << 8));
+		u32 chunkSize = LoadLittle32(bytes + 8);
+		if (LoadLittle32(bytes) != compression::MAGIC || version != compression::VERSION || chunkSize > MAX_CHUNK_SIZE)
+		{
+			return 0;
+		}
+		return chunkSize;
+	}
+
+	u32 Compression::GetMaxChunkSize(u32 length)
+	{
+		return compression::CHUNK_HEADER_SIZE + Lz4::GetMaxCompressedSize(length);
+	}
+
+	u32 Compression::EncodeChunk(const u8 *bytes, u32 length, u8 *out)
+	{
+		//Only keep the compressed form if it actually saves something
+		u8 *body = out + compression::CHUNK_HEADER_SIZE;
+		u32 storedSize = Lz4::Compress(bytes, length, body, length);
+		compression::CODEC codec = compression::CODEC_LZ4;
+		if (storedSize == 0 || storedSize >= length)
+		{
+			memcpy(body, bytes, length);
+			storedSize = length;
+			codec = compression::CODEC_STORED;
+		}
+		out[0] = static_cast<u8>(codec);
+		StoreLittle32(out + 1, length);
+		StoreLittle32(out + 5, storedSize);
+		return compression::CHUNK_HEADER_SIZE + storedSize;
+	}
+
+	void Compression::WriteEndChunk(u8 *out)
+	{
+		memset(out, 0, compression::CHUNK_HEADER_SIZE);
+	}
+
+	void Compression::ReadChunkHeader(const u8 *bytes, compression::CODEC &codec, u32 &originalSize, u32 &storedSize)
+	{
+		codec = static_cast<compression::CODEC>(bytes[0]);
+		originalSize = LoadLittle32(bytes + 1);
+		storedSize = LoadLittle32(bytes + 5);
+	}
+
+	bool Compression::DecodeChunk(compression::CODEC codec, const u8 *bytes, u32 storedSize, u8 *out, u32 originalSize)
+	{
+		if (codec == compression::CODEC_STORED)
+		{
+			if (storedSize != originalSize)
+			{
+				return false;
+			}
+			memcpy(out, bytes, storedSize);
+			return true;
+		}
+		if (codec == compression::CODEC_LZ4)
+		{
+			return Lz4::Decompress(bytes, storedSize, out, originalSize) == static_cast<i32>(originalSize);
+		}
+		return false;
+	}
+
+}
@@ -0,0 +1,155 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: Lz4, Compression
+*Description: LZ4 block codec and a chunked stream format on top of it. Every chunk is
+*compressed on its own, so chunks can be decoded on as many threads as there are to spare,
+*and a chunk that doesn't shrink is stored as is.
+*Author: jkeon
+**********************************/
+
+#ifndef _COMPRESSION_H_
+#define _COMPRESSION_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class ByteArray;
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace compression
+	{
+		//Picked per chunk. END closes a stream so truncation is caught and streams can sit inside
+		//other data.
+		enum CODEC
+		{
+			CODEC_END = 0,
+			CODEC_STORED = 1,
+			CODEC_LZ4 = 2
+		};
+
+		//Everything is little endian. The stream header is the magic, a u16 version, a u16 spare and
+		//the u32 chunk size. Each chunk is a u8 codec, the u32 original size, the u32 stored size and
+		//then the stored bytes.
+		static const u32 MAGIC = 0x4B435A4C;
+		static const u16 VERSION = 1;
+		static const u32 HEADER_SIZE = 12;
+		static const u32 CHUNK_HEADER_SIZE = 9;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	/**
+	 * The LZ4 block format, compatible with the reference implementation's LZ4_compress_default
+	 * and LZ4_decompress_safe. Greedy matching with a small hash table, tuned for speed over ratio.
+	 */
+	class Lz4 {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//The most a block of length bytes can grow to
+		static u32 GetMaxCompressedSize(u32 length);
+		//Returns the compressed length, 0 if it didn't fit in capacity
+		static u32 Compress(const u8 *bytes, u32 length, u8 *out, u32 capacity);
+		//Returns the decompressed length, or -1 for malformed input or input that doesn't fit in capacity
+		static i32 Decompress(const u8 *bytes, u32 length, u8 *out, u32 capacity);
+
+	//PRIVATE FUNCTIONS
+	private:
+		Lz4();
+		Lz4(const Lz4 &other);
+		Lz4& operator = (const Lz4 &other);
+
+	//PUBLIC VARIABLES
+	public:
+		static const u32 MAX_INPUT_SIZE = 0x7E000000;
+
+	};
+
+	class Compression {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//Compresses from in's position to its end into a stream at out's position, moving both. A
+		//growable out grows to fit, a fixed one fails if there isn't room. Chunks are compressed on
+		//up to threadCount threads, counting the calling one.
+		static bool Compress(ByteArray &in, ByteArray &out, u32 chunkSize = DEFAULT_CHUNK_SIZE, u32 threadCount = 1);
+		//Decodes one stream from in's position, writing it at out's position. Neither moves if the
+		//stream is malformed or doesn't fit.
+		static bool Decompress(ByteArray &in, ByteArray &out, u32 threadCount = 1);
+
+		//The chunk building blocks the file streams share
+		static void WriteHeader(u8 *out, u32 chunkSize);
+		//Returns the chunk size, 0 if it isn't a valid header
+		static u32 ReadHeader(const u8 *bytes);
+		static u32 GetMaxChunkSize(u32 length);
+		//Writes the chunk header and body, LZ4 unless that doesn't save anything. Returns the
+		//bytes written, at most GetMaxChunkSize(length).
+		static u32 EncodeChunk(const u8 *bytes, u32 length, u8 *out);
+		static void WriteEndChunk(u8 *out);
+		static void ReadChunkHeader(const u8 *bytes, compression::CODEC &codec, u32 &originalSize, u32 &storedSize);
+		static bool DecodeChunk(compression::CODEC codec, const u8 *bytes, u32 storedSize, u8 *out, u32 originalSize);
+
+	//PRIVATE FUNCTIONS
+	private:
+		Compression();
+		Compression(const Compression &other);
+		Compression& operator = (const Compression &other);
+
+	//PUBLIC VARIABLES
+	public:
+		static const u32 DEFAULT_CHUNK_SIZE = 256 * 1024;
+		static const u32 MAX_CHUNK_SIZE = 16 * 1024 * 1024;
+
+	};
+}
+#endif
@@ -37,6 +37,10 @@ or implied, of Karman Interactive Ltd.
 #include "DebugUtil.h"
 #include <nowide/convert.hpp>
 #include <iostream>
+#include <cstring>
+#include <landan/thread/Atomic.h>
+#include <landan/thread/Thread.h>
+#include <landan/util/BinaryLog.h>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -48,40 +52,334 @@ or implied, of Karman Interactive Ltd.
 
 namespace landan {
 
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	struct DebugUtil::LoggerUser
+	{
+		//Only the owning thread writes this, Stop reads it. Padded out so threads don't share a line.
+		volatile u32 activeCount;
+		//Nonzero while a thread owns the slot
+		volatile u32 owned;
+		LoggerUser *next;
+		u8 padding[64 - 2 * sizeof(u32) - sizeof(LoggerUser*)];
+	};
+
 	//////////////////////////////////////////////////////////////////////
 	// STATICS ///////////////////////////////////////////////////////////
 	//////////////////////////////////////////////////////////////////////
 
-	std::ostringstream DebugUtil::LOGSTREAM;
+	AsyncLogger *DebugUtil::ASYNC_LOGGER = 0;
+	BinaryLogSink *DebugUtil::BINARY_SINK = 0;
+	DebugUtil::LoggerUser *volatile DebugUtil::LOGGER_USERS = 0;
+	LANDAN_THREAD_LOCAL DebugUtil::LoggerUser *DebugUtil::THREAD_USER = 0;
+	volatile u32 DebugUtil::LIFETIME_LOCK = 0;
+	volatile u32 DebugUtil::SWAP_LOCK = 0;
+	u32 DebugUtil::RETAIN_COUNT = 0;
+	bool DebugUtil::RETAINED_LOGGER = false;
+
+	void DebugUtil::PrepLogStream(std::ostringstream &stream, const char* type, const char* file, const char* function, const unsigned long line) 
+	{
+		stream << type << " [" << FileBaseName(file) << " :: " << function << " : " << line << "] - ";
+	}
+
+	void DebugUtil::DeployLogStream(std::ostringstream &stream, u32 level)
+	{
+		string text = stream.str();
+
+		AsyncLogger *logger = AcquireLogger();
+		if (logger != 0)
+		{
+			char record[AsyncLogger::RECORD_SIZE];
+			u32 length = LogRecord::EncodeText(level, text.c_str(), static_cast<u32>(text.length()), record, AsyncLogger::RECORD_SIZE);
+			logger->Push(record, length);
+			ReleaseLogger();
+		}
+		else
+		{
+			WriteOutput(text.c_str(), static_cast<u32>(text.length()));
+		}
+	}
+
+	void DebugUtil::DeployRecord(LogSite *site, const LogArgument *arguments, u32 count)
+	{
+		char record[AsyncLogger::RECORD_SIZE];
+		u32 length = LogRecord::Encode(site, arguments, count, record, AsyncLogger::RECORD_SIZE);
+		if (length == 0)
+		{
+			//Too many or too long arguments, log the site without them
+			length = LogRecord::Encode(site, 0, 0, record, AsyncLogger::RECORD_SIZE);
+		}
+
+		AsyncLogger *logger = AcquireLogger();
+		if (logger != 0)
+		{
+			logger->Push(record, length);
+			ReleaseLogger();
+		}
+		else
+		{
+			char text[AsyncLogger::RECORD_SIZE];
+			WriteOutput(text, LogRecord::Render(record, length, text, AsyncLogger::RECORD_SIZE));
+		}
+	}
+
+	const char* DebugUtil::FileBaseName(const char *path)
+	{
+		const char *baseName = path;
+		for (const char *c = path; *c != 0; c++)
+		{
+			if (*c == '/' || *c == '\\')
+			{
+				baseName = c + 1;
+			}
+		}
+		return baseName;
+	}
+
+	bool DebugUtil::StartAsyncLogging(u32 capacity, logging::OVERFLOW_POLICY policy)
+	{
+		LockSwap();
+		if (ASYNC_LOGGER != 0)
+		{
+			UnlockSwap();
+			return false;
+		}
+
+		AsyncLogger *logger = new AsyncLogger(FREE_FUNCTION(&DebugUtil::WriteOutput), capacity, policy);
+		logger->SetRenderer(FREE_FUNCTION(&DebugUtil::RenderRecord));
+		bool published = PublishLogger(logger);
+		UnlockSwap();
+		return published;
+	}
+
+	bool DebugUtil::StartBinaryLogging(const string &path, u64 maxFileBytes, u32 maxFiles, u32 capacity, logging::OVERFLOW_POLICY policy)
+	{
+		LockSwap();
+		//Replaces text logging if it's running, e.g. the one the scaffold starts
+		StopLogger();
+
+		BinaryLogSink *sink = new BinaryLogSink(path, maxFileBytes, maxFiles);
+		if (!sink->Open())
+		{
+			delete sink;
+			UnlockSwap();
+			return false;
+		}
+
+		AsyncLogger *logger = new AsyncLogger(MEMBER_FUNCTION(&BinaryLogSink::Write, sink), capacity, policy);
+		logger->SetRenderer(MEMBER_FUNCTION(&BinaryLogSink::Frame, sink));
+		if (!PublishLogger(logger))
+		{
+			delete sink;
+			UnlockSwap();
+			return false;
+		}
+		BINARY_SINK = sink;
+		UnlockSwap();
+		return true;
+	}
+
+	void DebugUtil::StopAsyncLogging()
+	{
+		LockSwap();
+		StopLogger();
+		UnlockSwap();
+	}
+
+	bool DebugUtil::IsAsyncLogging()
+	{
+		return AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&ASYNC_LOGGER)) != 0;
+	}
+
+	void DebugUtil::FlushLog()
+	{
+		AsyncLogger *logger = AcquireLogger();
+		if (logger != 0)
+		{
+			logger->Flush();
+			ReleaseLogger();
+		}
+	}
+
+	void DebugUtil::RetainAsyncLogging()
+	{
+		while (AtomicCompareExchange(&LIFETIME_LOCK, 1u, 0u) != 0)
+		{
+			Thread::YieldThread();
+		}
+		if (RETAIN_COUNT++ == 0 && AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&ASYNC_LOGGER)) == 0)
+		{
+			RETAINED_LOGGER = StartAsyncLogging();
+		}
+		AtomicStoreRelease(&LIFETIME_LOCK, 0);
+	}
+
+	void DebugUtil::ReleaseAsyncLogging()
+	{
+		while (AtomicCompareExchange(&LIFETIME_LOCK, 1u, 0u) != 0)
+		{
+			Thread::YieldThread();
+		}
+		if (RETAIN_COUNT != 0 && --RETAIN_COUNT == 0 && RETAINED_LOGGER)
+		{
+			StopAsyncLogging();
+		}
+		AtomicStoreRelease(&LIFETIME_LOCK, 0);
+	}
 
+	bool DebugUtil::PublishLogger(AsyncLogger *logger)
+	{
+		if (!logger->Start())
+		{
+			delete logger;
+			return false;
+		}
+		if (AtomicCompareExchangePointer(reinterpret_cast<void *volatile *>(&ASYNC_LOGGER), logger, 0) != 0)
+		{
+			//Lost to another logger, nobody can have pushed to this one yet
+			delete logger;
+			return false;
+		}
+		return true;
+	}
 
-	void DebugUtil::PrepLogStream(const char* type, const char* file, const char* function, const unsigned long line) 
+	void DebugUtil::StopLogger()
 	{
-		string formattedFile;
-		formattedFile.append(file);
+		//Route new lines back to synchronous output first, then drain what's queued
+		AsyncLogger *logger = static_cast<AsyncLogger*>(AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&ASYNC_LOGGER)));
+		if (logger == 0)
+		{
+			return;
+		}
+		//Only whoever actually cleared the pointer owns the logger and its sink
+		if (AtomicCompareExchangePointer(reinterpret_cast<void *volatile *>(&ASYNC_LOGGER), 0, logger) != logger)
+		{
+			return;
+		}
 
-		size_t c1 = formattedFile.find_last_of('\\');
-		size_t c2 = formattedFile.find_last_of('/');
-		(c2 > formattedFile.length()) ? (c2 = 0) : c2;
-		size_t index = (c1 > c2) ? c1 : c2;
+		//Anyone who loaded the pointer before it was cleared is still marked active, wait them out before freeing it
+		LoggerUser *user = static_cast<LoggerUser*>(AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&LOGGER_USERS)));
+		while (user != 0)
+		{
+			while (AtomicLoadAcquire(&user->activeCount) != 0)
+			{
+				Thread::YieldThread();
+			}
+			user = user->next;
+		}
+		delete logger;
 
-		DebugUtil::LOGSTREAM << type << " [" << formattedFile.substr(index+1) << " :: " << function << " : " << line << "] - ";
+		if (BINARY_SINK != 0)
+		{
+			delete BINARY_SINK;
+			BINARY_SINK = 0;
+		}
+		RETAINED_LOGGER = false;
+	}
+
+	void DebugUtil::LockSwap()
+	{
+		while (AtomicCompareExchange(&SWAP_LOCK, 1u, 0u) != 0)
+		{
+			Thread::YieldThread();
+		}
+	}
+
+	void DebugUtil::UnlockSwap()
+	{
+		AtomicStoreRelease(&SWAP_LOCK, 0);
+	}
+
+	AsyncLogger* DebugUtil::AcquireLogger()
+	{
+		//Marked before the load, both this and the exchange in Stop are full barriers so Stop either
+		//sees the mark or this sees the cleared pointer. The add only ever touches this thread's line.
+		LoggerUser *user = GetLoggerUser();
+		AtomicFetchAdd(&user->activeCount, 1);
+		AsyncLogger *logger = static_cast<AsyncLogger*>(AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&ASYNC_LOGGER)));
+		if (logger == 0)
+		{
+			ReleaseLogger();
+		}
+		return logger;
+	}
+
+	void DebugUtil::ReleaseLogger()
+	{
+		LoggerUser *user = THREAD_USER;
+		AtomicStoreRelease(&user->activeCount, user->activeCount - 1);
+	}
+
+	DebugUtil::LoggerUser* DebugUtil::GetLoggerUser()
+	{
+		if (THREAD_USER != 0)
+		{
+			return THREAD_USER;
+		}
+
+		//First log on this thread, take over a slot left behind by a thread that has exited
+		LoggerUser *user = static_cast<LoggerUser*>(AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&LOGGER_USERS)));
+		while (user != 0)
+		{
+			if (AtomicLoadAcquire(&user->owned) == 0 && AtomicCompareExchange(&user->owned, 1u, 0u) == 0)
+			{
+				THREAD_USER = user;
+				return user;
+			}
+			user = user->next;
+		}
+
+		//Slots live as long as the process so Stop can always walk the list
+		user = new LoggerUser();
+		user->activeCount = 0;
+		user->owned = 1;
+		void *head;
+		do
+		{
+			head = AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&LOGGER_USERS));
+			user->next = static_cast<LoggerUser*>(head);
+		} while (AtomicCompareExchangePointer(reinterpret_cast<void *volatile *>(&LOGGER_USERS), user, head) != head);
+
+		THREAD_USER = user;
+		return user;
+	}
+
+	void DebugUtil::ReleaseThread()
+	{
+		LoggerUser *user = THREAD_USER;
+		if (user == 0)
+		{
+			return;
+		}
+
+		THREAD_USER = 0;
+		AtomicStoreRelease(&user->owned, 0);
+	}
+
+	u32 DebugUtil::RenderRecord(const char *record, u32 length, char *out, u32 capacity)
+	{
+		if (LogRecord::IsEncoded(record, length))
+		{
+			return LogRecord::Render(record, length, out, capacity);
+		}
+		memcpy(out, record, length);
+		return length;
 	}
 
 #ifdef _MSC_VER
-	void DebugUtil::DeployLogStream() {
-		OutputDebugStringW(nowide::widen(DebugUtil::LOGSTREAM.str()).c_str());
-		//Necessary to prevent leaks
-		DebugUtil::LOGSTREAM.str("");
+	void DebugUtil::WriteOutput(const char *text, u32 length)
+	{
+		OutputDebugStringW(nowide::widen(string(text, length)).c_str());
 	}
 #else
-	void DebugUtil::DeployLogStream() {
-		std::cout << DebugUtil::LOGSTREAM.str() << std::endl;
-		//Necessary to prevent leaks
-		DebugUtil::LOGSTREAM.str("");
+	void DebugUtil::WriteOutput(const char *text, u32 length)
+	{
+		//One flush per call, with the async logger that's one per batch rather than one per line
+		std::cout.write(text, length);
+		std::cout.flush();
 	}
 #endif
 
-
-
 }
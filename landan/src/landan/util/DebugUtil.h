@@ -44,6 +44,9 @@ or implied, of Karman Interactive Ltd.
 //////////////////////////////////////////////////////////////////////
 
 #include <landan/core/LandanTypes.h>
+#include <landan/thread/ThreadLocal.h>
+#include <landan/util/AsyncLogger.h>
+#include <landan/util/LogRecord.h>
 #include <sstream>
 
 //////////////////////////////////////////////////////////////////////
@@ -51,24 +54,112 @@ or implied, of Karman Interactive Ltd.
 //////////////////////////////////////////////////////////////////////
 
 
-#ifndef NDEBUG
-
-#define LOG_ERROR(message) \
-	landan::DebugUtil::PrepLogStream("ERROR", __FILE__, __FUNCTION__, __LINE__); \
-	landan::DebugUtil::LOGSTREAM << message << std::endl; \
-	landan::DebugUtil::DeployLogStream();
-#define LOG_DEBUG(message) \
-	landan::DebugUtil::PrepLogStream("DEBUG", __FILE__, __FUNCTION__, __LINE__); \
-	landan::DebugUtil::LOGSTREAM << message << std::endl; \
-	landan::DebugUtil::DeployLogStream();
-#define LOG_INFO(message) \
-	landan::DebugUtil::PrepLogStream("INFO", __FILE__, __FUNCTION__, __LINE__); \
-	landan::DebugUtil::LOGSTREAM << message << std::endl; \
-	landan::DebugUtil::DeployLogStream();
+//Compile time thresholds, anything above LANDAN_LOG_LEVEL compiles to nothing.
+//Defaults to everything in debug builds and nothing with NDEBUG, define it to override.
+#define LANDAN_LOG_LEVEL_NONE 0
+#define LANDAN_LOG_LEVEL_ERROR 1
+#define LANDAN_LOG_LEVEL_INFO 2
+#define LANDAN_LOG_LEVEL_DEBUG 3
+
+#ifndef LANDAN_LOG_LEVEL
+#ifdef NDEBUG
+#define LANDAN_LOG_LEVEL LANDAN_LOG_LEVEL_NONE
+#else
+#define LANDAN_LOG_LEVEL LANDAN_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+//Each call formats into its own stream so logging is safe from any thread
+#define LANDAN_LOG(level, type, message) \
+	do { \
+		std::ostringstream landanLogStream; \
+		landan::DebugUtil::PrepLogStream(landanLogStream, type, __FILE__, __FUNCTION__, __LINE__); \
+		landanLogStream << message << '\n'; \
+		landan::DebugUtil::DeployLogStream(landanLogStream, level); \
+	} while (0)
+
+//Deferred formatting, the call site only records its site ID and raw arguments, each {} in the
+//format is replaced by the next argument when the writer renders the line
+//The arguments are built inside the DeployRecord call so temporaries live until they're encoded
+#define LANDAN_LOG_SITE(level, type, format) \
+	static landan::LogSite landanLogSite = { level, type, __FILE__, __FUNCTION__, __LINE__, format, 0 }
+
+#define LANDAN_LOGF0(level, type, format) \
+	do { \
+		LANDAN_LOG_SITE(level, type, format); \
+		landan::DebugUtil::DeployRecord(&landanLogSite, 0, 0); \
+	} while (0)
+
+#define LANDAN_LOGF1(level, type, format, a0) \
+	do { \
+		LANDAN_LOG_SITE(level, type, format); \
+		landan::DebugUtil::DeployRecord(&landanLogSite, landan::LogArgumentList(landan::MakeLogArgument(a0)).values, 1); \
+	} while (0)
+
+#define LANDAN_LOGF2(level, type, format, a0, a1) \
+	do { \
+		LANDAN_LOG_SITE(level, type, format); \
+		landan::DebugUtil::DeployRecord(&landanLogSite, landan::LogArgumentList(landan::MakeLogArgument(a0), landan::MakeLogArgument(a1)).values, 2); \
+	} while (0)
+
+#define LANDAN_LOGF3(level, type, format, a0, a1, a2) \
+	do { \
+		LANDAN_LOG_SITE(level, type, format); \
+		landan::DebugUtil::DeployRecord(&landanLogSite, landan::LogArgumentList(landan::MakeLogArgument(a0), landan::MakeLogArgument(a1), landan::MakeLogArgument(a2)).values, 3); \
+	} while (0)
+
+#define LANDAN_LOGF4(level, type, format, a0, a1, a2, a3) \
+	do { \
+		LANDAN_LOG_SITE(level, type, format); \
+		landan::DebugUtil::DeployRecord(&landanLogSite, landan::LogArgumentList(landan::MakeLogArgument(a0), landan::MakeLogArgument(a1), landan::MakeLogArgument(a2), landan::MakeLogArgument(a3)).values, 4); \
+	} while (0)
+
+#if LANDAN_LOG_LEVEL >= LANDAN_LOG_LEVEL_ERROR
+#define LOG_ERROR(message) LANDAN_LOG(LANDAN_LOG_LEVEL_ERROR, "ERROR", message)
+#define LOG_ERRORF(format) LANDAN_LOGF0(LANDAN_LOG_LEVEL_ERROR, "ERROR", format)
+#define LOG_ERRORF1(format, a0) LANDAN_LOGF1(LANDAN_LOG_LEVEL_ERROR, "ERROR", format, a0)
+#define LOG_ERRORF2(format, a0, a1) LANDAN_LOGF2(LANDAN_LOG_LEVEL_ERROR, "ERROR", format, a0, a1)
+#define LOG_ERRORF3(format, a0, a1, a2) LANDAN_LOGF3(LANDAN_LOG_LEVEL_ERROR, "ERROR", format, a0, a1, a2)
+#define LOG_ERRORF4(format, a0, a1, a2, a3) LANDAN_LOGF4(LANDAN_LOG_LEVEL_ERROR, "ERROR", format, a0, a1, a2, a3)
+#else
+#define LOG_ERROR(message)
+#define LOG_ERRORF(format)
+#define LOG_ERRORF1(format, a0)
+#define LOG_ERRORF2(format, a0, a1)
+#define LOG_ERRORF3(format, a0, a1, a2)
+#define LOG_ERRORF4(format, a0, a1, a2, a3)
+#endif
+
+#if LANDAN_LOG_LEVEL >= LANDAN_LOG_LEVEL_INFO
+#define LOG_INFO(message) LANDAN_LOG(LANDAN_LOG_LEVEL_INFO, "INFO", message)
+#define LOG_INFOF(format) LANDAN_LOGF0(LANDAN_LOG_LEVEL_INFO, "INFO", format)
+#define LOG_INFOF1(format, a0) LANDAN_LOGF1(LANDAN_LOG_LEVEL_INFO, "INFO", format, a0)
+#define LOG_INFOF2(format, a0, a1) LANDAN_LOGF2(LANDAN_LOG_LEVEL_INFO, "INFO", format, a0, a1)
+#define LOG_INFOF3(format, a0, a1, a2) LANDAN_LOGF3(LANDAN_LOG_LEVEL_INFO, "INFO", format, a0, a1, a2)
+#define LOG_INFOF4(format, a0, a1, a2, a3) LANDAN_LOGF4(LANDAN_LOG_LEVEL_INFO, "INFO", format, a0, a1, a2, a3)
 #else
-#define LOG_ERROR(message) 
-#define LOG_DEBUG(message)
 #define LOG_INFO(message)
+#define LOG_INFOF(format)
+#define LOG_INFOF1(format, a0)
+#define LOG_INFOF2(format, a0, a1)
+#define LOG_INFOF3(format, a0, a1, a2)
+#define LOG_INFOF4(format, a0, a1, a2, a3)
+#endif
+
+#if LANDAN_LOG_LEVEL >= LANDAN_LOG_LEVEL_DEBUG
+#define LOG_DEBUG(message) LANDAN_LOG(LANDAN_LOG_LEVEL_DEBUG, "DEBUG", message)
+#define LOG_DEBUGF(format) LANDAN_LOGF0(LANDAN_LOG_LEVEL_DEBUG, "DEBUG", format)
+#define LOG_DEBUGF1(format, a0) LANDAN_LOGF1(LANDAN_LOG_LEVEL_DEBUG, "DEBUG", format, a0)
+#define LOG_DEBUGF2(format, a0, a1) LANDAN_LOGF2(LANDAN_LOG_LEVEL_DEBUG, "DEBUG", format, a0, a1)
+#define LOG_DEBUGF3(format, a0, a1, a2) LANDAN_LOGF3(LANDAN_LOG_LEVEL_DEBUG, "DEBUG", format, a0, a1, a2)
+#define LOG_DEBUGF4(format, a0, a1, a2, a3) LANDAN_LOGF4(LANDAN_LOG_LEVEL_DEBUG, "DEBUG", format, a0, a1, a2, a3)
+#else
+#define LOG_DEBUG(message)
+#define LOG_DEBUGF(format)
+#define LOG_DEBUGF1(format, a0)
+#define LOG_DEBUGF2(format, a0, a1)
+#define LOG_DEBUGF3(format, a0, a1, a2)
+#define LOG_DEBUGF4(format, a0, a1, a2, a3)
 #endif
 
 
@@ -77,6 +168,12 @@ or implied, of Karman Interactive Ltd.
 //////////////////////////////////////////////////////////////////////
 
 namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// FORWARD DECLARATIONS //////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class BinaryLogSink;
 	
 
 	//////////////////////////////////////////////////////////////////////
@@ -87,12 +184,62 @@ namespace landan {
 
 		//PUBLIC FUNCTIONS
 		public:
-			static void PrepLogStream(const char *type, const char *file, const char *function, const unsigned long line);
-			static void DeployLogStream();
-
-		//PUBLIC VARIABLES
-		public:
-			static std::ostringstream LOGSTREAM;
+			static void PrepLogStream(std::ostringstream &stream, const char *type, const char *file, const char *function, const unsigned long line);
+			static void DeployLogStream(std::ostringstream &stream, u32 level);
+			static void DeployRecord(LogSite *site, const LogArgument *arguments, u32 count);
+
+			//Points past the last path separator, no allocation
+			static const char* FileBaseName(const char *path);
+
+			//Hands log output to a background writer, until this is called every log line is written synchronously.
+			//Stop flushes whatever is queued and waits out any thread still pushing, lines logged after it go out synchronously.
+			static bool StartAsyncLogging(u32 capacity = 4096, logging::OVERFLOW_POLICY policy = logging::DROP);
+			//Same as StartAsyncLogging but records are written unformatted to a rotating binary file,
+			//see BinaryLogDecoder for turning it back into text
+			static bool StartBinaryLogging(const string &path, u64 maxFileBytes = 64 * 1024 * 1024, u32 maxFiles = 4, u32 capacity = 4096, logging::OVERFLOW_POLICY policy = logging::DROP);
+			static void StopAsyncLogging();
+			static bool IsAsyncLogging();
+			static void FlushLog();
+
+			//Shared ownership of the process wide text logger for code that comes and goes, e.g. each ApplicationScaffold.
+			//The first retain starts it and the last release stops it, a logger started directly is left alone.
+			static void RetainAsyncLogging();
+			static void ReleaseAsyncLogging();
+
+			//Hands this thread's logger slot back for the next new thread to reuse. Thread does this on exit,
+			//threads started any other way keep theirs.
+			static void ReleaseThread();
+
+			//Platform output, the debugger on Visual Studio and stdout elsewhere
+			static void WriteOutput(const char *text, u32 length);
+
+		//PRIVATE FUNCTIONS
+		private:
+			static u32 RenderRecord(const char *record, u32 length, char *out, u32 capacity);
+			static bool PublishLogger(AsyncLogger *logger);
+			//Clears, drains and frees the published logger and its sink, the caller holds the swap lock
+			static void StopLogger();
+			//Serialises starting and stopping so only one caller ever publishes or frees a logger.
+			//RetainAsyncLogging takes it while holding LIFETIME_LOCK, never the other way round.
+			static void LockSwap();
+			static void UnlockSwap();
+			//Pins the published logger so Stop can't delete it mid push, every non null acquire needs a release.
+			//Each thread marks its own slot rather than a shared count, Stop scans them all.
+			static AsyncLogger* AcquireLogger();
+			static void ReleaseLogger();
+			struct LoggerUser;
+			static LoggerUser* GetLoggerUser();
+
+		//PRIVATE VARIABLES
+		private:
+			static AsyncLogger *ASYNC_LOGGER;
+			static BinaryLogSink *BINARY_SINK;
+			static LoggerUser *volatile LOGGER_USERS;
+			static LANDAN_THREAD_LOCAL LoggerUser *THREAD_USER;
+			static volatile u32 LIFETIME_LOCK;
+			static volatile u32 SWAP_LOCK;
+			static u32 RETAIN_COUNT;
+			static bool RETAINED_LOGGER;
 	
 	};
 
@@ -39,6 +39,24 @@ or implied, of Karman Interactive Ltd.
 #ifndef _ENDIANUTIL_H_
 #define _ENDIANUTIL_H_
 
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/util/ByteSwap.h>
+#include <cstddef>
+#include <cstring>
+#ifdef _MSC_VER
+	#include <stdlib.h>
+#endif
+
+//glibc's <endian.h> defines these as macros, which would clobber the enum below
+#ifndef _WIN32
+#undef LITTLE_ENDIAN
+#undef BIG_ENDIAN
+#endif
+
 //////////////////////////////////////////////////////////////////////
 // NAMESPACE /////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
@@ -79,6 +97,14 @@ namespace endian
 		LITTLE_ENDIAN = 0,
 		BIG_ENDIAN = 1
 	};
+
+	//Known at compile time so it can be used as a template argument. GCC and Clang report the byte
+	//order themselves, every MSVC target but the PowerPC consoles is little endian.
+#if (defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__) || defined(_M_PPC)
+	static const ENDIAN_TYPE SYSTEM_ENDIAN = BIG_ENDIAN;
+#else
+	static const ENDIAN_TYPE SYSTEM_ENDIAN = LITTLE_ENDIAN;
+#endif
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -87,86 +113,117 @@ namespace endian
 
 inline endian::ENDIAN_TYPE DetermineSystemEndianess()
 {
-	CHAR16_AS_SHORT swapper;
-	swapper.cValue[0] = 1;
-	swapper.cValue[1] = 0;
-	short value = swapper.sValue;
-	if (value == 1)
-	{
-		return endian::LITTLE_ENDIAN;
-	}
-	else
-	{
-		return endian::BIG_ENDIAN;
-	}
+	return endian::SYSTEM_ENDIAN;
 }
 
 inline u16 SwapUInt16(u16 value)
 {
-	//Swap the Bytes by extracting the bytes needed shifting them to the desired location and then stiching them together with an OR
-	return ((value & 0xFF00) >> 8) | ((value & 0x00FF) << 8);
+#if defined(_MSC_VER)
+	return _byteswap_ushort(value);
+#elif defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+	return __builtin_bswap16(value);
+#else
+	return static_cast<u16>((value >> 8) | (value << 8));
+#endif
 }
 
 inline u32 SwapUInt32(u32 value)
 {
-	//Swap the Bytes by extracting the bytes needed shifting them to the desired location and then stiching them together with an OR
+#if defined(_MSC_VER)
+	return _byteswap_ulong(value);
+#elif defined(__GNUC__)
+	return __builtin_bswap32(value);
+#else
 	return ((value & 0xFF000000) >> 24) | ((value & 0x000000FF) << 24)
 			| ((value & 0x00FF0000) >> 8) | ((value & 0x0000FF00) << 8);
+#endif
 }
 
 inline u64 SwapUInt64(u64 value)
 {
-	//Swap the Bytes by extracting the bytes needed shifting them to the desired location and then stiching them together with an OR
-	return ((value & 0xFF00000000000000) >> 56)
-			| ((value & 0x00000000000000FF) << 56)
-			| ((value & 0x00FF000000000000) >> 40)
-			| ((value & 0x000000000000FF00) << 40)
-			| ((value & 0x0000FF0000000000) >> 24)
-			| ((value & 0x0000000000FF0000) << 24)
-			| ((value & 0x000000FF00000000) >> 8)
-			| ((value & 0x00000000FF000000) << 8);
+#if defined(_MSC_VER)
+	return _byteswap_uint64(value);
+#elif defined(__GNUC__)
+	return __builtin_bswap64(value);
+#else
+	return (static_cast<u64>(SwapUInt32(static_cast<u32>(value))) << 32) | SwapUInt32(static_cast<u32>(value >> 32));
+#endif
 }
 
 inline i16 SwapInt16(i16 value)
 {
-	//Swap the Bytes by extracting the bytes needed shifting them to the desired location and then stiching them together with an OR
-	return ((value & 0xFF00) >> 8) | ((value & 0x00FF) << 8);
+	return static_cast<i16>(SwapUInt16(static_cast<u16>(value)));
 }
 
 inline i32 SwapInt32(i32 value)
 {
-	//Swap the Bytes by extracting the bytes needed shifting them to the desired location and then stiching them together with an OR
-	return ((value & 0xFF000000) >> 24) | ((value & 0x000000FF) << 24)
-			| ((value & 0x00FF0000) >> 8) | ((value & 0x0000FF00) << 8);
+	return static_cast<i32>(SwapUInt32(static_cast<u32>(value)));
 }
 
 inline i64 SwapInt64(i64 value)
 {
-	//Swap the Bytes by extracting the bytes needed shifting them to the desired location and then stiching them together with an OR
-	return ((value & 0xFF00000000000000) >> 56)
-			| ((value & 0x00000000000000FF) << 56)
-			| ((value & 0x00FF000000000000) >> 40)
-			| ((value & 0x000000000000FF00) << 40)
-			| ((value & 0x0000FF0000000000) >> 24)
-			| ((value & 0x0000000000FF0000) << 24)
-			| ((value & 0x000000FF00000000) >> 8)
-			| ((value & 0x00000000FF000000) << 8);
+	return static_cast<i64>(SwapUInt64(static_cast<u64>(value)));
 }
 
+//memcpy rather than a union so it's well defined, compilers turn it into a register move
 inline f32 SwapFloat32(f32 value)
 {
-	F32_AS_U32 swapper;
-	swapper.fValue = value;
-	swapper.uValue = SwapUInt32(swapper.uValue);
-	return swapper.fValue;
+	u32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	bits = SwapUInt32(bits);
+	memcpy(&value, &bits, sizeof(bits));
+	return value;
 }
 
 inline f64 SwapFloat64(f64 value)
 {
-	F64_AS_U64 swapper;
-	swapper.fValue = value;
-	swapper.uValue = SwapUInt64(swapper.uValue);
-	return swapper.fValue;
+	u64 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	bits = SwapUInt64(bits);
+	memcpy(&value, &bits, sizeof(bits));
+	return value;
+}
+
+//Swap whole buffers in place, through the vector kernels in ByteSwap. Chunked so each call's byte
+//count still fits in a u32
+inline void SwapUInt16Buffer(u16 *values, size_t count)
+{
+	const size_t chunk = 0xFFFFFFFF / sizeof(u16);
+	for (; count > chunk; count -= chunk, values += chunk)
+	{
+		ByteSwap::Copy16(values, values, static_cast<u32>(chunk));
+	}
+	ByteSwap::Copy16(values, values, static_cast<u32>(count));
+}
+
+inline void SwapUInt32Buffer(u32 *values, size_t count)
+{
+	const size_t chunk = 0xFFFFFFFF / sizeof(u32);
+	for (; count > chunk; count -= chunk, values += chunk)
+	{
+		ByteSwap::Copy32(values, values, static_cast<u32>(chunk));
+	}
+	ByteSwap::Copy32(values, values, static_cast<u32>(count));
+}
+
+inline void SwapUInt64Buffer(u64 *values, size_t count)
+{
+	const size_t chunk = 0xFFFFFFFF / sizeof(u64);
+	for (; count > chunk; count -= chunk, values += chunk)
+	{
+		ByteSwap::Copy64(values, values, static_cast<u32>(chunk));
+	}
+	ByteSwap::Copy64(values, values, static_cast<u32>(count));
+}
+
+inline void SwapFloat32Buffer(f32 *values, size_t count)
+{
+	SwapUInt32Buffer(reinterpret_cast<u32*>(values), count);
+}
+
+inline void SwapFloat64Buffer(f64 *values, size_t count)
+{
+	SwapUInt64Buffer(reinterpret_cast<u64*>(values), count);
 }
 
 }
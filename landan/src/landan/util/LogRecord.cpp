@@ -0,0 +1,345 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "LogRecord.h"
+#include <cstring>
+#include <sstream>
+#include <landan/thread/Atomic.h>
+#include <landan/util/DebugUtil.h>
+#include <landan/thread/Thread.h>
+#include <landan/timer/Timer.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	//Slot 0 is never used so an ID of 0 can mean unregistered
+	LogSite *volatile LogRecord::SITES[LogRecord::MAX_SITES] = {0};
+	volatile u32 LogRecord::SITE_COUNT = 1;
+
+	//Record layout, native endian since it never leaves the process
+	//u8 marker (0), u8 level, u8 argument count, u32 site ID, u32 thread ID, u64 ticks, then per argument
+	//a u8 type followed by 8 bytes of value, or a u16 length and the bytes for strings.
+	//Text records have a site ID of 0 and the text follows the header.
+
+	static void WriteHeader(char *out, u32 level, u32 count, u32 siteId)
+	{
+		u32 threadId = Thread::GetCurrentId();
+		u64 ticks = Timer::GetTicks();
+		out[0] = 0;
+		out[1] = static_cast<char>(level);
+		out[2] = static_cast<char>(count);
+		memcpy(out + 3, &siteId, sizeof(u32));
+		memcpy(out + 7, &threadId, sizeof(u32));
+		memcpy(out + 11, &ticks, sizeof(u64));
+	}
+
+	LogArgument MakeLogArgument(const char *value)
+	{
+		LogArgument argument;
+		argument.type = logging::ARGUMENT_STRING;
+		argument.value.s = (value != 0) ? value : "(null)";
+		argument.length = static_cast<u32>(strlen(argument.value.s));
+		return argument;
+	}
+
+	LogArgument MakeLogArgument(const string &value)
+	{
+		LogArgument argument;
+		argument.type = logging::ARGUMENT_STRING;
+		argument.value.s = value.c_str();
+		argument.length = static_cast<u32>(value.length());
+		return argument;
+	}
+
+	u32 LogRecord::Encode(LogSite *site, const LogArgument *arguments, u32 count, char *out, u32 capacity)
+	{
+		u32 id = AtomicLoadAcquire(&site->id);
+		if (id == 0)
+		{
+			id = RegisterSite(site);
+		}
+
+		if (capacity < HEADER_SIZE || count > MAX_ARGUMENTS)
+		{
+			return 0;
+		}
+
+		WriteHeader(out, site->level, count, id);
+		u32 position = HEADER_SIZE;
+
+		for (u32 i = 0; i < count; i++)
+		{
+			const LogArgument &argument = arguments[i];
+			if (argument.type == logging::ARGUMENT_STRING)
+			{
+				u16 length = static_cast<u16>((argument.length > MAX_STRING_LENGTH) ? MAX_STRING_LENGTH : argument.length);
+				if (position + 3 + length > capacity)
+				{
+					return 0;
+				}
+				out[position] = static_cast<char>(argument.type);
+				memcpy(out + position + 1, &length, sizeof(u16));
+				memcpy(out + position + 3, argument.value.s, length);
+				position += 3 + length;
+			}
+			else
+			{
+				if (position + 9 > capacity)
+				{
+					return 0;
+				}
+				out[position] = static_cast<char>(argument.type);
+				memcpy(out + position + 1, &argument.value, 8);
+				position += 9;
+			}
+		}
+		return position;
+	}
+
+	u32 LogRecord::EncodeText(u32 level, const char *text, u32 length, char *out, u32 capacity)
+	{
+		if (capacity < HEADER_SIZE + 4)
+		{
+			return 0;
+		}
+
+		WriteHeader(out, level, 0, 0);
+		u32 room = capacity - HEADER_SIZE;
+		if (length > room)
+		{
+			memcpy(out + HEADER_SIZE, text, room - 4);
+			memcpy(out + capacity - 4, "...\n", 4);
+			return capacity;
+		}
+		memcpy(out + HEADER_SIZE, text, length);
+		return HEADER_SIZE + length;
+	}
+
+	bool LogRecord::IsEncoded(const char *record, u32 length)
+	{
+		return length >= HEADER_SIZE && record[0] == 0;
+	}
+
+	bool LogRecord::DecodeHeader(const char *record, u32 length, LogRecordHeader &header)
+	{
+		if (!IsEncoded(record, length))
+		{
+			return false;
+		}
+		header.level = static_cast<u8>(record[1]);
+		header.count = static_cast<u8>(record[2]);
+		memcpy(&header.siteId, record + 3, sizeof(u32));
+		memcpy(&header.threadId, record + 7, sizeof(u32));
+		memcpy(&header.ticks, record + 11, sizeof(u64));
+		return true;
+	}
+
+	u32 LogRecord::DecodeArguments(const char *record, u32 length, LogArgument *arguments, u32 maxCount)
+	{
+		u32 count = static_cast<u8>(record[2]);
+		count = (count > maxCount) ? maxCount : count;
+
+		u32 position = HEADER_SIZE;
+		for (u32 i = 0; i < count; i++)
+		{
+			if (position + 1 > length)
+			{
+				return i;
+			}
+			LogArgument &argument = arguments[i];
+			argument.type = static_cast<logging::ARGUMENT_TYPE>(record[position]);
+			if (argument.type == logging::ARGUMENT_STRING)
+			{
+				u16 stringLength;
+				if (position + 3 > length)
+				{
+					return i;
+				}
+				memcpy(&stringLength, record + position + 1, sizeof(u16));
+				if (position + 3 + stringLength > length)
+				{
+					return i;
+				}
+				argument.value.s = record + position + 3;
+				argument.length = stringLength;
+				position += 3 + stringLength;
+			}
+			else
+			{
+				if (position + 9 > length)
+				{
+					return i;
+				}
+				memcpy(&argument.value, record + position + 1, 8);
+				argument.length = 8;
+				position += 9;
+			}
+		}
+		return count;
+	}
+
+	const char* LogRecord::DecodeText(const char *record, u32 length, u32 &textLength)
+	{
+		textLength = length - HEADER_SIZE;
+		return record + HEADER_SIZE;
+	}
+
+	u32 LogRecord::Render(const char *record, u32 length, char *out, u32 capacity)
+	{
+		LogRecordHeader header;
+		if (!DecodeHeader(record, length, header))
+		{
+			return 0;
+		}
+
+		if (header.siteId == 0)
+		{
+			u32 textLength;
+			const char *text = DecodeText(record, length, textLength);
+			textLength = (textLength > capacity) ? capacity : textLength;
+			memcpy(out, text, textLength);
+			return textLength;
+		}
+
+		std::ostringstream stream;
+		LogSite *site = GetSite(header.siteId);
+		if (header.siteId == UNREGISTERED_SITE)
+		{
+			stream << "UNKNOWN [unregistered site] - \n";
+		}
+		else if (site == 0)
+		{
+			stream << "UNKNOWN [site " << header.siteId << "] - \n";
+		}
+		else
+		{
+			LogArgument arguments[MAX_ARGUMENTS];
+			u32 count = DecodeArguments(record, length, arguments, MAX_ARGUMENTS);
+
+			DebugUtil::PrepLogStream(stream, site->type, site->file, site->function, site->line);
+			WriteFormatted(stream, site->format, arguments, count);
+			stream << '\n';
+		}
+
+		string text = stream.str();
+		u32 textLength = static_cast<u32>(text.length());
+		if (textLength > capacity)
+		{
+			memcpy(out, text.c_str(), capacity - 4);
+			memcpy(out + capacity - 4, "...\n", 4);
+			return capacity;
+		}
+		memcpy(out, text.c_str(), textLength);
+		return textLength;
+	}
+
+	void LogRecord::WriteFormatted(std::ostream &stream, const char *format, const LogArgument *arguments, u32 count)
+	{
+		for (u32 i = 0; i < count; i++)
+		{
+			const char *placeholder = strstr(format, "{}");
+			if (placeholder == 0)
+			{
+				break;
+			}
+			stream.write(format, placeholder - format);
+			format = placeholder + 2;
+
+			const LogArgument &argument = arguments[i];
+			switch (argument.type)
+			{
+				case logging::ARGUMENT_SIGNED:
+					stream << argument.value.i;
+					break;
+				case logging::ARGUMENT_UNSIGNED:
+					stream << argument.value.u;
+					break;
+				case logging::ARGUMENT_FLOAT:
+					stream << argument.value.f;
+					break;
+				default:
+					stream.write(argument.value.s, argument.length);
+					break;
+			}
+		}
+		stream << format;
+	}
+
+	u32 LogRecord::RegisterSite(LogSite *site)
+	{
+		u32 id = AtomicLoadAcquire(&site->id);
+		if (id != 0)
+		{
+			return id;
+		}
+
+		//Two threads can race to register the same site, the loser's slot just goes unused
+		u32 claimed = (AtomicLoadAcquire(&SITE_COUNT) < MAX_SITES) ? AtomicFetchAdd(&SITE_COUNT, 1) : MAX_SITES;
+		if (claimed >= MAX_SITES)
+		{
+			//Keep the site from claiming again on every call, 0 would read back as a text record
+			u32 previous = AtomicCompareExchange(&site->id, UNREGISTERED_SITE, 0);
+			return (previous == 0) ? UNREGISTERED_SITE : previous;
+		}
+		AtomicCompareExchangePointer(reinterpret_cast<void *volatile *>(&SITES[claimed]), site, 0);
+
+		u32 previous = AtomicCompareExchange(&site->id, claimed, 0);
+		return (previous == 0) ? claimed : previous;
+	}
+
+	LogSite* LogRecord::GetSite(u32 id)
+	{
+		if (id == 0 || id >= MAX_SITES)
+		{
+			return 0;
+		}
+		return static_cast<LogSite*>(AtomicLoadAcquirePointer(reinterpret_cast<void *const volatile *>(&SITES[id])));
+	}
+
+	u32 LogRecord::GetSiteCount()
+	{
+		u32 count = AtomicLoadAcquire(&SITE_COUNT);
+		return (count > MAX_SITES) ? MAX_SITES : count;
+	}
+
+}
@@ -0,0 +1,189 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: LogRecord
+*Description: Compact encoding of a deferred log call. The hot path only stores the
+*site ID and the raw arguments, the text is rendered later off the calling thread.
+*Author: jkeon
+**********************************/
+
+#ifndef _LOGRECORD_H_
+#define _LOGRECORD_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <iosfwd>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// ENUMS /////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	namespace logging
+	{
+		enum ARGUMENT_TYPE
+		{
+			ARGUMENT_SIGNED = 0,
+			ARGUMENT_UNSIGNED = 1,
+			ARGUMENT_FLOAT = 2,
+			ARGUMENT_STRING = 3
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// STRUCTS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	//One per log statement, a function local static so everything but the ID is set at compile time
+	struct LogSite
+	{
+		u32 level;
+		const char *type;
+		const char *file;
+		const char *function;
+		u32 line;
+		const char *format;
+		//0 until the site first logs
+		volatile u32 id;
+	};
+
+	struct LogArgument
+	{
+		logging::ARGUMENT_TYPE type;
+		u32 length;
+		union
+		{
+			i64 i;
+			u64 u;
+			f64 f;
+			const char *s;
+		} value;
+	};
+
+	//What every record carries besides its arguments
+	struct LogRecordHeader
+	{
+		u32 level;
+		u32 count;
+		//0 for preformatted text records, LogRecord::UNREGISTERED_SITE once the site table is full
+		u32 siteId;
+		u32 threadId;
+		u64 ticks;
+	};
+
+	//Smaller integer types and floats promote to these
+	inline LogArgument MakeLogArgument(int value) { LogArgument argument; argument.type = logging::ARGUMENT_SIGNED; argument.value.i = value; return argument; }
+	inline LogArgument MakeLogArgument(long value) { LogArgument argument; argument.type = logging::ARGUMENT_SIGNED; argument.value.i = value; return argument; }
+	inline LogArgument MakeLogArgument(long long value) { LogArgument argument; argument.type = logging::ARGUMENT_SIGNED; argument.value.i = value; return argument; }
+	inline LogArgument MakeLogArgument(unsigned int value) { LogArgument argument; argument.type = logging::ARGUMENT_UNSIGNED; argument.value.u = value; return argument; }
+	inline LogArgument MakeLogArgument(unsigned long value) { LogArgument argument; argument.type = logging::ARGUMENT_UNSIGNED; argument.value.u = value; return argument; }
+	inline LogArgument MakeLogArgument(unsigned long long value) { LogArgument argument; argument.type = logging::ARGUMENT_UNSIGNED; argument.value.u = value; return argument; }
+	inline LogArgument MakeLogArgument(double value) { LogArgument argument; argument.type = logging::ARGUMENT_FLOAT; argument.value.f = value; return argument; }
+	//Strings are only pointed at until Encode copies them, so the argument mustn't outlive the string.
+	//A temporary string dies at the end of the statement that made it, which is why the LANDAN_LOGF
+	//macros build their arguments inside the DeployRecord call.
+	LogArgument MakeLogArgument(const char *value);
+	LogArgument MakeLogArgument(const string &value);
+
+	//Lets the LANDAN_LOGF macros build their argument array in the same expression that encodes it
+	struct LogArgumentList
+	{
+		LogArgumentList(const LogArgument &a0) { values[0] = a0; }
+		LogArgumentList(const LogArgument &a0, const LogArgument &a1) { values[0] = a0; values[1] = a1; }
+		LogArgumentList(const LogArgument &a0, const LogArgument &a1, const LogArgument &a2) { values[0] = a0; values[1] = a1; values[2] = a2; }
+		LogArgumentList(const LogArgument &a0, const LogArgument &a1, const LogArgument &a2, const LogArgument &a3) { values[0] = a0; values[1] = a1; values[2] = a2; values[3] = a3; }
+		LogArgument values[4];
+	};
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class LogRecord {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//Returns the encoded length, 0 if it didn't fit
+		static u32 Encode(LogSite *site, const LogArgument *arguments, u32 count, char *out, u32 capacity);
+		//Already formatted lines get the same header with a site ID of 0, long text is truncated
+		static u32 EncodeText(u32 level, const char *text, u32 length, char *out, u32 capacity);
+		//Encoded records start with a zero byte, which text never does
+		static bool IsEncoded(const char *record, u32 length);
+
+		static bool DecodeHeader(const char *record, u32 length, LogRecordHeader &header);
+		//Decoded strings point into the record. Returns how many arguments were decoded.
+		static u32 DecodeArguments(const char *record, u32 length, LogArgument *arguments, u32 maxCount);
+		//The text of a site ID 0 record
+		static const char* DecodeText(const char *record, u32 length, u32 &textLength);
+
+		//Writes the same line PrepLogStream would have, truncated to capacity
+		static u32 Render(const char *record, u32 length, char *out, u32 capacity);
+		//Each {} in the format takes the next argument, placeholders without one are left as is
+		static void WriteFormatted(std::ostream &stream, const char *format, const LogArgument *arguments, u32 count);
+
+		//Returns UNREGISTERED_SITE once MAX_SITES are taken, the site keeps that ID from then on
+		static u32 RegisterSite(LogSite *site);
+		static LogSite* GetSite(u32 id);
+		static u32 GetSiteCount();
+
+	//PRIVATE FUNCTIONS
+	private:
+		LogRecord();
+		LogRecord(const LogRecord &other);
+		LogRecord& operator = (const LogRecord &other);
+
+	//PUBLIC VARIABLES
+	public:
+		static const u32 MAX_SITES = 4096;
+		static const u32 MAX_STRING_LENGTH = 128;
+		static const u32 MAX_ARGUMENTS = 16;
+		static const u32 HEADER_SIZE = 19;
+		static const u32 UNREGISTERED_SITE = 0xFFFFFFFF;
+
+	//PRIVATE VARIABLES
+	private:
+		static LogSite *volatile SITES[MAX_SITES];
+		static volatile u32 SITE_COUNT;
+	
+	};
+}
+#endif
@@ -0,0 +1,160 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include "VarInt.h"
+#include <cstring>
+#include <landan/util/EndianUtil.h>
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// STATICS ///////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	//value must not be 0
+	static u32 CountTrailingZeros(u64 value)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		if (_BitScanForward(&index, static_cast<unsigned long>(value)))
+		{
+			return index;
+		}
+		_BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+		return index + 32;
+#else
+		return static_cast<u32>(__builtin_ctzll(value));
+#endif
+	}
+
+	u32 VarInt::GetSize(u64 value)
+	{
+		u32 size = 1;
+		while (value >= 0x80)
+		{
+			value >>= 7;
+			size++;
+		}
+		return size;
+	}
+
+	u32 VarInt::Encode(u64 value, u8 *out)
+	{
+		u32 size = 0;
+		while (value >= 0x80)
+		{
+			out[size++] = static_cast<u8>(value | 0x80);
+			value >>= 7;
+		}
+		out[size++] = static_cast<u8>(value);
+		return size;
+	}
+
+	u32 VarInt::Decode(const u8 *bytes, u32 available, u64 &value)
+	{
+		if (available == 0)
+		{
+			return 0;
+		}
+		//Single byte values are by far the most common
+		if (bytes[0] < 0x80)
+		{
+			value = bytes[0];
+			return 1;
+		}
+		if (available < 8)
+		{
+			return DecodeSlow(bytes, available, value);
+		}
+
+		u64 word;
+		memcpy(&word, bytes, sizeof(word));
+		if (endian::SYSTEM_ENDIAN == endian::BIG_ENDIAN)
+		{
+			word = SwapUInt64(word);
+		}
+
+		//The first byte with its high bit clear ends the varint
+		u64 stops = ~word & 0x8080808080808080ull;
+		if (stops == 0)
+		{
+			return DecodeSlow(bytes, available, value);
+		}
+		u32 size = (CountTrailingZeros(stops) >> 3) + 1;
+
+		//Drop the bytes past the end and the continuation bits, then squeeze the 7 bit groups together:
+		//pairs of bytes into 14 bits, pairs of those into 28 and finally 56
+		u64 bits = (size == 8) ? word : word & ((1ull << (size * 8)) - 1);
+		bits &= 0x7F7F7F7F7F7F7F7Full;
+		bits = ((bits & 0x7F007F007F007F00ull) >> 1) | (bits & 0x007F007F007F007Full);
+		bits = ((bits & 0x3FFF00003FFF0000ull) >> 2) | (bits & 0x00003FFF00003FFFull);
+		bits = ((bits & 0x0FFFFFFF00000000ull) >> 4) | (bits & 0x000000000FFFFFFFull);
+
+		value = bits;
+		return size;
+	}
+
+	u32 VarInt::DecodeSlow(const u8 *bytes, u32 available, u64 &value)
+	{
+		u64 result = 0;
+		u32 limit = (available < MAX_SIZE) ? available : MAX_SIZE;
+		for (u32 i = 0; i < limit; i++)
+		{
+			u8 byte = bytes[i];
+			//The tenth byte only has room for the top bit
+			if (i == MAX_SIZE - 1 && byte > 1)
+			{
+				return 0;
+			}
+			result |= static_cast<u64>(byte & 0x7F) << (7 * i);
+			if (byte < 0x80)
+			{
+				value = result;
+				return i + 1;
+			}
+		}
+		return 0;
+	}
+
+}
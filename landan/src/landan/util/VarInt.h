@@ -0,0 +1,92 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+*Class: VarInt
+*Description: LEB128 variable length integers, 7 bits per byte with the high bit set on every
+*byte but the last, and zig-zag mapping so small negative numbers stay small too.
+*Author: jkeon
+**********************************/
+
+#ifndef _VARINT_H_
+#define _VARINT_H_
+
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan {
+
+	//////////////////////////////////////////////////////////////////////
+	// CLASS DECLARATION /////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////
+
+	class VarInt {
+
+	//PUBLIC FUNCTIONS
+	public:
+		//0, -1, 1, -2, 2... map to 0, 1, 2, 3, 4...
+		static u32 ZigZag32(i32 value) { return (static_cast<u32>(value) << 1) ^ static_cast<u32>(value >> 31); }
+		static u64 ZigZag64(i64 value) { return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63); }
+		static i32 UnZigZag32(u32 value) { return static_cast<i32>((value >> 1) ^ (0u - (value & 1))); }
+		static i64 UnZigZag64(u64 value) { return static_cast<i64>((value >> 1) ^ (0ull - (value & 1))); }
+
+		//Bytes Encode will write, 1 to MAX_SIZE
+		static u32 GetSize(u64 value);
+		//out needs room for GetSize(value) bytes, returns how many were written
+		static u32 Encode(u64 value, u8 *out);
+		//Returns how many bytes were consumed, 0 if the varint runs past available or doesn't fit in 64 bits.
+		//With 8 or more bytes available values up to 56 bits decode without a per byte loop.
+		static u32 Decode(const u8 *bytes, u32 available, u64 &value);
+
+	//PRIVATE FUNCTIONS
+	private:
+		VarInt();
+		VarInt(const VarInt &other);
+		VarInt& operator = (const VarInt &other);
+
+		static u32 DecodeSlow(const u8 *bytes, u32 available, u64 &value);
+
+	//PUBLIC VARIABLES
+	public:
+		static const u32 MAX_SIZE = 10;
+
+	};
+}
+#endif
@@ -91,7 +91,7 @@ namespace landan {
 
 	void SimpleBasicApplication::Update(f32 deltaMilliSeconds)
 	{
-		LOG_INFO("SimpleBasicApplication Update " << deltaMilliSeconds);
+		LOG_INFOF1("SimpleBasicApplication Update {}", deltaMilliSeconds);
 		count++;
 
 		if (count == 5)
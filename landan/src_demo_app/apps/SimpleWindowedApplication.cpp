@@ -91,7 +91,7 @@ namespace landan {
 
 	void SimpleWindowedApplication::Update(f32 deltaMilliSeconds)
 	{
-		LOG_INFO("SimpleWindowedApplication Update " << deltaMilliSeconds);
+		LOG_INFOF1("SimpleWindowedApplication Update {}", deltaMilliSeconds);
 		count++;
 
 		if (count == 5)
@@ -100,9 +100,9 @@ namespace landan {
 		}
 	}
 
-	void SimpleWindowedApplication::Render()
+	void SimpleWindowedApplication::Render(f32 interpolationAlpha)
 	{
-		LOG_INFO("SimpleWindowedApplication Render");
+		LOG_INFOF1("SimpleWindowedApplication Render {}", interpolationAlpha);
 	}
 
 }
\ No newline at end of file
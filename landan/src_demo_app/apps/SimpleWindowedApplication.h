@@ -66,7 +66,7 @@ namespace landan {
 		void ApplyConfig(ApplicationConfig &appConfig);
 		void Init();
 		void Update(f32 deltaMilliSeconds);
-		void Render();
+		void Render(f32 interpolationAlpha);
 		void Destroy();
 
 		//PRIVATE VARIABLES
@@ -40,8 +40,29 @@ or implied, of Karman Interactive Ltd.
 // INCLUDES //////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
 
+#include <tests/ApplicationRunnerTest.h>
+#include <tests/ApplicationScaffoldTest.h>
+#include <tests/ArchiveTest.h>
+#include <tests/AsyncFileServiceTest.h>
+#include <tests/AsyncLoggerTest.h>
+#include <tests/BinaryLogTest.h>
+#include <tests/BitStreamTest.h>
 #include <tests/ByteArrayTest.h>
+#include <tests/ByteStreamTest.h>
+#include <tests/ByteSwapTest.h>
+#include <tests/CompressionTest.h>
+#include <tests/FileStreamTest.h>
+#include <tests/FixedTimeStepTest.h>
+#include <tests/FramePacerTest.h>
+#include <tests/FrameProfilerTest.h>
+#include <tests/JobSystemTest.h>
+#include <tests/LogRecordTest.h>
+#include <tests/MappedFileTest.h>
+#include <tests/PackFileTest.h>
+#include <tests/ProfilerTest.h>
+#include <tests/TimerTest.h>
 #include <tests/UTF8Test.h>
+#include <tests/VarIntTest.h>
 #include <gtest/gtest.h>
 
 //////////////////////////////////////////////////////////////////////
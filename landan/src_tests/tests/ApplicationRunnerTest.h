@@ -0,0 +1,346 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: ApplicationRunnerTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _APPLICATIONRUNNERTEST_H_
+#define _APPLICATIONRUNNERTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/application/BasicApplication.h>
+#include <landan/application/config/ApplicationConfig.h>
+#include <landan/core/ApplicationRunner.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/job/JobSystem.h>
+#include <landan/thread/Thread.h>
+#include <landan/timer/Timer.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+//Quits itself after a set number of Updates, 0 runs until told to quit
+class CountingApplication : public BasicApplication
+{
+public:
+	CountingApplication(application::UPDATE_TYPE updateType, u32 quitAfter, u32 sleepMilliSeconds = 0)
+	:m_updateType(updateType), m_quitAfter(quitAfter), m_sleepMilliSeconds(sleepMilliSeconds), m_initCount(0), m_updateCount(0), m_destroyCount(0), m_stepMilliSeconds(0.0f), m_lastUpdateTicks(0)
+	{
+
+	}
+
+	virtual void ApplyConfig(ApplicationConfig *appConfig)
+	{
+		appConfig->SetUpdateType(m_updateType);
+		appConfig->SetFrameRate(500.0f);
+		appConfig->SetFixedTimeStep(2.0f);
+	}
+
+	virtual void Init() { m_initCount++; }
+	virtual void Destroy() { m_destroyCount++; }
+
+	virtual void Update(f32 deltaMilliSeconds)
+	{
+		m_updateCount++;
+		if (m_updateType == application::FIXED_TIMESTEP)
+		{
+			m_stepMilliSeconds = deltaMilliSeconds;
+		}
+		if (m_sleepMilliSeconds > 0)
+		{
+			Thread::SleepFor(m_sleepMilliSeconds);
+		}
+		m_lastUpdateTicks = Timer::GetTicks();
+		if (m_quitAfter != 0 && m_updateCount >= m_quitAfter)
+		{
+			Quit();
+		}
+	}
+
+	application::UPDATE_TYPE m_updateType;
+	u32 m_quitAfter;
+	u32 m_sleepMilliSeconds;
+	u32 m_initCount;
+	u32 m_updateCount;
+	u32 m_destroyCount;
+	f32 m_stepMilliSeconds;
+	u64 m_lastUpdateTicks;
+};
+
+//Spreads its Update over the runner's shared pool
+class ParallelApplication : public BasicApplication
+{
+public:
+	ParallelApplication()
+	:m_sum(0), m_updateCount(0)
+	{
+
+	}
+
+	virtual void ApplyConfig(ApplicationConfig *appConfig)
+	{
+		appConfig->SetUpdateType(application::FRAMERATE_UNLIMITED);
+	}
+
+	virtual void Update(f32)
+	{
+		GetJobSystem()->ParallelFor(ITEM_COUNT, 16, MEMBER_FUNCTION(&ParallelApplication::SumRange, this));
+		if (++m_updateCount == 3)
+		{
+			Quit();
+		}
+	}
+
+	void SumRange(u32 begin, u32 end)
+	{
+		for (u32 i = begin; i < end; i++)
+		{
+			AtomicFetchAdd(&m_sum, i);
+		}
+	}
+
+	static const u32 ITEM_COUNT = 256;
+	volatile u32 m_sum;
+	u32 m_updateCount;
+};
+
+class ApplicationRunnerTest : public ::testing::Test
+{
+
+protected:
+	virtual void TearDown()
+	{
+		for (u32 i = 0; i < m_apps.size(); i++)
+		{
+			delete m_apps[i];
+		}
+		m_apps.clear();
+	}
+
+	CountingApplication* Create(application::UPDATE_TYPE updateType, u32 quitAfter, u32 sleepMilliSeconds = 0)
+	{
+		CountingApplication *app = new CountingApplication(updateType, quitAfter, sleepMilliSeconds);
+		m_apps.push_back(app);
+		return app;
+	}
+
+	std::vector<CountingApplication*> m_apps;
+
+};
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(ApplicationRunnerTest, TestManyInstances)
+{
+	ApplicationRunner runner;
+	ASSERT_TRUE(runner.Start(3));
+
+	//Every update type side by side, each with its own quit flag
+	for (u32 i = 0; i < 200; i++)
+	{
+		application::UPDATE_TYPE updateType = static_cast<application::UPDATE_TYPE>(i % 4);
+		u32 quitAfter = (updateType == application::RUN_ONCE) ? 0 : 5 + i % 7;
+		ASSERT_EQ(i + 1, runner.Add(Create(updateType, quitAfter)));
+	}
+	ASSERT_EQ(200u, runner.GetInstanceCount());
+	ASSERT_EQ(200u, runner.GetRunningCount());
+
+	runner.Run();
+	ASSERT_EQ(0u, runner.GetRunningCount());
+
+	for (u32 i = 0; i < m_apps.size(); i++)
+	{
+		CountingApplication &app = *m_apps[i];
+		ASSERT_EQ(1u, app.m_initCount);
+		ASSERT_EQ(1u, app.m_destroyCount);
+		if (app.m_updateType == application::RUN_ONCE)
+		{
+			ASSERT_EQ(1u, app.m_updateCount);
+		}
+		else
+		{
+			ASSERT_EQ(app.m_quitAfter, app.m_updateCount);
+		}
+		if (app.m_updateType == application::FIXED_TIMESTEP)
+		{
+			ASSERT_FLOAT_EQ(2.0f, app.m_stepMilliSeconds);
+		}
+
+		InstanceStats stats;
+		ASSERT_TRUE(runner.GetInstanceStats(i + 1, stats));
+		ASSERT_FALSE(stats.running);
+		ASSERT_GT(stats.frameCount, 0u);
+	}
+
+	//Destroy already ran, Stop mustn't call it again
+	runner.Stop();
+	ASSERT_EQ(1u, m_apps[0]->m_destroyCount);
+}
+
+TEST_F(ApplicationRunnerTest, TestQuitInstance)
+{
+	ApplicationRunner runner;
+	ASSERT_TRUE(runner.Start(1));
+	CountingApplication *forever = Create(application::FRAMERATE_LIMITED, 0);
+	CountingApplication *finite = Create(application::FRAMERATE_UNLIMITED, 10);
+	u32 foreverId = runner.Add(forever);
+	runner.Add(finite);
+
+	//The instance that never quits keeps Run going until it's told to stop
+	runner.QuitInstance(foreverId);
+	runner.Run();
+	ASSERT_EQ(1u, forever->m_destroyCount);
+	ASSERT_EQ(10u, finite->m_updateCount);
+
+	runner.QuitInstance(0);
+	runner.QuitInstance(3);
+	InstanceStats stats;
+	ASSERT_FALSE(runner.GetInstanceStats(3, stats));
+}
+
+TEST_F(ApplicationRunnerTest, TestStop)
+{
+	ApplicationRunner runner;
+	ASSERT_TRUE(runner.Start(0));
+	CountingApplication *app = Create(application::FRAMERATE_UNLIMITED, 0);
+	runner.Add(app);
+
+	runner.Quit();
+	runner.Run();
+	ASSERT_EQ(1u, runner.GetRunningCount());
+	ASSERT_EQ(0u, app->m_destroyCount);
+
+	runner.Stop();
+	ASSERT_EQ(0u, runner.GetRunningCount());
+	ASSERT_EQ(1u, app->m_destroyCount);
+}
+
+TEST_F(ApplicationRunnerTest, TestBudget)
+{
+	ApplicationRunner runner;
+	ASSERT_TRUE(runner.Start(1));
+
+	//A 2ms frame that takes 5ms overruns every time
+	CountingApplication *slow = Create(application::FRAMERATE_LIMITED, 3, 5);
+	u32 id = runner.Add(slow);
+	runner.Run();
+
+	InstanceStats stats;
+	ASSERT_TRUE(runner.GetInstanceStats(id, stats));
+	ASSERT_EQ(3u, stats.frameCount);
+	ASSERT_EQ(3u, stats.overrunCount);
+	ASSERT_DOUBLE_EQ(2.0, stats.budgetMilliSeconds);
+	ASSERT_GE(stats.maxUpdateMilliSeconds, 5.0);
+}
+
+TEST_F(ApplicationRunnerTest, TestSlowInstanceDoesNotBlock)
+{
+	ApplicationRunner runner;
+	ASSERT_TRUE(runner.Start(2));
+
+	//The fast instance's 20 frames take about 40ms, it shouldn't have to wait out the slow Update
+	CountingApplication *slow = Create(application::FRAMERATE_UNLIMITED, 1, 200);
+	CountingApplication *fast = Create(application::FRAMERATE_LIMITED, 20);
+	runner.Add(slow);
+	runner.Add(fast);
+	runner.Run();
+
+	ASSERT_EQ(1u, slow->m_updateCount);
+	ASSERT_EQ(20u, fast->m_updateCount);
+	ASSERT_LT(fast->m_lastUpdateTicks, slow->m_lastUpdateTicks);
+	ASSERT_EQ(1u, fast->m_destroyCount);
+}
+
+TEST_F(ApplicationRunnerTest, TestSharedJobSystem)
+{
+	ApplicationRunner runner;
+	ASSERT_TRUE(runner.Start(2));
+	std::vector<ParallelApplication*> apps;
+	for (u32 i = 0; i < 8; i++)
+	{
+		apps.push_back(new ParallelApplication());
+		runner.Add(apps[i]);
+	}
+
+	//Updates already run as jobs, the ParallelFor inside them nests on the same pool
+	runner.Run();
+	for (u32 i = 0; i < apps.size(); i++)
+	{
+		ASSERT_EQ(3u * (ParallelApplication::ITEM_COUNT * (ParallelApplication::ITEM_COUNT - 1) / 2), apps[i]->m_sum);
+		ASSERT_EQ(runner.GetJobSystem(), apps[i]->GetJobSystem());
+	}
+	runner.Stop();
+	for (u32 i = 0; i < apps.size(); i++)
+	{
+		delete apps[i];
+	}
+}
+
+TEST_F(ApplicationRunnerTest, TestRejectsWindowed)
+{
+	class WindowedConfigApplication : public BasicApplication
+	{
+	public:
+		virtual void ApplyConfig(ApplicationConfig *appConfig)
+		{
+			appConfig->SetApplicationType(application::WINDOWED);
+		}
+	};
+
+	ApplicationRunner runner;
+	ASSERT_TRUE(runner.Start(0));
+	WindowedConfigApplication app;
+	ASSERT_EQ(0u, runner.Add(&app));
+	ASSERT_EQ(0u, runner.GetInstanceCount());
+}
+
+
+} /* namespace landan */
+#endif /* _APPLICATIONRUNNERTEST_H_ */
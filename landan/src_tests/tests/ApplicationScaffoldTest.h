@@ -0,0 +1,228 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: ApplicationScaffoldTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _APPLICATIONSCAFFOLDTEST_H_
+#define _APPLICATIONSCAFFOLDTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/application/WindowedApplication.h>
+#include <landan/application/config/ApplicationConfig.h>
+#include <landan/core/ApplicationScaffold.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/thread/Thread.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+//Tags each frame's render state with its number and checks Render sees them in order, on the render thread
+class PipelinedApplication : public WindowedApplication
+{
+public:
+	PipelinedApplication(application::UPDATE_TYPE updateType, u32 depth, u32 quitAfter, u32 renderMilliSeconds)
+	:m_updateType(updateType), m_depth(depth), m_quitAfter(quitAfter), m_renderMilliSeconds(renderMilliSeconds),
+	m_updateCount(0), m_copyCount(0), m_renderCount(0), m_initCount(0), m_shutdownCount(0), m_errorCount(0),
+	m_updateThread(0), m_initThread(0), m_shutdownThread(0)
+	{
+		for (u32 i = 0; i < ApplicationScaffold::MAX_PIPELINE_DEPTH; i++)
+		{
+			m_frames[i] = 0;
+		}
+	}
+
+	virtual void ApplyConfig(ApplicationConfig *appConfig)
+	{
+		appConfig->SetUpdateType(m_updateType);
+		appConfig->SetFixedTimeStep(1.0f);
+		appConfig->SetPipelineDepth(m_depth);
+	}
+
+	virtual void Update(f32)
+	{
+		m_updateThread = Thread::GetCurrentId();
+		if (++m_updateCount >= m_quitAfter)
+		{
+			Quit();
+		}
+	}
+
+	virtual void CopyRenderState(u32 buffer)
+	{
+		//Frame f always goes to buffer f % depth
+		if (buffer != m_copyCount % m_depth)
+		{
+			m_errorCount++;
+		}
+		m_frames[buffer] = m_copyCount++;
+	}
+
+	virtual void InitRenderThread()
+	{
+		m_initCount++;
+		m_initThread = Thread::GetCurrentId();
+	}
+
+	virtual void Render(f32 interpolationAlpha)
+	{
+		//Frames come back in the order they were copied, each from its own buffer
+		if (m_frames[GetRenderBuffer()] != m_renderCount || m_initCount != 1 || m_shutdownCount != 0 || Thread::GetCurrentId() != m_initThread)
+		{
+			m_errorCount++;
+		}
+		//Only the fixed step blends between states, everything else always renders the latest one
+		bool fixed = (m_updateType == application::FIXED_TIMESTEP);
+		if (interpolationAlpha < 0.0f || interpolationAlpha > 1.0f || (!fixed && interpolationAlpha != 1.0f))
+		{
+			m_errorCount++;
+		}
+		m_renderCount++;
+
+		if (m_renderMilliSeconds > 0)
+		{
+			Thread::SleepFor(m_renderMilliSeconds);
+		}
+	}
+
+	virtual void ShutdownRenderThread()
+	{
+		m_shutdownCount++;
+		m_shutdownThread = Thread::GetCurrentId();
+	}
+
+	application::UPDATE_TYPE m_updateType;
+	u32 m_depth;
+	u32 m_quitAfter;
+	u32 m_renderMilliSeconds;
+	u32 m_frames[ApplicationScaffold::MAX_PIPELINE_DEPTH];
+
+	u32 m_updateCount;
+	u32 m_copyCount;
+	u32 m_renderCount;
+	u32 m_initCount;
+	u32 m_shutdownCount;
+	u32 m_errorCount;
+	u32 m_updateThread;
+	u32 m_initThread;
+	u32 m_shutdownThread;
+};
+
+class ApplicationScaffoldTest : public ::testing::Test
+{
+
+protected:
+	virtual void SetUp()
+	{
+
+	}
+	virtual void TearDown()
+	{
+
+	}
+
+	void RunWindowed(PipelinedApplication &app)
+	{
+		ApplicationScaffold scaffold(&app);
+		scaffold.Init();
+		scaffold.PrepWindowed();
+		scaffold.RunWindowed();
+		scaffold.StopWindowed();
+	}
+
+};
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(ApplicationScaffoldTest, TestPipelinedFrames)
+{
+	PipelinedApplication app(application::FRAMERATE_UNLIMITED, 2, 200, 0);
+	RunWindowed(app);
+
+	//Quitting drains the pipeline, every frame copied is rendered before the loop returns
+	ASSERT_EQ(200u, app.m_copyCount);
+	ASSERT_EQ(app.m_copyCount, app.m_renderCount);
+	ASSERT_EQ(0u, app.m_errorCount);
+
+	ASSERT_EQ(1u, app.m_initCount);
+	ASSERT_EQ(1u, app.m_shutdownCount);
+	ASSERT_EQ(app.m_initThread, app.m_shutdownThread);
+	ASSERT_NE(app.m_updateThread, app.m_initThread);
+}
+
+TEST_F(ApplicationScaffoldTest, TestPipelinedBackPressure)
+{
+	//Render is slower than the 1ms steps, so Update keeps waiting on the buffer it wants to reuse
+	PipelinedApplication app(application::FIXED_TIMESTEP, 2, 40, 2);
+	RunWindowed(app);
+
+	ASSERT_LT(0u, app.m_copyCount);
+	ASSERT_EQ(app.m_copyCount, app.m_renderCount);
+	ASSERT_EQ(0u, app.m_errorCount);
+	ASSERT_EQ(1u, app.m_shutdownCount);
+	ASSERT_NE(app.m_updateThread, app.m_initThread);
+}
+
+TEST_F(ApplicationScaffoldTest, TestSerialRenderHooks)
+{
+	//Without pipelining the hooks still bracket Render, on the update thread
+	PipelinedApplication app(application::FRAMERATE_UNLIMITED, 1, 20, 0);
+	RunWindowed(app);
+
+	ASSERT_EQ(20u, app.m_renderCount);
+	ASSERT_EQ(0u, app.m_errorCount);
+	ASSERT_EQ(1u, app.m_initCount);
+	ASSERT_EQ(1u, app.m_shutdownCount);
+	ASSERT_EQ(app.m_updateThread, app.m_initThread);
+	ASSERT_EQ(app.m_updateThread, app.m_shutdownThread);
+}
+
+
+} /* namespace landan */
+#endif /* _APPLICATIONSCAFFOLDTEST_H_ */
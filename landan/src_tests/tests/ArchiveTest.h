@@ -0,0 +1,215 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: ArchiveTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _ARCHIVETEST_H_
+#define _ARCHIVETEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/util/Archive.h>
+#include <landan/util/ByteArray.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// TYPES /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace archivetest
+{
+	//Serialized without touching the type, found through ADL
+	struct Vector3
+	{
+		landan::f32 x;
+		landan::f32 y;
+		landan::f32 z;
+	};
+
+	template<typename ARCHIVE>
+	void Serialize(ARCHIVE &archive, Vector3 &value)
+	{
+		archive.Value(value.x);
+		archive.Value(value.y);
+		archive.Value(value.z);
+	}
+
+	enum TEAM
+	{
+		RED = 0,
+		BLUE = 1
+	};
+
+	struct Entity
+	{
+		landan::u32 id;
+		TEAM team;
+		Vector3 position;
+		landan::string name;
+		bool alive;
+
+		LANDAN_SERIALIZE(LANDAN_FIELD(id) LANDAN_FIELD(team) LANDAN_FIELD(position) LANDAN_FIELD(name) LANDAN_FIELD(alive))
+	};
+
+	struct Snapshot
+	{
+		landan::u64 frame;
+		landan::i16 deltas[3];
+		std::vector<Entity> entities;
+		std::vector<landan::u32> ids;
+		std::vector<bool> flags;
+
+		LANDAN_SERIALIZE(LANDAN_FIELD(frame) LANDAN_FIELD(deltas) LANDAN_FIELD(entities) LANDAN_FIELD(ids) LANDAN_FIELD(flags))
+	};
+}
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class ArchiveTest : public ::testing::Test
+{
+
+};
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(ArchiveTest, TestRoundTrip)
+{
+	archivetest::Snapshot snapshot;
+	snapshot.frame = 1234567890123ull;
+	snapshot.deltas[0] = -1;
+	snapshot.deltas[1] = 2;
+	snapshot.deltas[2] = -300;
+	for (u32 i = 0; i < 3; i++)
+	{
+		archivetest::Entity entity;
+		entity.id = 100 + i;
+		entity.team = (i & 1) ? archivetest::BLUE : archivetest::RED;
+		entity.position.x = 1.0f * i;
+		entity.position.y = -2.0f * i;
+		entity.position.z = 0.5f;
+		entity.name = string("entity") + static_cast<char>('0' + i);
+		entity.alive = (i != 1);
+		snapshot.entities.push_back(entity);
+		snapshot.ids.push_back(0x01020304u * i);
+		snapshot.flags.push_back(i == 2);
+	}
+
+	ByteArray bytes(0, bytearray::GROWABLE);
+	WriteObject(bytes, snapshot);
+
+	bytes.SetPosition(0);
+	archivetest::Snapshot copy;
+	ASSERT_TRUE(ReadObject(bytes, copy));
+	ASSERT_EQ(bytes.GetLength(), bytes.GetPosition());
+
+	ASSERT_EQ(snapshot.frame, copy.frame);
+	ASSERT_EQ(-300, copy.deltas[2]);
+	ASSERT_EQ(3u, copy.entities.size());
+	for (u32 i = 0; i < 3; i++)
+	{
+		ASSERT_EQ(snapshot.entities[i].id, copy.entities[i].id);
+		ASSERT_EQ(snapshot.entities[i].team, copy.entities[i].team);
+		ASSERT_EQ(snapshot.entities[i].position.y, copy.entities[i].position.y);
+		ASSERT_EQ(snapshot.entities[i].name, copy.entities[i].name);
+		ASSERT_EQ(snapshot.entities[i].alive, copy.entities[i].alive);
+	}
+	ASSERT_EQ(snapshot.ids, copy.ids);
+	ASSERT_EQ(snapshot.flags, copy.flags);
+}
+
+TEST_F(ArchiveTest, TestLayout)
+{
+	//Bitwise vectors are a varint count and the raw little endian elements
+	std::vector<u16> values;
+	values.push_back(0x0102);
+	values.push_back(0x0304);
+	ByteArray bytes(0, bytearray::GROWABLE);
+	bytes.SetEndianess(endian::BIG_ENDIAN);
+	WriteObject(bytes, values);
+
+	ASSERT_EQ(5u, bytes.GetLength());
+	const u8 *raw = bytes.GetRawBytes();
+	ASSERT_EQ(2, raw[0]);
+	ASSERT_EQ(0x02, raw[1]);
+	ASSERT_EQ(0x01, raw[2]);
+	ASSERT_EQ(0x04, raw[3]);
+}
+
+TEST_F(ArchiveTest, TestCorrupt)
+{
+	//A count far past the end of the data
+	ByteArray bytes(0, bytearray::GROWABLE);
+	bytes.WriteVarUInt32(1000000000);
+	bytes.WriteUInt32(7);
+	bytes.SetPosition(0);
+
+	std::vector<archivetest::Entity> entities;
+	ASSERT_FALSE(ReadObject(bytes, entities));
+	ASSERT_TRUE(entities.empty());
+
+	//Running out half way
+	ByteArray truncated(0, bytearray::GROWABLE);
+	archivetest::Entity entity;
+	entity.id = 1;
+	entity.team = archivetest::BLUE;
+	entity.position.x = entity.position.y = entity.position.z = 0.0f;
+	entity.name = "name";
+	entity.alive = true;
+	WriteObject(truncated, entity);
+	truncated.Resize(truncated.GetLength() - 3);
+	truncated.SetPosition(0);
+	archivetest::Entity copy;
+	ASSERT_FALSE(ReadObject(truncated, copy));
+	ASSERT_EQ(1u, copy.id);
+}
+
+
+} /* namespace landan */
+#endif /* _ARCHIVETEST_H_ */
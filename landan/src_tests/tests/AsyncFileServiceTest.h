@@ -0,0 +1,236 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: AsyncFileServiceTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _ASYNCFILESERVICETEST_H_
+#define _ASYNCFILESERVICETEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <landan/core/LandanTypes.h>
+#include <landan/file/AsyncFileService.h>
+#include <landan/file/File.h>
+#include <landan/thread/Atomic.h>
+#include <landan/thread/Thread.h>
+#include <landan/util/ByteArray.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class AsyncFileServiceTest : public ::testing::Test
+{
+
+protected:
+	virtual void SetUp()
+	{
+		CALLBACK_COUNT = 0;
+		CALLBACK_BYTES = 0;
+	}
+	virtual void TearDown()
+	{
+		File(PATH).Remove();
+	}
+
+	static void OnRead(const FileCompletion &completion)
+	{
+		if (completion.success)
+		{
+			AtomicFetchAdd(&CALLBACK_BYTES, completion.transferred);
+		}
+		AtomicFetchAdd(&CALLBACK_COUNT, 1);
+	}
+
+	//Writes BLOCK_COUNT blocks out of order, polls for them, then reads them back through callbacks
+	void RoundTrip(file::IO_BACKEND backend)
+	{
+		AsyncFileService service(3, 16, backend);
+		ASSERT_TRUE(service.Start());
+		u32 file = service.Open(PATH, file::READ_WRITE);
+		ASSERT_NE(0u, file);
+
+		std::vector<ByteArray*> blocks;
+		for (u32 i = 0; i < BLOCK_COUNT; i++)
+		{
+			u32 index = (i * 5) % BLOCK_COUNT;
+			ByteArray *block = new ByteArray(BLOCK_SIZE);
+			memset(block->GetRawBytes(), static_cast<int>(index + 1), BLOCK_SIZE);
+			blocks.push_back(block);
+			ASSERT_NE(0u, service.Write(file, static_cast<u64>(index) * BLOCK_SIZE, *block));
+		}
+		service.WaitIdle();
+
+		u32 completed = 0;
+		FileCompletion completion;
+		while (service.PollCompletion(completion))
+		{
+			ASSERT_TRUE(completion.success);
+			ASSERT_EQ(file::REQUEST_WRITE, completion.type);
+			ASSERT_EQ(BLOCK_SIZE, completion.transferred);
+			completed++;
+		}
+		ASSERT_EQ(BLOCK_COUNT, completed);
+
+		std::vector<ByteArray*> reads;
+		for (u32 i = 0; i < BLOCK_COUNT; i++)
+		{
+			reads.push_back(new ByteArray(0, bytearray::GROWABLE));
+			ASSERT_NE(0u, service.Read(file, static_cast<u64>(i) * BLOCK_SIZE, *reads[i], BLOCK_SIZE, FREE_FUNCTION(&AsyncFileServiceTest::OnRead)));
+		}
+		service.WaitIdle();
+		ASSERT_EQ(BLOCK_COUNT, AtomicLoadAcquire(&CALLBACK_COUNT));
+		ASSERT_EQ(BLOCK_COUNT * BLOCK_SIZE, AtomicLoadAcquire(&CALLBACK_BYTES));
+		ASSERT_FALSE(service.PollCompletion(completion));
+		for (u32 i = 0; i < BLOCK_COUNT; i++)
+		{
+			ASSERT_EQ(BLOCK_SIZE, reads[i]->GetLength());
+			ASSERT_EQ(i + 1, reads[i]->GetRawBytes()[0]);
+			ASSERT_EQ(i + 1, reads[i]->GetRawBytes()[BLOCK_SIZE - 1]);
+		}
+
+		//Reading past the end is a short, successful read
+		ByteArray tail(100);
+		ASSERT_NE(0u, service.Read(file, static_cast<u64>(BLOCK_COUNT) * BLOCK_SIZE - 10, tail, 100));
+		service.WaitIdle();
+		ASSERT_TRUE(service.PollCompletion(completion));
+		ASSERT_TRUE(completion.success);
+		ASSERT_EQ(&tail, completion.bytes);
+		ASSERT_EQ(10u, completion.transferred);
+
+		service.Close(file);
+		ASSERT_EQ(0u, service.Read(file, 0, tail, 1));
+		service.Stop();
+
+		for (u32 i = 0; i < BLOCK_COUNT; i++)
+		{
+			delete blocks[i];
+			delete reads[i];
+		}
+	}
+
+	static volatile u32 CALLBACK_COUNT;
+	static volatile u32 CALLBACK_BYTES;
+
+	static const string PATH;
+	static const u32 BLOCK_COUNT;
+	static const u32 BLOCK_SIZE;
+
+};
+
+volatile u32 AsyncFileServiceTest::CALLBACK_COUNT = 0;
+volatile u32 AsyncFileServiceTest::CALLBACK_BYTES = 0;
+const string AsyncFileServiceTest::PATH = "AsyncFileServiceTest.bin";
+const u32 AsyncFileServiceTest::BLOCK_COUNT = 12;
+const u32 AsyncFileServiceTest::BLOCK_SIZE = 10000;
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(AsyncFileServiceTest, TestThreads)
+{
+	RoundTrip(file::BACKEND_THREADS);
+}
+
+TEST_F(AsyncFileServiceTest, TestPreferredBackend)
+{
+	//io_uring where the kernel allows it, threads otherwise, the results must match
+	RoundTrip(file::BACKEND_IO_URING);
+}
+
+TEST_F(AsyncFileServiceTest, TestStopWithFullCompletionQueue)
+{
+	//Nobody polls, so once two completions are queued the worker can't deliver the third
+	AsyncFileService service(1, 2, file::BACKEND_THREADS);
+	ASSERT_TRUE(service.Start());
+	u32 file = service.Open(PATH, file::READ_WRITE);
+	ASSERT_NE(0u, file);
+
+	//Two delivered, one held by the worker and two waiting to start
+	ByteArray bytes(10);
+	u32 accepted = 0;
+	for (u32 attempt = 0; accepted < 5 && attempt < 5000; attempt++)
+	{
+		if (service.Write(file, 0, bytes) != 0)
+		{
+			accepted++;
+		}
+		else
+		{
+			Thread::SleepFor(1);
+		}
+	}
+	ASSERT_EQ(5u, accepted);
+
+	service.Stop();
+	ASSERT_EQ(0u, service.GetPendingCount());
+	ASSERT_EQ(3u, service.GetDroppedCount());
+
+	u32 completed = 0;
+	FileCompletion completion;
+	while (service.PollCompletion(completion))
+	{
+		completed++;
+	}
+	ASSERT_EQ(2u, completed);
+}
+
+TEST_F(AsyncFileServiceTest, TestNotRunning)
+{
+	AsyncFileService service;
+	u32 file = service.Open(PATH, file::READ_WRITE);
+	ASSERT_NE(0u, file);
+	ByteArray bytes(10);
+	ASSERT_EQ(0u, service.Write(file, 0, bytes));
+	ASSERT_EQ(0u, service.GetPendingCount());
+	ASSERT_EQ(0u, service.Open("AsyncFileServiceTest.missing"));
+}
+
+
+} /* namespace landan */
+#endif /* _ASYNCFILESERVICETEST_H_ */
@@ -0,0 +1,206 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: AsyncLoggerTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _ASYNCLOGGERTEST_H_
+#define _ASYNCLOGGERTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/thread/Thread.h>
+#include <landan/util/AsyncLogger.h>
+#include <landan/util/DebugUtil.h>
+#include <landan/util/Function.h>
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class AsyncLoggerTest : public ::testing::Test
+{
+
+protected:
+	virtual ~AsyncLoggerTest(){
+
+	}
+	virtual void SetUp()
+	{
+		OUTPUT.clear();
+	}
+	virtual void TearDown() {
+
+	}
+
+public:
+	static void Sink(const char *text, u32 length)
+	{
+		OUTPUT.append(text, length);
+	}
+
+	//Pushes lines from a second thread while the test thread pushes too
+	void ProduceLines()
+	{
+		for (u32 i = 0; i < LINES_PER_THREAD; i++)
+		{
+			p_logger->Push("b\n", 2);
+		}
+	}
+
+	//Races the test thread starting and stopping the process wide logger
+	void CycleLogging()
+	{
+		for (u32 i = 0; i < CYCLES_PER_THREAD; i++)
+		{
+			DebugUtil::StartAsyncLogging();
+			DebugUtil::StopAsyncLogging();
+		}
+	}
+
+	static string OUTPUT;
+	static const u32 LINES_PER_THREAD = 2000;
+	static const u32 CYCLES_PER_THREAD = 200;
+	AsyncLogger *p_logger;
+
+};
+
+string AsyncLoggerTest::OUTPUT;
+
+TEST_F(AsyncLoggerTest, TestMultipleProducers)
+{
+	AsyncLogger logger(FREE_FUNCTION(&AsyncLoggerTest::Sink), 256, logging::BLOCK);
+	p_logger = &logger;
+	ASSERT_TRUE(logger.Start());
+
+	Thread producer(MEMBER_FUNCTION(&AsyncLoggerTest::ProduceLines, this));
+	ASSERT_TRUE(producer.Start());
+	for (u32 i = 0; i < LINES_PER_THREAD; i++)
+	{
+		logger.Push("a\n", 2);
+	}
+	producer.Join();
+	logger.Flush();
+
+	u32 aCount = 0;
+	u32 bCount = 0;
+	for (u32 i = 0; i < OUTPUT.length(); i++)
+	{
+		aCount += (OUTPUT[i] == 'a') ? 1 : 0;
+		bCount += (OUTPUT[i] == 'b') ? 1 : 0;
+	}
+
+	u32 expected = LINES_PER_THREAD;
+	ASSERT_EQ(expected, aCount);
+	ASSERT_EQ(expected, bCount);
+	ASSERT_EQ(0ULL, logger.GetDroppedCount());
+}
+
+TEST_F(AsyncLoggerTest, TestDropWhenFull)
+{
+	//Not started, so nothing drains the queue
+	AsyncLogger logger(FREE_FUNCTION(&AsyncLoggerTest::Sink), 2, logging::DROP);
+
+	ASSERT_TRUE(logger.Push("1\n", 2));
+	ASSERT_TRUE(logger.Push("2\n", 2));
+	ASSERT_FALSE(logger.Push("3\n", 2));
+	ASSERT_EQ(1ULL, logger.GetDroppedCount());
+
+	logger.Flush();
+
+	ASSERT_EQ(0u, OUTPUT.find("1\n2\n"));
+	ASSERT_NE(string::npos, OUTPUT.find("1 log records dropped"));
+}
+
+TEST_F(AsyncLoggerTest, TestTruncation)
+{
+	AsyncLogger logger(FREE_FUNCTION(&AsyncLoggerTest::Sink), 4, logging::DROP);
+
+	string longLine(AsyncLogger::RECORD_SIZE * 2, 'x');
+	logger.Push(longLine.c_str(), static_cast<u32>(longLine.length()));
+	logger.Flush();
+
+	size_t recordSize = AsyncLogger::RECORD_SIZE;
+	ASSERT_EQ(recordSize, OUTPUT.length());
+	ASSERT_EQ(string("...\n"), OUTPUT.substr(OUTPUT.length() - 4));
+}
+
+TEST_F(AsyncLoggerTest, TestRetainRelease)
+{
+	ASSERT_FALSE(DebugUtil::IsAsyncLogging());
+
+	//Two scaffolds sharing the logger, the first one out mustn't stop it under the other
+	DebugUtil::RetainAsyncLogging();
+	DebugUtil::RetainAsyncLogging();
+	ASSERT_TRUE(DebugUtil::IsAsyncLogging());
+	DebugUtil::ReleaseAsyncLogging();
+	ASSERT_TRUE(DebugUtil::IsAsyncLogging());
+	DebugUtil::ReleaseAsyncLogging();
+	ASSERT_FALSE(DebugUtil::IsAsyncLogging());
+
+	//A logger started directly belongs to its caller
+	ASSERT_TRUE(DebugUtil::StartAsyncLogging());
+	DebugUtil::RetainAsyncLogging();
+	DebugUtil::ReleaseAsyncLogging();
+	ASSERT_TRUE(DebugUtil::IsAsyncLogging());
+	DebugUtil::StopAsyncLogging();
+	ASSERT_FALSE(DebugUtil::IsAsyncLogging());
+}
+
+TEST_F(AsyncLoggerTest, TestConcurrentStartStop)
+{
+	//Both threads stopping the same logger used to free it twice
+	Thread cycler(MEMBER_FUNCTION(&AsyncLoggerTest::CycleLogging, this));
+	ASSERT_TRUE(cycler.Start());
+	CycleLogging();
+	cycler.Join();
+
+	ASSERT_FALSE(DebugUtil::IsAsyncLogging());
+}
+
+
+} /* namespace landan */
+#endif /* _ASYNCLOGGERTEST_H_ */
@@ -0,0 +1,234 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: BinaryLogTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _BINARYLOGTEST_H_
+#define _BINARYLOGTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/file/File.h>
+#include <landan/timer/Timer.h>
+#include <landan/util/AsyncLogger.h>
+#include <landan/util/BinaryLog.h>
+#include <landan/util/ByteArray.h>
+#include <landan/util/DebugUtil.h>
+#include <landan/util/LogRecord.h>
+#include <sstream>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class BinaryLogTest : public ::testing::Test
+{
+
+protected:
+	virtual ~BinaryLogTest(){
+
+	}
+	virtual void SetUp()
+	{
+		Timer::Init();
+	}
+	virtual void TearDown() {
+		File(PATH).Remove();
+		File(PATH + ".1").Remove();
+		File(PATH + ".2").Remove();
+	}
+
+	void Push(AsyncLogger &logger, LogSite *site, const LogArgument *arguments, u32 count)
+	{
+		char record[AsyncLogger::RECORD_SIZE];
+		logger.Push(record, LogRecord::Encode(site, arguments, count, record, AsyncLogger::RECORD_SIZE));
+	}
+
+	//Decodes a file and strips the timestamp and thread prefix off every line
+	string Decode(const string &path, u32 &count)
+	{
+		ByteArray bytes = File(path).ReadAll();
+		EXPECT_GT(bytes.GetLength(), 0u);
+
+		std::ostringstream decoded;
+		count = BinaryLogDecoder::Decode(bytes, decoded);
+
+		std::istringstream lines(decoded.str());
+		string line;
+		string stripped;
+		while (std::getline(lines, line))
+		{
+			size_t prefix = line.find("] [T");
+			stripped += line.substr(line.find("] ", prefix + 1) + 2) + "\n";
+		}
+		return stripped;
+	}
+
+	static const string PATH;
+
+};
+
+const string BinaryLogTest::PATH = "BinaryLogTest.llog";
+
+TEST_F(BinaryLogTest, TestRoundTrip)
+{
+	Timer::Init();
+	static LogSite site = { LANDAN_LOG_LEVEL_INFO, "INFO", "src/File.cpp", "Update", 12, "frame {} took {}ms in {}", 0 };
+
+	BinaryLogSink sink(PATH);
+	ASSERT_TRUE(sink.Open());
+	{
+		AsyncLogger logger(MEMBER_FUNCTION(&BinaryLogSink::Write, &sink));
+		logger.SetRenderer(MEMBER_FUNCTION(&BinaryLogSink::Frame, &sink));
+
+		LogArgument arguments[] = { MakeLogArgument(3u), MakeLogArgument(-2.5), MakeLogArgument("Update") };
+		Push(logger, &site, arguments, 3);
+
+		char record[AsyncLogger::RECORD_SIZE];
+		const char *text = "ERROR [Other.cpp :: Init : 7] - plain text\n";
+		logger.Push(record, LogRecord::EncodeText(LANDAN_LOG_LEVEL_ERROR, text, static_cast<u32>(strlen(text)), record, AsyncLogger::RECORD_SIZE));
+	}
+
+	u32 count = 0;
+	string decoded = Decode(PATH, count);
+	ASSERT_EQ(2u, count);
+	ASSERT_EQ(string("INFO [File.cpp :: Update : 12] - frame 3 took -2.5ms in Update\nERROR [Other.cpp :: Init : 7] - plain text\n"), decoded);
+}
+
+TEST_F(BinaryLogTest, TestRotationKeepsFilesSelfContained)
+{
+	Timer::Init();
+	static LogSite site = { LANDAN_LOG_LEVEL_DEBUG, "DEBUG", "File.cpp", "Tick", 1, "tick {}", 0 };
+
+	BinaryLogSink sink(PATH, 256, 3);
+	ASSERT_TRUE(sink.Open());
+	AsyncLogger logger(MEMBER_FUNCTION(&BinaryLogSink::Write, &sink));
+	logger.SetRenderer(MEMBER_FUNCTION(&BinaryLogSink::Frame, &sink));
+
+	//Flushing each record keeps batches small so the sink gets a chance to rotate between them
+	for (u32 i = 0; i < 40; i++)
+	{
+		LogArgument arguments[] = { MakeLogArgument(i) };
+		Push(logger, &site, arguments, 1);
+		logger.Flush();
+	}
+
+	ASSERT_GE(sink.GetRotationCount(), 2u);
+	ASSERT_FALSE(File(PATH + ".3").Exists());
+
+	//The newest file holds the last records and still knows the site's format
+	u32 count = 0;
+	string decoded = Decode(PATH, count);
+	ASSERT_GT(count, 0u);
+	ASSERT_NE(string::npos, decoded.find("DEBUG [File.cpp :: Tick : 1] - tick 39\n"));
+
+	string older = Decode(PATH + ".1", count);
+	ASSERT_GT(count, 0u);
+	ASSERT_EQ(string::npos, older.find("UNKNOWN"));
+}
+
+TEST_F(BinaryLogTest, TestTruncatedFileDecodesUpToTheCut)
+{
+	Timer::Init();
+	static LogSite site = { LANDAN_LOG_LEVEL_INFO, "INFO", "File.cpp", "Run", 1, "value {}", 0 };
+
+	BinaryLogSink sink(PATH);
+	ASSERT_TRUE(sink.Open());
+	{
+		AsyncLogger logger(MEMBER_FUNCTION(&BinaryLogSink::Write, &sink));
+		logger.SetRenderer(MEMBER_FUNCTION(&BinaryLogSink::Frame, &sink));
+		for (u32 i = 0; i < 3; i++)
+		{
+			LogArgument arguments[] = { MakeLogArgument(i) };
+			Push(logger, &site, arguments, 1);
+		}
+	}
+
+	File file(PATH);
+	ByteArray bytes(static_cast<u32>(file.GetSize()) - 3);
+	ASSERT_TRUE(file.ReadBytes(bytes));
+
+	std::ostringstream decoded;
+	ASSERT_EQ(2u, BinaryLogDecoder::Decode(bytes, decoded));
+}
+
+TEST_F(BinaryLogTest, TestDropWarningIsFramed)
+{
+	Timer::Init();
+	static LogSite site = { LANDAN_LOG_LEVEL_INFO, "INFO", "File.cpp", "Spam", 1, "value {}", 0 };
+
+	BinaryLogSink sink(PATH);
+	ASSERT_TRUE(sink.Open());
+	{
+		//Not started, so everything past the first four is dropped until the flush drains it
+		AsyncLogger logger(MEMBER_FUNCTION(&BinaryLogSink::Write, &sink), 4, logging::DROP);
+		logger.SetRenderer(MEMBER_FUNCTION(&BinaryLogSink::Frame, &sink));
+		for (u32 i = 0; i < 2000; i++)
+		{
+			LogArgument arguments[] = { MakeLogArgument(i) };
+			Push(logger, &site, arguments, 1);
+		}
+		logger.Flush();
+		ASSERT_GT(logger.GetDroppedCount(), 0ULL);
+
+		for (u32 i = 5000; i < 5003; i++)
+		{
+			LogArgument arguments[] = { MakeLogArgument(i) };
+			Push(logger, &site, arguments, 1);
+		}
+	}
+
+	//The warning is a record of its own and everything written after it still decodes
+	u32 count = 0;
+	string decoded = Decode(PATH, count);
+	ASSERT_EQ(8u, count);
+	ASSERT_NE(string::npos, decoded.find("WARN [AsyncLogger] - 1996 log records dropped\n"));
+	ASSERT_NE(string::npos, decoded.find("value 5002\n"));
+}
+
+
+} /* namespace landan */
+#endif /* _BINARYLOGTEST_H_ */
@@ -0,0 +1,177 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: BitStreamTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _BITSTREAMTEST_H_
+#define _BITSTREAMTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <landan/core/LandanTypes.h>
+#include <landan/util/BitStream.h>
+#include <landan/util/ByteArray.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class BitStreamTest : public ::testing::Test
+{
+
+};
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(BitStreamTest, TestRoundTrip)
+{
+	ByteArray bytes(0, bytearray::GROWABLE);
+	bytes.SetEndianess(endian::BIG_ENDIAN);
+	{
+		BitWriter writer(bytes);
+		for (u32 i = 0; i < 100; i++)
+		{
+			writer.WriteBits(i % 8, 3);
+			writer.WriteBool((i & 1) != 0);
+			writer.WriteBits(i * 37, 11);
+			writer.WriteBits(0xDEADBEEF, 32);
+		}
+		writer.WriteBits64(0x0123456789ABCDEFull, 60);
+		writer.WriteFloat32(-1.25f);
+		ASSERT_EQ(100u * 47 + 60 + 32, writer.GetBitsWritten());
+	}
+	ASSERT_EQ((100u * 47 + 60 + 32 + 7) / 8, bytes.GetLength());
+
+	bytes.SetPosition(0);
+	BitReader reader(bytes);
+	for (u32 i = 0; i < 100; i++)
+	{
+		ASSERT_EQ(i % 8, reader.ReadBits(3));
+		ASSERT_EQ((i & 1) != 0, reader.ReadBool());
+		ASSERT_EQ((i * 37) & 0x7FF, reader.ReadBits(11));
+		ASSERT_EQ(0xDEADBEEFu, reader.ReadBits(32));
+	}
+	ASSERT_EQ(0x0123456789ABCDEFull, reader.ReadBits64(60));
+	ASSERT_EQ(-1.25f, reader.ReadFloat32());
+	ASSERT_FALSE(reader.HasError());
+	ASSERT_LT(reader.GetBitsRemaining(), 8u);
+}
+
+TEST_F(BitStreamTest, TestLayout)
+{
+	//Least significant bit first, so 1 then 0b101 then 0x1FF pack into known bytes
+	ByteArray bytes(0, bytearray::GROWABLE);
+	BitWriter writer(bytes);
+	writer.WriteBits(1, 1);
+	writer.WriteBits(5, 3);
+	writer.WriteBits(0x1FF, 9);
+	writer.Flush();
+	ASSERT_EQ(2u, bytes.GetLength());
+	ASSERT_EQ(0xFB, bytes.GetRawBytes()[0]);
+	ASSERT_EQ(0x1F, bytes.GetRawBytes()[1]);
+	ASSERT_EQ(2u, writer.GetByteCount());
+}
+
+TEST_F(BitStreamTest, TestBounds)
+{
+	ByteArray bytes(0, bytearray::GROWABLE);
+	{
+		BitWriter writer(bytes);
+		writer.WriteBits(0x2A, 7);
+		writer.Align();
+		writer.WriteBits(3, 2);
+	}
+	//Something unrelated after the bit stream
+	bytes.WriteUInt32(0xFFFFFFFF);
+	ASSERT_EQ(6u, bytes.GetLength());
+
+	bytes.SetPosition(0);
+	BitReader reader(bytes, 2);
+	ASSERT_EQ(0x2Au, reader.ReadBits(7));
+	reader.Align();
+	ASSERT_EQ(3u, reader.ReadBits(2));
+	ASSERT_EQ(0u, reader.ReadBits(6));
+	ASSERT_FALSE(reader.HasError());
+	ASSERT_EQ(0u, reader.ReadBits(1));
+	ASSERT_TRUE(reader.HasError());
+	ASSERT_EQ(2u, bytes.GetPosition());
+}
+
+TEST_F(BitStreamTest, TestQuantize)
+{
+	ASSERT_EQ(1u, BitWriter::BitsRequired(0));
+	ASSERT_EQ(3u, BitWriter::BitsRequired(7));
+	ASSERT_EQ(4u, BitWriter::BitsRequired(8));
+	ASSERT_EQ(32u, BitWriter::BitsRequired(0xFFFFFFFF));
+
+	ASSERT_EQ(0u, BitWriter::QuantizeFloat32(-5.0f, -1.0f, 1.0f, 11));
+	ASSERT_EQ(2047u, BitWriter::QuantizeFloat32(5.0f, -1.0f, 1.0f, 11));
+	ASSERT_EQ(-1.0f, BitReader::DequantizeFloat32(0, -1.0f, 1.0f, 11));
+	ASSERT_EQ(1.0f, BitReader::DequantizeFloat32(2047, -1.0f, 1.0f, 11));
+
+	ByteArray bytes(0, bytearray::GROWABLE);
+	{
+		BitWriter writer(bytes);
+		for (u32 i = 0; i <= 360; i++)
+		{
+			writer.WriteQuantizedFloat32(static_cast<f32>(i), 0.0f, 360.0f, 11);
+		}
+	}
+	bytes.SetPosition(0);
+	BitReader reader(bytes);
+	f32 maxError = 360.0f / (2.0f * 2047.0f);
+	for (u32 i = 0; i <= 360; i++)
+	{
+		f32 angle = reader.ReadQuantizedFloat32(0.0f, 360.0f, 11);
+		ASSERT_LE(std::fabs(angle - static_cast<f32>(i)), maxError + 0.0001f);
+	}
+}
+
+
+} /* namespace landan */
+#endif /* _BITSTREAMTEST_H_ */
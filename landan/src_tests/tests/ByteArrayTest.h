@@ -44,6 +44,7 @@ or implied, of Karman Interactive Ltd.
 //////////////////////////////////////////////////////////////////////
 
 #include <gtest/gtest.h>
+#include <cstring>
 #include <landan/core/LandanTypes.h>
 #include <landan/util/ByteArray.h>
 
@@ -89,12 +90,31 @@ class ByteArrayTest : public ::testing::Test
 	}
 
 
+	static ByteArray Serialize(u32 count)
+	{
+		ByteArray bytes(0, bytearray::GROWABLE);
+		for (u32 i = 0; i < count; i++)
+		{
+			bytes.WriteUInt32(i);
+		}
+		return bytes;
+	}
+
+	static void CountingDeleter(u8 *bytes)
+	{
+		DELETED++;
+		delete[] bytes;
+	}
+
 	ByteArray *be;
 	ByteArray *le;
+	static u32 DELETED;
 
 
 };
 
+u32 ByteArrayTest::DELETED = 0;
+
 TEST_F(ByteArrayTest, TestU8)
 {
 	u8 tu8 = 0x9D;
@@ -255,6 +275,296 @@ TEST_F(ByteArrayTest, TestF64)
 	ASSERT_DOUBLE_EQ(tf64, altf64);
 }
 
+TEST_F(ByteArrayTest, TestFixedWritePastEndFails)
+{
+	ByteArray bytes(6);
+	bytes.WriteUInt32(0x01020304);
+	ASSERT_FALSE(bytes.HasError());
+
+	bytes.WriteUInt32(0x05060708);
+	ASSERT_TRUE(bytes.HasError());
+	ASSERT_EQ(4u, bytes.GetPosition());
+	ASSERT_EQ(6u, bytes.GetLength());
+}
+
+TEST_F(ByteArrayTest, TestCheckedReads)
+{
+	ByteArray bytes(5);
+	bytes.WriteUInt32(0xDEADBEEF);
+	bytes.WriteUInt8(0x7F);
+	bytes.SetPosition(0);
+
+	ASSERT_EQ(0xDEADBEEFu, bytes.ReadUInt32());
+	ASSERT_FALSE(bytes.HasError());
+
+	//Only one byte left, the read fails without moving
+	ASSERT_EQ(0ULL, bytes.ReadUInt64());
+	ASSERT_TRUE(bytes.HasError());
+	ASSERT_EQ(4u, bytes.GetPosition());
+
+	bytes.ClearError();
+	u8 buffer[2];
+	ASSERT_FALSE(bytes.ReadBytes(buffer, 2));
+	ASSERT_EQ(0x7F, bytes.ReadUInt8());
+	ASSERT_TRUE(bytes.HasError());
+}
+
+TEST_F(ByteArrayTest, TestGrowable)
+{
+	ByteArray bytes(0, bytearray::GROWABLE);
+	bytes.SetEndianess(endian::BIG_ENDIAN);
+	ASSERT_EQ(0u, bytes.GetLength());
+
+	for (u32 i = 0; i < 1000; i++)
+	{
+		bytes.WriteUInt32(i);
+	}
+	ASSERT_FALSE(bytes.HasError());
+	ASSERT_EQ(4000u, bytes.GetLength());
+	ASSERT_GE(bytes.GetCapacity(), 4000u);
+
+	bytes.SetPosition(0);
+	for (u32 i = 0; i < 1000; i++)
+	{
+		ASSERT_EQ(i, bytes.ReadUInt32());
+	}
+
+	//Reading past what was written fails even though capacity is spare
+	bytes.ReadUInt8();
+	ASSERT_TRUE(bytes.HasError());
+}
+
+TEST_F(ByteArrayTest, TestGrowableGapIsZeroed)
+{
+	ByteArray bytes(0, bytearray::GROWABLE);
+	bytes.SetPosition(8);
+	bytes.WriteUInt8(0xFF);
+
+	ASSERT_EQ(9u, bytes.GetLength());
+	bytes.SetPosition(0);
+	ASSERT_EQ(0ULL, bytes.ReadUInt64());
+	ASSERT_EQ(0xFF, bytes.ReadUInt8());
+}
+
+TEST_F(ByteArrayTest, TestReserveResizeShrink)
+{
+	ByteArray bytes(0, bytearray::GROWABLE);
+	bytes.Reserve(256);
+	ASSERT_EQ(256u, bytes.GetCapacity());
+	ASSERT_EQ(0u, bytes.GetLength());
+
+	bytes.WriteUInt16(0xABCD);
+	bytes.Resize(10);
+	ASSERT_EQ(10u, bytes.GetLength());
+	bytes.SetPosition(2);
+	ASSERT_EQ(0ULL, bytes.ReadUInt64());
+
+	bytes.Resize(2);
+	ASSERT_EQ(2u, bytes.GetPosition());
+	bytes.ShrinkToFit();
+	ASSERT_EQ(2u, bytes.GetCapacity());
+	bytes.SetPosition(0);
+	ASSERT_EQ(0xABCD, bytes.ReadUInt16());
+}
+
+TEST_F(ByteArrayTest, TestMove)
+{
+	ByteArray bytes = Serialize(16);
+	ASSERT_EQ(64u, bytes.GetLength());
+	u8 *raw = bytes.GetRawBytes();
+
+	ByteArray moved(std::move(bytes));
+	ASSERT_EQ(raw, moved.GetRawBytes());
+	ASSERT_EQ(64u, moved.GetLength());
+	ASSERT_EQ(64u, moved.GetPosition());
+	ASSERT_TRUE(bytes.GetRawBytes() == 0);
+	ASSERT_EQ(0u, bytes.GetLength());
+
+	ByteArray assigned(8);
+	assigned = std::move(moved);
+	ASSERT_EQ(raw, assigned.GetRawBytes());
+	assigned.SetPosition(60);
+	ASSERT_EQ(15u, assigned.ReadUInt32());
+}
+
+TEST_F(ByteArrayTest, TestRelease)
+{
+	ByteArray bytes = Serialize(4);
+	u8 *raw = bytes.GetRawBytes();
+
+	u8 *released = bytes.Release();
+	ASSERT_EQ(raw, released);
+	ASSERT_TRUE(bytes.GetRawBytes() == 0);
+	ASSERT_EQ(0u, bytes.GetLength());
+	delete[] released;
+}
+
+TEST_F(ByteArrayTest, TestAdoptWithDeleter)
+{
+	DELETED = 0;
+	{
+		ByteArray bytes(new u8[4], 4, FREE_FUNCTION(&ByteArrayTest::CountingDeleter));
+		bytes.WriteUInt32(7);
+		ASSERT_FALSE(bytes.HasError());
+	}
+	ASSERT_EQ(1u, DELETED);
+
+	//Growing out of an adopted buffer hands it to the deleter straight away
+	ByteArray bytes(new u8[4], 4, FREE_FUNCTION(&ByteArrayTest::CountingDeleter), bytearray::GROWABLE);
+	bytes.SetPosition(4);
+	bytes.WriteUInt32(7);
+	ASSERT_EQ(2u, DELETED);
+	ASSERT_EQ(8u, bytes.GetLength());
+}
+
+TEST_F(ByteArrayTest, TestView)
+{
+	u8 buffer[8] = { 0 };
+	{
+		ByteArray view(buffer, 8, bytearray::VIEW);
+		view.SetEndianess(endian::BIG_ENDIAN);
+		view.WriteUInt32(0x01020304);
+		view.WriteUInt32(0x05060708);
+		view.WriteUInt8(9);
+		ASSERT_TRUE(view.HasError());
+	}
+	ASSERT_EQ(0x01, buffer[0]);
+	ASSERT_EQ(0x08, buffer[7]);
+
+	//A growable view copies once it outgrows the buffer and leaves the original alone
+	ByteArray view(buffer, 8, bytearray::VIEW, bytearray::GROWABLE);
+	view.SetPosition(8);
+	view.WriteUInt8(10);
+	ASSERT_NE(buffer, view.GetRawBytes());
+	ASSERT_EQ(9u, view.GetLength());
+	ASSERT_EQ(0x01, view.GetRawBytes()[0]);
+}
+
+TEST_F(ByteArrayTest, TestArrays)
+{
+	u16 shorts[37];
+	u32 ints[37];
+	u64 longs[37];
+	f32 floats[37];
+	f64 doubles[37];
+	for (u32 i = 0; i < 37; i++)
+	{
+		shorts[i] = static_cast<u16>(0x0102 * (i + 1));
+		ints[i] = 0x01020304u * (i + 1);
+		longs[i] = 0x0102030405060708ull * (i + 1);
+		floats[i] = 1.5f * i;
+		doubles[i] = -2.25 * i;
+	}
+
+	ByteArray *arrays[2] = { be, le };
+	for (u32 a = 0; a < 2; a++)
+	{
+		ByteArray &bytes = *arrays[a];
+		bytes.WriteUInt16Array(shorts, 37);
+		bytes.WriteUInt32Array(ints, 37);
+		bytes.WriteUInt64Array(longs, 37);
+		bytes.WriteFloat32Array(floats, 37);
+		bytes.WriteFloat64Array(doubles, 37);
+
+		//Arrays lay out exactly like the same values written one at a time
+		bytes.SetPosition(7);
+		ASSERT_EQ(shorts[0], bytes.ReadUInt16());
+		bytes.SetPosition(7 + 37 * 2 + 36 * 4);
+		ASSERT_EQ(ints[36], bytes.ReadUInt32());
+
+		bytes.SetPosition(7);
+		u16 shortsOut[37];
+		u32 intsOut[37];
+		u64 longsOut[37];
+		f32 floatsOut[37];
+		f64 doublesOut[37];
+		ASSERT_TRUE(bytes.ReadUInt16Array(shortsOut, 37));
+		ASSERT_TRUE(bytes.ReadUInt32Array(intsOut, 37));
+		ASSERT_TRUE(bytes.ReadUInt64Array(longsOut, 37));
+		ASSERT_TRUE(bytes.ReadFloat32Array(floatsOut, 37));
+		ASSERT_TRUE(bytes.ReadFloat64Array(doublesOut, 37));
+		ASSERT_EQ(0, memcmp(shorts, shortsOut, sizeof(shorts)));
+		ASSERT_EQ(0, memcmp(ints, intsOut, sizeof(ints)));
+		ASSERT_EQ(0, memcmp(longs, longsOut, sizeof(longs)));
+		ASSERT_EQ(0, memcmp(floats, floatsOut, sizeof(floats)));
+		ASSERT_EQ(0, memcmp(doubles, doublesOut, sizeof(doubles)));
+		ASSERT_FALSE(bytes.HasError());
+	}
+
+	//Reading past the end copies nothing
+	ByteArray small(6);
+	u32 out[2] = { 7, 7 };
+	ASSERT_FALSE(small.ReadUInt32Array(out, 2));
+	ASSERT_TRUE(small.HasError());
+	ASSERT_EQ(7u, out[0]);
+
+	//The template takes anything of a supported size
+	ByteArray growable(0, bytearray::GROWABLE);
+	growable.SetEndianess(endian::BIG_ENDIAN);
+	endian::ENDIAN_TYPE types[3] = { endian::BIG_ENDIAN, endian::LITTLE_ENDIAN, endian::BIG_ENDIAN };
+	growable.WriteArray(types, 3);
+	growable.SetPosition(0);
+	endian::ENDIAN_TYPE typesOut[3];
+	ASSERT_TRUE(growable.ReadArray(typesOut, 3));
+	ASSERT_EQ(endian::LITTLE_ENDIAN, typesOut[1]);
+}
+
+TEST_F(ByteArrayTest, TestStrings)
+{
+	//"Grüße, 日本"
+	string text = "Gr\xC3\xBC\xC3\x9F" "e, \xE6\x97\xA5\xE6\x9C\xAC";
+	string longText(300, 'x');
+
+	ByteArray bytes(0, bytearray::GROWABLE);
+	bytes.WriteString(text);
+	bytes.WriteString("");
+	bytes.WriteString(longText);
+	bytes.WriteString("abc", 2);
+	ASSERT_EQ(1 + text.size() + 1 + 2 + longText.size() + 1 + 2, bytes.GetLength());
+
+	bytes.SetPosition(0);
+	ASSERT_EQ(text, bytes.ReadString(bytearray::VALIDATE_UTF8));
+	ASSERT_EQ(string(), bytes.ReadString());
+	StringView view = bytes.ReadStringView();
+	ASSERT_EQ(300u, view.length);
+	ASSERT_EQ(reinterpret_cast<const char*>(bytes.GetRawBytes()) + 1 + text.size() + 1 + 2, view.data);
+	ASSERT_EQ("ab", bytes.ReadString());
+	ASSERT_FALSE(bytes.HasError());
+
+	//Length past the end
+	ByteArray truncated(0, bytearray::GROWABLE);
+	truncated.WriteVarUInt32(10);
+	truncated.WriteUInt8('a');
+	truncated.SetPosition(0);
+	ASSERT_EQ(string(), truncated.ReadString());
+	ASSERT_TRUE(truncated.HasError());
+	ASSERT_EQ(0u, truncated.GetPosition());
+	ASSERT_EQ(0, truncated.ReadStringView().data);
+}
+
+TEST_F(ByteArrayTest, TestStringValidation)
+{
+	ASSERT_TRUE(ByteArray::IsValidUTF8("plain ascii text that runs past a word", 38));
+	ASSERT_TRUE(ByteArray::IsValidUTF8("\xF0\x9F\x98\x80", 4));
+	//Truncated sequence, overlong '/', a surrogate and a lone continuation byte
+	ASSERT_FALSE(ByteArray::IsValidUTF8("abcdefgh\xE6\x97", 10));
+	ASSERT_FALSE(ByteArray::IsValidUTF8("\xC0\xAF", 2));
+	ASSERT_FALSE(ByteArray::IsValidUTF8("\xED\xA0\x80", 3));
+	ASSERT_FALSE(ByteArray::IsValidUTF8("\x80", 1));
+
+	ByteArray bytes(0, bytearray::GROWABLE);
+	bytes.WriteString("\xC0\xAF");
+	bytes.SetPosition(0);
+	ASSERT_EQ(string(), bytes.ReadString(bytearray::VALIDATE_UTF8));
+	ASSERT_TRUE(bytes.HasError());
+	ASSERT_EQ(0u, bytes.GetPosition());
+
+	//Unchecked reads take it as is
+	bytes.ClearError();
+	ASSERT_EQ(2u, bytes.ReadStringView().length);
+	ASSERT_FALSE(bytes.HasError());
+}
+
 
 
 
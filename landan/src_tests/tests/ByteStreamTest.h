@@ -0,0 +1,177 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: ByteStreamTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _BYTESTREAMTEST_H_
+#define _BYTESTREAMTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <landan/core/LandanTypes.h>
+#include <landan/util/ByteArray.h>
+#include <landan/util/ByteStream.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class ByteStreamTest : public ::testing::Test
+{
+
+public:
+	//Same values through the runtime ByteArray path and a compile time writer
+	template<endian::ENDIAN_TYPE ENDIANESS>
+	static void CheckMatchesByteArray()
+	{
+		ByteArray expected(0, bytearray::GROWABLE);
+		expected.SetEndianess(ENDIANESS);
+		expected.WriteUInt8(0x81);
+		expected.WriteUInt16(0x0102);
+		expected.WriteUInt32(0x01020304);
+		expected.WriteUInt64(0x0102030405060708ull);
+		expected.WriteInt16(-2);
+		expected.WriteInt32(-3);
+		expected.WriteInt64(-4);
+		expected.WriteFloat32(1.5f);
+		expected.WriteFloat64(-0.25);
+
+		//The writer ignores the array's own setting
+		ByteArray actual(0, bytearray::GROWABLE);
+		actual.SetEndianess(ENDIANESS == endian::BIG_ENDIAN ? endian::LITTLE_ENDIAN : endian::BIG_ENDIAN);
+		BasicByteWriter<ENDIANESS> writer(actual);
+		writer.WriteUInt8(0x81);
+		writer.WriteUInt16(0x0102);
+		writer.WriteUInt32(0x01020304);
+		writer.WriteUInt64(0x0102030405060708ull);
+		writer.WriteInt16(-2);
+		writer.WriteInt32(-3);
+		writer.WriteInt64(-4);
+		writer.WriteFloat32(1.5f);
+		writer.WriteFloat64(-0.25);
+
+		ASSERT_EQ(expected.GetLength(), actual.GetLength());
+		ASSERT_EQ(0, memcmp(expected.GetRawBytes(), actual.GetRawBytes(), expected.GetLength()));
+
+		BasicByteReader<ENDIANESS> reader(expected);
+		reader.SetPosition(0);
+		ASSERT_EQ(0x81, reader.ReadUInt8());
+		ASSERT_EQ(0x0102, reader.ReadUInt16());
+		ASSERT_EQ(0x01020304u, reader.ReadUInt32());
+		ASSERT_EQ(0x0102030405060708ull, reader.ReadUInt64());
+		ASSERT_EQ(-2, reader.ReadInt16());
+		ASSERT_EQ(-3, reader.ReadInt32());
+		ASSERT_EQ(-4, reader.ReadInt64());
+		ASSERT_EQ(1.5f, reader.ReadFloat32());
+		ASSERT_EQ(-0.25, reader.ReadFloat64());
+		ASSERT_FALSE(reader.HasError());
+	}
+};
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(ByteStreamTest, TestSystemEndian)
+{
+	u16 value = 1;
+	u8 first;
+	memcpy(&first, &value, 1);
+	endian::ENDIAN_TYPE expected = (first == 1) ? endian::LITTLE_ENDIAN : endian::BIG_ENDIAN;
+	ASSERT_EQ(expected, endian::SYSTEM_ENDIAN);
+	ASSERT_EQ(expected, DetermineSystemEndianess());
+}
+
+TEST_F(ByteStreamTest, TestMatchesByteArray)
+{
+	CheckMatchesByteArray<endian::LITTLE_ENDIAN>();
+	CheckMatchesByteArray<endian::BIG_ENDIAN>();
+}
+
+TEST_F(ByteStreamTest, TestArrays)
+{
+	u32 values[19];
+	for (u32 i = 0; i < 19; i++)
+	{
+		values[i] = 0x01020304u * (i + 1);
+	}
+
+	ByteArray bytes(0, bytearray::GROWABLE);
+	BigEndianWriter writer(bytes);
+	writer.WriteArray(values, 19);
+	ASSERT_EQ(76u, bytes.GetLength());
+	ASSERT_EQ(0x01, bytes.GetRawBytes()[0]);
+
+	BigEndianReader reader(bytes);
+	reader.SetPosition(0);
+	u32 out[19];
+	ASSERT_TRUE(reader.ReadArray(out, 19));
+	ASSERT_EQ(0, memcmp(values, out, sizeof(values)));
+
+	ASSERT_FALSE(reader.ReadArray(out, 1));
+	ASSERT_TRUE(reader.HasError());
+}
+
+TEST_F(ByteStreamTest, TestBounds)
+{
+	ByteArray bytes(3);
+	LittleEndianWriter writer(bytes);
+	writer.WriteUInt16(0x0102);
+	writer.WriteUInt16(0x0304);
+	ASSERT_TRUE(writer.HasError());
+	ASSERT_EQ(2u, writer.GetPosition());
+
+	bytes.ClearError();
+	LittleEndianReader reader(bytes);
+	reader.SetPosition(0);
+	ASSERT_EQ(0x0102, reader.ReadUInt16());
+	ASSERT_EQ(0u, reader.ReadUInt32());
+	ASSERT_TRUE(reader.HasError());
+}
+
+
+} /* namespace landan */
+#endif /* _BYTESTREAMTEST_H_ */
@@ -0,0 +1,172 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: ByteSwapTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _BYTESWAPTEST_H_
+#define _BYTESWAPTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <landan/core/LandanTypes.h>
+#include <landan/util/ByteSwap.h>
+#include <landan/util/EndianUtil.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class ByteSwapTest : public ::testing::Test
+{
+
+protected:
+	virtual void SetUp()
+	{
+		m_kernel = ByteSwap::GetKernel();
+	}
+	virtual void TearDown()
+	{
+		ByteSwap::SetKernel(m_kernel);
+	}
+
+	byteswap::KERNEL m_kernel;
+};
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(ByteSwapTest, TestKernels)
+{
+	//Odd counts and an unaligned start so every kernel runs its vector loop and its tail
+	const u32 COUNT = 211;
+	std::vector<u8> source(COUNT * 8 + 1);
+	for (u32 i = 0; i < source.size(); i++)
+	{
+		source[i] = static_cast<u8>(i * 7 + 3);
+	}
+
+	for (u32 kernel = byteswap::SCALAR; kernel <= static_cast<u32>(ByteSwap::GetSupportedKernel()); kernel++)
+	{
+		ByteSwap::SetKernel(static_cast<byteswap::KERNEL>(kernel));
+		ASSERT_EQ(kernel, static_cast<u32>(ByteSwap::GetKernel()));
+
+		for (u32 count = 0; count <= COUNT; count += 13)
+		{
+			std::vector<u8> out(COUNT * 8 + 1, 0);
+			ByteSwap::Copy16(&out[1], &source[1], count);
+			for (u32 i = 0; i < count; i++)
+			{
+				u16 in;
+				u16 swapped;
+				memcpy(&in, &source[1 + i * 2], 2);
+				memcpy(&swapped, &out[1 + i * 2], 2);
+				ASSERT_EQ(SwapUInt16(in), swapped);
+			}
+			ASSERT_EQ(0, out[1 + count * 2]);
+
+			ByteSwap::Copy32(&out[1], &source[1], count);
+			for (u32 i = 0; i < count; i++)
+			{
+				u32 in;
+				u32 swapped;
+				memcpy(&in, &source[1 + i * 4], 4);
+				memcpy(&swapped, &out[1 + i * 4], 4);
+				ASSERT_EQ(SwapUInt32(in), swapped);
+			}
+
+			ByteSwap::Copy64(&out[1], &source[1], count);
+			for (u32 i = 0; i < count; i++)
+			{
+				u64 in;
+				u64 swapped;
+				memcpy(&in, &source[1 + i * 8], 8);
+				memcpy(&swapped, &out[1 + i * 8], 8);
+				ASSERT_EQ(SwapUInt64(in), swapped);
+			}
+		}
+	}
+}
+
+TEST_F(ByteSwapTest, TestInPlace)
+{
+	std::vector<u32> values(100);
+	for (u32 i = 0; i < values.size(); i++)
+	{
+		values[i] = 0x01020304u + i;
+	}
+	ByteSwap::Copy32(&values[0], &values[0], 100);
+	ASSERT_EQ(0x04030201u, values[0]);
+	ASSERT_EQ(SwapUInt32(0x01020304u + 99), values[99]);
+	ByteSwap::Copy32(&values[0], &values[0], 100);
+	ASSERT_EQ(0x01020304u + 50, values[50]);
+}
+
+TEST_F(ByteSwapTest, TestEndianUtil)
+{
+	ASSERT_EQ(0x0201, SwapUInt16(0x0102));
+	ASSERT_EQ(0x04030201u, SwapUInt32(0x01020304u));
+	ASSERT_EQ(0x0807060504030201ull, SwapUInt64(0x0102030405060708ull));
+	ASSERT_EQ(-2, SwapInt16(SwapInt16(-2)));
+	ASSERT_EQ(static_cast<i32>(0xFFFFFF80u), SwapInt32(static_cast<i32>(0x80FFFFFFu)));
+	ASSERT_EQ(1.5f, SwapFloat32(SwapFloat32(1.5f)));
+	ASSERT_EQ(-0.25, SwapFloat64(SwapFloat64(-0.25)));
+
+	std::vector<u64> longs(33, 0x0102030405060708ull);
+	SwapUInt64Buffer(&longs[0], longs.size());
+	ASSERT_EQ(0x0807060504030201ull, longs[0]);
+	ASSERT_EQ(0x0807060504030201ull, longs[32]);
+
+	f32 floats[5] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+	SwapFloat32Buffer(floats, 5);
+	SwapFloat32Buffer(floats, 5);
+	ASSERT_EQ(5.0f, floats[4]);
+}
+
+
+} /* namespace landan */
+#endif /* _BYTESWAPTEST_H_ */
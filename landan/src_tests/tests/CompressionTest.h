@@ -0,0 +1,245 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: CompressionTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _COMPRESSIONTEST_H_
+#define _COMPRESSIONTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <landan/core/LandanTypes.h>
+#include <landan/file/CompressedStream.h>
+#include <landan/file/File.h>
+#include <landan/file/FileStream.h>
+#include <landan/util/ByteArray.h>
+#include <landan/util/Compression.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class CompressionTest : public ::testing::Test
+{
+
+protected:
+	virtual void SetUp()
+	{
+		//Something like a recording, repetitive frames with a little noise, then a stretch of pure noise
+		u32 seed = 12345;
+		m_contents.resize(1000000);
+		for (u32 i = 0; i < m_contents.size(); i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			if (i < 800000)
+			{
+				m_contents[i] = static_cast<u8>((i % 97 < 90) ? (i % 13) : (seed >> 24));
+			}
+			else
+			{
+				m_contents[i] = static_cast<u8>(seed >> 24);
+			}
+		}
+	}
+	virtual void TearDown()
+	{
+		File(PATH).Remove();
+	}
+
+	void RoundTripBlock(const u8 *bytes, u32 length)
+	{
+		std::vector<u8> compressed(Lz4::GetMaxCompressedSize(length));
+		u32 compressedLength = Lz4::Compress(bytes, length, &compressed[0], static_cast<u32>(compressed.size()));
+		ASSERT_LT(0u, compressedLength);
+		std::vector<u8> decompressed(length + 1);
+		ASSERT_EQ(static_cast<i32>(length), Lz4::Decompress(&compressed[0], compressedLength, &decompressed[0], length));
+		ASSERT_EQ(0, memcmp(bytes, &decompressed[0], length));
+	}
+
+	std::vector<u8> m_contents;
+
+	static const string PATH;
+
+};
+
+const string CompressionTest::PATH = "CompressionTest.lzc";
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(CompressionTest, TestLz4)
+{
+	//Every short length, where the end of block rules matter most
+	for (u32 length = 0; length < 40; length++)
+	{
+		RoundTripBlock(&m_contents[0], length);
+	}
+	RoundTripBlock(&m_contents[0], static_cast<u32>(m_contents.size()));
+	RoundTripBlock(&m_contents[800000], 200000);
+
+	//Long runs need the extra length bytes and overlapping copies
+	std::vector<u8> run(100000, 'a');
+	RoundTripBlock(&run[0], static_cast<u32>(run.size()));
+	std::vector<u8> compressed(Lz4::GetMaxCompressedSize(100000));
+	ASSERT_GT(1000u, Lz4::Compress(&run[0], 100000, &compressed[0], static_cast<u32>(compressed.size())));
+
+	//Too small to hold the result
+	ASSERT_EQ(0u, Lz4::Compress(&m_contents[800000], 1000, &compressed[0], 500));
+}
+
+TEST_F(CompressionTest, TestLz4Reference)
+{
+	//Produced by the reference lz4 tool
+	const u8 block[] = {
+		0x6F, 0x68, 0x65, 0x6C, 0x6C, 0x6F, 0x20, 0x06, 0x00, 0x0B, 0xF1, 0x16, 0x77, 0x6F, 0x72, 0x6C, 0x64, 0x2C, 0x20, 0x74,
+		0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A,
+		0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x1F, 0x00, 0x83, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67,
+		0x51, 0x00, 0x50, 0x77, 0x6F, 0x72, 0x6C, 0x64
+	};
+	const char *text = "hello hello hello hello hello hello world, the quick brown fox jumps over the lazy dog hello world";
+	u32 length = static_cast<u32>(strlen(text));
+
+	char out[128];
+	ASSERT_EQ(static_cast<i32>(length), Lz4::Decompress(block, sizeof(block), reinterpret_cast<u8*>(out), sizeof(out)));
+	ASSERT_EQ(0, memcmp(text, out, length));
+
+	//Malformed input fails rather than reading or writing out of bounds
+	ASSERT_EQ(-1, Lz4::Decompress(block, sizeof(block), reinterpret_cast<u8*>(out), length - 1));
+	ASSERT_EQ(-1, Lz4::Decompress(block, 20, reinterpret_cast<u8*>(out), sizeof(out)));
+	const u8 badOffset[] = { 0x10, 'a', 0x05, 0x00, 0x00 };
+	ASSERT_EQ(-1, Lz4::Decompress(badOffset, sizeof(badOffset), reinterpret_cast<u8*>(out), sizeof(out)));
+}
+
+TEST_F(CompressionTest, TestByteArray)
+{
+	u32 size = static_cast<u32>(m_contents.size());
+	ByteArray in(size);
+	memcpy(in.GetRawBytes(), &m_contents[0], size);
+
+	//Small chunks so there are plenty to spread over threads
+	ByteArray compressed(0, bytearray::GROWABLE);
+	compressed.WriteUInt32(0xCAFEF00D);
+	ASSERT_TRUE(Compression::Compress(in, compressed, 64 * 1024, 4));
+	ASSERT_EQ(size, in.GetPosition());
+	ASSERT_GT(size, compressed.GetLength());
+	ASSERT_EQ(compressed.GetLength(), compressed.GetPosition());
+	compressed.WriteUInt32(0xDEADBEEF);
+
+	for (u32 threads = 1; threads <= 4; threads += 3)
+	{
+		ByteArray out(0, bytearray::GROWABLE);
+		compressed.SetPosition(4);
+		ASSERT_TRUE(Compression::Decompress(compressed, out, threads));
+		ASSERT_EQ(size, out.GetLength());
+		ASSERT_EQ(0, memcmp(&m_contents[0], out.GetRawBytes(), size));
+		//The stream ends itself, whatever follows is left alone
+		ASSERT_EQ(0xDEADBEEF, compressed.ReadUInt32());
+	}
+
+	//Fixed arrays that are too small fail and nothing moves
+	ByteArray small(size - 1);
+	compressed.SetPosition(4);
+	ASSERT_FALSE(Compression::Decompress(compressed, small));
+	ASSERT_EQ(4u, compressed.GetPosition());
+	ASSERT_EQ(0u, small.GetPosition());
+
+	//There are no checksums, but structural damage is caught. Here the first chunk claims to be one byte longer.
+	compressed.GetRawBytes()[4 + compression::HEADER_SIZE + 1] += 1;
+	ByteArray corrupt(0, bytearray::GROWABLE);
+	ASSERT_FALSE(Compression::Decompress(compressed, corrupt, 2));
+	ASSERT_EQ(0u, corrupt.GetLength());
+
+	//Empty input is still a stream
+	ByteArray empty(0);
+	ByteArray emptyCompressed(64);
+	ASSERT_TRUE(Compression::Compress(empty, emptyCompressed));
+	ASSERT_EQ(compression::HEADER_SIZE + compression::CHUNK_HEADER_SIZE, emptyCompressed.GetPosition());
+	emptyCompressed.SetPosition(0);
+	ByteArray emptyOut(0, bytearray::GROWABLE);
+	ASSERT_TRUE(Compression::Decompress(emptyCompressed, emptyOut));
+	ASSERT_EQ(0u, emptyOut.GetLength());
+}
+
+TEST_F(CompressionTest, TestFileStream)
+{
+	u32 size = static_cast<u32>(m_contents.size());
+	FileWriter writer;
+	ASSERT_TRUE(writer.Open(PATH, file::WRITE));
+	CompressedWriter compressedWriter(writer, 100000);
+	for (u32 position = 0; position < size; position += 7777)
+	{
+		u32 length = (size - position < 7777) ? size - position : 7777;
+		ASSERT_TRUE(compressedWriter.Append(&m_contents[position], length));
+	}
+	ASSERT_TRUE(compressedWriter.Finish());
+	ASSERT_FALSE(compressedWriter.Append(&m_contents[0], 1));
+	ASSERT_EQ(size, compressedWriter.GetBytesIn());
+	ASSERT_EQ(compressedWriter.GetBytesOut(), writer.Tell());
+	ASSERT_TRUE(writer.Close());
+
+	//The file holds the same stream format the ByteArray path reads
+	ByteArray file = File(PATH).ReadAll();
+	ByteArray out(0, bytearray::GROWABLE);
+	ASSERT_TRUE(Compression::Decompress(file, out));
+	ASSERT_EQ(size, out.GetLength());
+
+	FileReader reader;
+	ASSERT_TRUE(reader.Open(PATH));
+	CompressedReader compressedReader(reader);
+	std::vector<u8> read(size + 10);
+	ASSERT_EQ(12345u, compressedReader.Read(&read[0], 12345));
+	ASSERT_EQ(size - 12345, compressedReader.Read(&read[12345], size));
+	ASSERT_TRUE(compressedReader.IsEndOfStream());
+	ASSERT_FALSE(compressedReader.HasError());
+	ASSERT_EQ(0, memcmp(&m_contents[0], &read[0], size));
+	ASSERT_TRUE(reader.IsEndOfFile());
+}
+
+
+} /* namespace landan */
+#endif /* _COMPRESSIONTEST_H_ */
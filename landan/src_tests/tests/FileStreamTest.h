@@ -0,0 +1,230 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: FileStreamTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _FILESTREAMTEST_H_
+#define _FILESTREAMTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <landan/core/LandanTypes.h>
+#include <landan/file/File.h>
+#include <landan/file/FileStream.h>
+#include <landan/util/ByteArray.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class FileStreamTest : public ::testing::Test
+{
+
+protected:
+	virtual void SetUp()
+	{
+		//Several buffers worth of a known pattern, byte i is i * 13
+		m_contents.resize(5 * BUFFER_SIZE + 321);
+		for (u32 i = 0; i < m_contents.size(); i++)
+		{
+			m_contents[i] = static_cast<u8>(i * 13);
+		}
+	}
+	virtual void TearDown()
+	{
+		File(PATH).Remove();
+	}
+
+	std::vector<u8> m_contents;
+
+	static const string PATH;
+	static const u32 BUFFER_SIZE = 4096;
+
+};
+
+const string FileStreamTest::PATH = "FileStreamTest.bin";
+const u32 FileStreamTest::BUFFER_SIZE;
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(FileStreamTest, TestWriteAndRead)
+{
+	FileWriter writer(BUFFER_SIZE);
+	ASSERT_EQ(BUFFER_SIZE, writer.GetBufferSize());
+	ASSERT_TRUE(writer.Open(PATH, file::WRITE));
+
+	//Small appends stay buffered, big ones go straight through
+	u32 position = 0;
+	u32 sizes[] = { 1, 7, 100, 3 * BUFFER_SIZE, 13, BUFFER_SIZE - 1, 2000 };
+	for (u32 i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		ASSERT_TRUE(writer.Append(&m_contents[position], sizes[i]));
+		position += sizes[i];
+		ASSERT_EQ(position, writer.Tell());
+	}
+	ASSERT_TRUE(writer.Append(&m_contents[position], static_cast<u32>(m_contents.size()) - position));
+	ASSERT_TRUE(writer.Close());
+	ASSERT_FALSE(writer.IsOpen());
+
+	FileReader reader(BUFFER_SIZE);
+	ASSERT_TRUE(reader.Open(PATH));
+	ASSERT_EQ(m_contents.size(), reader.GetSize());
+
+	std::vector<u8> read(m_contents.size());
+	position = 0;
+	u32 readSizes[] = { 3, 4000, 2 * BUFFER_SIZE, 1, 5 };
+	for (u32 i = 0; i < sizeof(readSizes) / sizeof(readSizes[0]); i++)
+	{
+		ASSERT_EQ(readSizes[i], reader.Read(&read[position], readSizes[i]));
+		position += readSizes[i];
+		ASSERT_EQ(position, reader.Tell());
+	}
+	u32 remaining = static_cast<u32>(m_contents.size()) - position;
+	ASSERT_EQ(remaining, reader.Read(&read[position], remaining + 100));
+	ASSERT_TRUE(reader.IsEndOfFile());
+	ASSERT_EQ(0u, reader.Read(&read[0], 1));
+	ASSERT_EQ(0, memcmp(&m_contents[0], &read[0], m_contents.size()));
+}
+
+#ifndef _WIN32
+TEST_F(FileStreamTest, TestFailedFlushKeepsPosition)
+{
+	//Every write to /dev/full fails, so nothing may count towards the file position
+	FileWriter writer(BUFFER_SIZE);
+	ASSERT_TRUE(writer.Open("/dev/full", file::WRITE));
+	ASSERT_TRUE(writer.Append(&m_contents[0], 100));
+	ASSERT_FALSE(writer.Flush());
+	ASSERT_EQ(0u, writer.Tell());
+	ASSERT_FALSE(writer.Append(&m_contents[0], 2 * BUFFER_SIZE));
+	ASSERT_EQ(0u, writer.Tell());
+	writer.Close();
+}
+#endif
+
+TEST_F(FileStreamTest, TestSeek)
+{
+	FileWriter writer(BUFFER_SIZE);
+	ASSERT_TRUE(writer.Open(PATH, file::WRITE));
+	ASSERT_TRUE(writer.Append(&m_contents[0], static_cast<u32>(m_contents.size())));
+
+	//Patch the start, then carry on from the end
+	u8 patch[] = { 0xAA, 0xBB };
+	ASSERT_TRUE(writer.Seek(10));
+	ASSERT_TRUE(writer.Append(patch, 2));
+	ASSERT_EQ(12u, writer.Tell());
+	ASSERT_TRUE(writer.Seek(m_contents.size()));
+	ASSERT_TRUE(writer.Append(patch, 2));
+	ASSERT_TRUE(writer.Close());
+	m_contents[10] = 0xAA;
+	m_contents[11] = 0xBB;
+	m_contents.push_back(0xAA);
+	m_contents.push_back(0xBB);
+
+	FileReader reader(BUFFER_SIZE);
+	ASSERT_TRUE(reader.Open(PATH));
+	u8 byte;
+	ASSERT_TRUE(reader.Seek(3 * BUFFER_SIZE + 5));
+	ASSERT_EQ(1u, reader.Read(&byte, 1));
+	ASSERT_EQ(m_contents[3 * BUFFER_SIZE + 5], byte);
+
+	//Backwards inside the buffer, then outside it
+	ASSERT_TRUE(reader.Seek(3 * BUFFER_SIZE + 1));
+	ASSERT_EQ(1u, reader.Read(&byte, 1));
+	ASSERT_EQ(m_contents[3 * BUFFER_SIZE + 1], byte);
+	ASSERT_TRUE(reader.Seek(10));
+	ASSERT_EQ(1u, reader.Read(&byte, 1));
+	ASSERT_EQ(0xAA, byte);
+	ASSERT_TRUE(reader.Seek(m_contents.size() - 1));
+	ASSERT_EQ(1u, reader.Read(&byte, 1));
+	ASSERT_EQ(0xBB, byte);
+	ASSERT_TRUE(reader.IsEndOfFile());
+}
+
+TEST_F(FileStreamTest, TestByteArray)
+{
+	ByteArray out(static_cast<u32>(m_contents.size()));
+	memcpy(out.GetRawBytes(), &m_contents[0], m_contents.size());
+	FileWriter writer(BUFFER_SIZE);
+	ASSERT_TRUE(writer.Open(PATH, file::WRITE));
+	ASSERT_TRUE(writer.Append(out));
+	ASSERT_TRUE(writer.Close());
+
+	//APPEND keeps what's there
+	ASSERT_TRUE(writer.Open(PATH, file::APPEND));
+	ASSERT_EQ(m_contents.size(), writer.Tell());
+	ASSERT_TRUE(writer.Close());
+
+	FileReader reader(BUFFER_SIZE);
+	ASSERT_TRUE(reader.Open(PATH));
+
+	//Growable arrays grow to fit but not past the end of the file
+	ByteArray in(0, bytearray::GROWABLE);
+	ASSERT_EQ(100u, reader.Read(in, 100));
+	ASSERT_EQ(100u, in.GetLength());
+	ASSERT_EQ(100u, in.GetPosition());
+	u32 rest = static_cast<u32>(m_contents.size()) - 100;
+	ASSERT_EQ(rest, reader.Read(in, rest + 1000));
+	ASSERT_EQ(m_contents.size(), in.GetLength());
+	ASSERT_EQ(0, memcmp(&m_contents[0], in.GetRawBytes(), m_contents.size()));
+
+	//Fixed arrays take what fits
+	ByteArray fixed(10);
+	fixed.SetPosition(4);
+	ASSERT_TRUE(reader.Seek(0));
+	ASSERT_EQ(6u, reader.Read(fixed, 100));
+	ASSERT_EQ(10u, fixed.GetPosition());
+	ASSERT_EQ(m_contents[5], fixed.GetRawBytes()[9]);
+
+	ASSERT_FALSE(reader.Open("FileStreamTest.missing"));
+	ASSERT_FALSE(reader.IsOpen());
+}
+
+
+} /* namespace landan */
+#endif /* _FILESTREAMTEST_H_ */
@@ -0,0 +1,174 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: FixedTimeStepTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _FIXEDTIMESTEPTEST_H_
+#define _FIXEDTIMESTEPTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/timer/FixedTimeStep.h>
+#include <landan/timer/Timer.h>
+#include <limits>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class FixedTimeStepTest : public ::testing::Test
+{
+
+protected:
+	//Runs one frame at currentTicks the way the scaffold loops do and returns the steps it took
+	u32 RunFrame(FixedTimeStep &timeStep, u64 currentTicks)
+	{
+		timeStep.Advance(currentTicks);
+		u32 steps = 0;
+		while (timeStep.ConsumeStep())
+		{
+			steps++;
+		}
+		EXPECT_EQ(steps, timeStep.EndFrame());
+		return steps;
+	}
+
+};
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(FixedTimeStepTest, TestInvalid)
+{
+	FixedTimeStep timeStep;
+	ASSERT_FALSE(timeStep.SetStep(0.0f, 5));
+	ASSERT_FALSE(timeStep.SetStep(-1.0f, 5));
+	ASSERT_FALSE(timeStep.SetStep(10.0f, 0));
+	ASSERT_FALSE(timeStep.SetStep(std::numeric_limits<f32>::quiet_NaN(), 5));
+	ASSERT_FALSE(timeStep.SetStep(std::numeric_limits<f32>::infinity(), 5));
+	ASSERT_FALSE(timeStep.SetStep(std::numeric_limits<f32>::max(), 5));
+	ASSERT_FALSE(timeStep.ConsumeStep());
+	ASSERT_FLOAT_EQ(1.0f, timeStep.GetInterpolationAlpha());
+}
+
+TEST_F(FixedTimeStepTest, TestStepTicks)
+{
+	//A 60Hz step isn't a whole number of ticks, it has to round the same as the f64 product
+	FixedTimeStep timeStep;
+	f32 stepMS = 1000.0f / 60.0f;
+	ASSERT_TRUE(timeStep.SetStep(stepMS, 5));
+	u64 expected = static_cast<u64>(static_cast<f64>(stepMS) * static_cast<f64>(Timer::TICKS_PER_MILLISECOND));
+	ASSERT_EQ(expected, timeStep.GetStepTicks());
+	ASSERT_FLOAT_EQ(stepMS, timeStep.GetStepMilliSeconds());
+	ASSERT_EQ(5u, timeStep.GetMaxStepsPerFrame());
+}
+
+TEST_F(FixedTimeStepTest, TestSteady)
+{
+	FixedTimeStep timeStep;
+	ASSERT_TRUE(timeStep.SetStep(10.0f, 5));
+	u64 step = timeStep.GetStepTicks();
+	timeStep.Reset(1000);
+
+	//One step is banked so the first frame Updates straight away
+	ASSERT_EQ(0u, timeStep.GetTicksUntilStep(1000));
+	ASSERT_EQ(1u, RunFrame(timeStep, 1000));
+	ASSERT_EQ(step, timeStep.GetTicksUntilStep(1000));
+	ASSERT_EQ(step / 4, timeStep.GetTicksUntilStep(1000 + step * 3 / 4));
+
+	//Looking doesn't bank anything
+	ASSERT_EQ(0u, timeStep.GetAccumulatedTicks());
+
+	ASSERT_EQ(0u, RunFrame(timeStep, 1000 + step / 2));
+	ASSERT_FLOAT_EQ(0.5f, timeStep.GetInterpolationAlpha());
+	ASSERT_EQ(1u, RunFrame(timeStep, 1000 + step + step / 2));
+	ASSERT_FLOAT_EQ(0.5f, timeStep.GetInterpolationAlpha());
+
+	//Frame cut short with a step still banked, the way a quit mid frame leaves it
+	timeStep.Advance(1000 + step * 3);
+	timeStep.EndFrame();
+	ASSERT_FLOAT_EQ(1.0f, timeStep.GetInterpolationAlpha());
+}
+
+TEST_F(FixedTimeStepTest, TestCatchUp)
+{
+	FixedTimeStep timeStep;
+	ASSERT_TRUE(timeStep.SetStep(10.0f, 5));
+	u64 step = timeStep.GetStepTicks();
+	timeStep.Reset(0);
+	ASSERT_EQ(1u, RunFrame(timeStep, 0));
+
+	//A frame three and a bit steps late runs all three and keeps the remainder
+	ASSERT_EQ(3u, RunFrame(timeStep, step * 3 + 7));
+	ASSERT_EQ(7u, timeStep.GetAccumulatedTicks());
+	ASSERT_EQ(1u, RunFrame(timeStep, step * 4));
+}
+
+TEST_F(FixedTimeStepTest, TestDropBacklog)
+{
+	FixedTimeStep timeStep;
+	ASSERT_TRUE(timeStep.SetStep(10.0f, 5));
+	u64 step = timeStep.GetStepTicks();
+	timeStep.Reset(0);
+	ASSERT_EQ(1u, RunFrame(timeStep, 0));
+
+	//Twenty steps behind, five run and the rest are dropped bar the partial step
+	ASSERT_EQ(5u, RunFrame(timeStep, step * 20 + 3));
+	ASSERT_EQ(3u, timeStep.GetAccumulatedTicks());
+	ASSERT_EQ(0u, RunFrame(timeStep, step * 20 + 4));
+	ASSERT_EQ(1u, RunFrame(timeStep, step * 21));
+
+	//Stopping short of the cap keeps the backlog for the next frame
+	timeStep.Advance(step * 24);
+	ASSERT_TRUE(timeStep.ConsumeStep());
+	ASSERT_EQ(1u, timeStep.EndFrame());
+	ASSERT_EQ(step * 2, timeStep.GetAccumulatedTicks());
+}
+
+
+} /* namespace landan */
+#endif /* _FIXEDTIMESTEPTEST_H_ */
@@ -0,0 +1,120 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: FramePacerTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _FRAMEPACERTEST_H_
+#define _FRAMEPACERTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/timer/FramePacer.h>
+#include <landan/timer/Timer.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class FramePacerTest : public ::testing::Test
+{
+
+protected:
+	virtual ~FramePacerTest(){
+
+	}
+	virtual void SetUp()
+	{
+		Timer::Init();
+	}
+	virtual void TearDown() {
+
+	}
+
+};
+
+TEST_F(FramePacerTest, TestWaitReachesDeadline)
+{
+	FramePacer pacer;
+
+	for (u32 i = 0; i < 5; i++)
+	{
+		u64 deadline = Timer::GetTicks() + 2ULL * Timer::TICKS_PER_MILLISECOND;
+		pacer.WaitUntil(deadline);
+		ASSERT_GE(Timer::GetTicks(), deadline);
+	}
+
+	ASSERT_EQ(5ULL, pacer.GetWaitCount());
+	ASSERT_EQ(0ULL, pacer.GetMissedCount());
+	ASSERT_LE(pacer.GetMinLatenessTicks(), pacer.GetMaxLatenessTicks());
+	ASSERT_GE(pacer.GetJitterTicks(), 0.0);
+}
+
+TEST_F(FramePacerTest, TestMissedDeadline)
+{
+	FramePacer pacer;
+
+	pacer.WaitUntil(Timer::GetTicks() - 1);
+
+	ASSERT_EQ(0ULL, pacer.GetWaitCount());
+	ASSERT_EQ(1ULL, pacer.GetMissedCount());
+
+	pacer.ResetStats();
+	ASSERT_EQ(0ULL, pacer.GetMissedCount());
+}
+
+TEST_F(FramePacerTest, TestSleepsMostOfTheWait)
+{
+	FramePacer pacer(Timer::TICKS_PER_MILLISECOND);
+
+	pacer.WaitUntil(Timer::GetTicks() + 20ULL * Timer::TICKS_PER_MILLISECOND);
+
+	//The spin window is only a millisecond so the bulk of a 20ms wait should have been spent asleep
+	ASSERT_GT(pacer.GetTotalSleptTicks(), pacer.GetTotalSpunTicks());
+}
+
+
+} /* namespace landan */
+#endif /* _FRAMEPACERTEST_H_ */
@@ -0,0 +1,166 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: FrameProfilerTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _FRAMEPROFILERTEST_H_
+#define _FRAMEPROFILERTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/profile/FrameProfiler.h>
+#include <landan/timer/Timer.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class FrameProfilerTest : public ::testing::Test
+{
+
+protected:
+	virtual ~FrameProfilerTest(){
+
+	}
+	virtual void SetUp()
+	{
+		Timer::Init();
+	}
+	virtual void TearDown() {
+
+	}
+
+};
+
+TEST_F(FrameProfilerTest, TestCapacityRoundsToPowerOfTwo)
+{
+	FrameProfiler profiler(100);
+
+	ASSERT_EQ(128u, profiler.GetCapacity());
+}
+
+TEST_F(FrameProfilerTest, TestStats)
+{
+	FrameProfiler profiler(128);
+
+	//Update times of 1..100 ms
+	for (u32 i = 1; i <= 100; i++)
+	{
+		profiler.AddTicks(profile::UPDATE, i * Timer::TICKS_PER_MILLISECOND);
+		profiler.AddTicks(profile::IDLE, Timer::TICKS_PER_MILLISECOND);
+		profiler.EndFrame();
+	}
+
+	FrameStats stats;
+	profiler.GetStats(profile::UPDATE, stats);
+
+	ASSERT_EQ(100u, profiler.GetFrameCount());
+	ASSERT_EQ(100u, stats.sampleCount);
+	ASSERT_DOUBLE_EQ(1.0, stats.minMilliSeconds);
+	ASSERT_DOUBLE_EQ(100.0, stats.maxMilliSeconds);
+	ASSERT_DOUBLE_EQ(50.5, stats.averageMilliSeconds);
+	ASSERT_DOUBLE_EQ(50.0, stats.p50MilliSeconds);
+	ASSERT_DOUBLE_EQ(99.0, stats.p99MilliSeconds);
+
+	profiler.GetStats(profile::RENDER, stats);
+	ASSERT_DOUBLE_EQ(0.0, stats.maxMilliSeconds);
+
+	profiler.GetStats(profile::IDLE, stats);
+	ASSERT_DOUBLE_EQ(1.0, stats.averageMilliSeconds);
+}
+
+TEST_F(FrameProfilerTest, TestRollingWindow)
+{
+	FrameProfiler profiler(4);
+
+	for (u32 i = 1; i <= 10; i++)
+	{
+		profiler.AddTicks(profile::UPDATE, i * Timer::TICKS_PER_MILLISECOND);
+		profiler.EndFrame();
+	}
+
+	//Only the last four frames are kept
+	FrameStats stats;
+	profiler.GetStats(profile::UPDATE, stats);
+
+	ASSERT_EQ(4u, stats.sampleCount);
+	ASSERT_DOUBLE_EQ(7.0, stats.minMilliSeconds);
+	ASSERT_DOUBLE_EQ(10.0, stats.maxMilliSeconds);
+}
+
+TEST_F(FrameProfilerTest, TestHistogram)
+{
+	FrameProfiler profiler(16);
+
+	profiler.AddTicks(profile::UPDATE, 1 * Timer::TICKS_PER_MILLISECOND);
+	profiler.EndFrame();
+	profiler.AddTicks(profile::UPDATE, 6 * Timer::TICKS_PER_MILLISECOND);
+	profiler.EndFrame();
+	profiler.AddTicks(profile::UPDATE, 7 * Timer::TICKS_PER_MILLISECOND);
+	profiler.EndFrame();
+	profiler.AddTicks(profile::UPDATE, 500 * Timer::TICKS_PER_MILLISECOND);
+	profiler.EndFrame();
+
+	u32 buckets[4];
+	profiler.GetHistogram(profile::UPDATE, 5.0, buckets, 4);
+
+	ASSERT_EQ(1u, buckets[0]);
+	ASSERT_EQ(2u, buckets[1]);
+	ASSERT_EQ(0u, buckets[2]);
+	ASSERT_EQ(1u, buckets[3]);
+
+	profiler.GetHistogram(profile::UPDATE, 0.0, buckets, 4);
+	ASSERT_EQ(0u, buckets[0]);
+	ASSERT_EQ(0u, buckets[1]);
+	ASSERT_EQ(0u, buckets[3]);
+
+	profiler.GetHistogram(profile::UPDATE, -5.0, buckets, 4);
+	ASSERT_EQ(0u, buckets[3]);
+}
+
+
+} /* namespace landan */
+#endif /* _FRAMEPROFILERTEST_H_ */
@@ -0,0 +1,311 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: JobSystemTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _JOBSYSTEMTEST_H_
+#define _JOBSYSTEMTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/job/JobSystem.h>
+#include <landan/job/WorkStealingDeque.h>
+#include <landan/thread/Atomic.h>
+#include <landan/thread/Thread.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class JobSystemTest : public ::testing::Test
+{
+
+protected:
+	virtual void SetUp()
+	{
+		JOB_COUNT = 0;
+		for (u32 i = 0; i < ITEM_COUNT; i++)
+		{
+			VISITS[i] = 0;
+		}
+		p_system = new JobSystem();
+		SYSTEM = p_system;
+	}
+	virtual void TearDown()
+	{
+		delete p_system;
+		p_system = 0;
+		SYSTEM = 0;
+	}
+
+	static void CountJob(Job &)
+	{
+		AtomicFetchAdd(&JOB_COUNT, 1);
+	}
+
+	//Spreads itself over CHILD_COUNT children from inside the job
+	static void SpawnJob(Job &job)
+	{
+		for (u32 i = 0; i < CHILD_COUNT; i++)
+		{
+			SYSTEM->Run(SYSTEM->Create(FREE_FUNCTION(&JobSystemTest::CountJob), 0, &job));
+		}
+	}
+
+	static void VisitRange(u32 begin, u32 end)
+	{
+		for (u32 i = begin; i < end; i++)
+		{
+			AtomicFetchAdd(&VISITS[i], 1);
+		}
+	}
+
+	static void CountRange(u32 begin, u32 end)
+	{
+		AtomicFetchAdd(&JOB_COUNT, end - begin);
+	}
+
+	//Every outer batch runs a whole ParallelFor of its own from inside a job
+	static void NestedRange(u32 begin, u32 end)
+	{
+		for (u32 i = begin; i < end; i++)
+		{
+			SYSTEM->ParallelFor(CHILD_COUNT, 1, FREE_FUNCTION(&JobSystemTest::CountRange));
+		}
+	}
+
+	//More children than one thread's job ring holds, all alive at once under the root
+	void FanOut()
+	{
+		JOB_COUNT = 0;
+		u32 childCount = JobSystem::MAX_JOBS_PER_THREAD + 1000;
+		Job *root = SYSTEM->Create(Function<void (Job&)>());
+		for (u32 i = 0; i < childCount; i++)
+		{
+			SYSTEM->Run(SYSTEM->Create(FREE_FUNCTION(&JobSystemTest::CountJob), 0, root));
+		}
+		SYSTEM->Run(root);
+		SYSTEM->Wait(root);
+		ASSERT_EQ(childCount, AtomicLoadAcquire(&JOB_COUNT));
+	}
+
+	//Stands in for a thread that isn't part of the pool
+	static void OutsideThread()
+	{
+		Job *root = SYSTEM->Create(Function<void (Job&)>());
+		for (u32 i = 0; i < CHILD_COUNT; i++)
+		{
+			SYSTEM->Run(SYSTEM->Create(FREE_FUNCTION(&JobSystemTest::CountJob), 0, root));
+		}
+		SYSTEM->Run(root);
+		SYSTEM->Wait(root);
+		SYSTEM->ParallelFor(ITEM_COUNT, 0, FREE_FUNCTION(&JobSystemTest::VisitRange));
+	}
+
+	void CheckVisits()
+	{
+		for (u32 i = 0; i < ITEM_COUNT; i++)
+		{
+			ASSERT_EQ(1u, VISITS[i]) << "Index " << i;
+		}
+	}
+
+	JobSystem *p_system;
+
+	static JobSystem *SYSTEM;
+	static volatile u32 JOB_COUNT;
+	static const u32 ITEM_COUNT = 10000;
+	static volatile u32 VISITS[ITEM_COUNT];
+	static const u32 CHILD_COUNT = 64;
+
+};
+
+JobSystem *JobSystemTest::SYSTEM = 0;
+volatile u32 JobSystemTest::JOB_COUNT = 0;
+const u32 JobSystemTest::ITEM_COUNT;
+volatile u32 JobSystemTest::VISITS[JobSystemTest::ITEM_COUNT];
+const u32 JobSystemTest::CHILD_COUNT;
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(JobSystemTest, TestDeque)
+{
+	Job jobs[4];
+	WorkStealingDeque deque(4);
+	ASSERT_EQ(4u, deque.GetCapacity());
+	ASSERT_TRUE(deque.IsEmpty());
+	ASSERT_TRUE(deque.Pop() == 0);
+	ASSERT_TRUE(deque.Steal() == 0);
+
+	for (u32 i = 0; i < 4; i++)
+	{
+		ASSERT_TRUE(deque.Push(&jobs[i]));
+	}
+	ASSERT_FALSE(deque.Push(&jobs[0]));
+
+	//The owner works newest first, thieves take the oldest
+	ASSERT_EQ(&jobs[3], deque.Pop());
+	ASSERT_EQ(&jobs[0], deque.Steal());
+	ASSERT_EQ(&jobs[2], deque.Pop());
+	ASSERT_EQ(&jobs[1], deque.Steal());
+	ASSERT_TRUE(deque.IsEmpty());
+	ASSERT_TRUE(deque.Pop() == 0);
+
+	//Wraps around the ring
+	for (u32 i = 0; i < 10; i++)
+	{
+		ASSERT_TRUE(deque.Push(&jobs[i % 4]));
+		ASSERT_EQ(&jobs[i % 4], deque.Pop());
+	}
+}
+
+TEST_F(JobSystemTest, TestParallelFor)
+{
+	ASSERT_TRUE(p_system->Start(3));
+	ASSERT_TRUE(p_system->IsRunning());
+	ASSERT_EQ(3u, p_system->GetWorkerCount());
+	ASSERT_FALSE(p_system->Start(3));
+
+	p_system->ParallelFor(ITEM_COUNT, 0, FREE_FUNCTION(&JobSystemTest::VisitRange));
+	CheckVisits();
+
+	//Uneven batches, the last one is short
+	for (u32 i = 0; i < ITEM_COUNT; i++)
+	{
+		VISITS[i] = 0;
+	}
+	p_system->ParallelFor(ITEM_COUNT, 7, FREE_FUNCTION(&JobSystemTest::VisitRange));
+	CheckVisits();
+
+	//More batches than a thread's job ring holds
+	for (u32 i = 0; i < ITEM_COUNT; i++)
+	{
+		VISITS[i] = 0;
+	}
+	p_system->ParallelFor(ITEM_COUNT, 1, FREE_FUNCTION(&JobSystemTest::VisitRange));
+	CheckVisits();
+
+	p_system->Stop();
+	ASSERT_FALSE(p_system->IsRunning());
+	ASSERT_EQ(0u, p_system->GetWorkerCount());
+}
+
+TEST_F(JobSystemTest, TestDependencies)
+{
+	ASSERT_TRUE(p_system->Start(3));
+
+	//A parent isn't finished until every child is, even ones added while it runs
+	for (u32 frame = 0; frame < 50; frame++)
+	{
+		JOB_COUNT = 0;
+		Job *parent = p_system->Create(FREE_FUNCTION(&JobSystemTest::SpawnJob));
+		Job *sibling = p_system->Create(FREE_FUNCTION(&JobSystemTest::CountJob), 0, parent);
+		ASSERT_FALSE(p_system->IsFinished(parent));
+		p_system->Run(sibling);
+		p_system->Run(parent);
+		p_system->Wait(parent);
+		ASSERT_TRUE(p_system->IsFinished(parent));
+		ASSERT_TRUE(p_system->IsFinished(sibling));
+		ASSERT_EQ(CHILD_COUNT + 1, AtomicLoadAcquire(&JOB_COUNT));
+	}
+}
+
+TEST_F(JobSystemTest, TestNoWorkers)
+{
+	//Everything runs on the calling thread while it waits
+	ASSERT_TRUE(p_system->Start(0));
+	ASSERT_EQ(0u, p_system->GetWorkerCount());
+
+	Job *job = p_system->Create(FREE_FUNCTION(&JobSystemTest::SpawnJob));
+	p_system->Run(job);
+	p_system->Wait(job);
+	ASSERT_EQ(CHILD_COUNT, JOB_COUNT);
+
+	p_system->ParallelFor(ITEM_COUNT, 100, FREE_FUNCTION(&JobSystemTest::VisitRange));
+	CheckVisits();
+}
+
+TEST_F(JobSystemTest, TestNestedParallelFor)
+{
+	ASSERT_TRUE(p_system->Start(3));
+
+	//Inner jobs used to land on slots of outer batches that were still running
+	for (u32 frame = 0; frame < 50; frame++)
+	{
+		JOB_COUNT = 0;
+		p_system->ParallelFor(CHILD_COUNT, 1, FREE_FUNCTION(&JobSystemTest::NestedRange));
+		ASSERT_EQ(CHILD_COUNT * CHILD_COUNT, AtomicLoadAcquire(&JOB_COUNT));
+	}
+}
+
+TEST_F(JobSystemTest, TestFanOutPastRing)
+{
+	//With no workers nothing runs until the ring is full, then Create has to help out
+	ASSERT_TRUE(p_system->Start(0));
+	FanOut();
+	p_system->Stop();
+
+	ASSERT_TRUE(p_system->Start(3));
+	FanOut();
+}
+
+TEST_F(JobSystemTest, TestOutsideThread)
+{
+	ASSERT_TRUE(p_system->Start(2));
+
+	Thread thread(FREE_FUNCTION(&JobSystemTest::OutsideThread));
+	ASSERT_TRUE(thread.Start());
+	thread.Join();
+
+	ASSERT_EQ(CHILD_COUNT, AtomicLoadAcquire(&JOB_COUNT));
+	CheckVisits();
+}
+
+
+} /* namespace landan */
+#endif /* _JOBSYSTEMTEST_H_ */
@@ -0,0 +1,159 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: LogRecordTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _LOGRECORDTEST_H_
+#define _LOGRECORDTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/util/LogRecord.h>
+#include <landan/util/DebugUtil.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class LogRecordTest : public ::testing::Test
+{
+
+protected:
+	virtual ~LogRecordTest(){
+
+	}
+	virtual void SetUp()
+	{
+
+	}
+	virtual void TearDown() {
+
+	}
+
+	string RenderSite(LogSite *site, const LogArgument *arguments, u32 count)
+	{
+		char record[512];
+		char text[512];
+		u32 length = LogRecord::Encode(site, arguments, count, record, 512);
+		EXPECT_TRUE(LogRecord::IsEncoded(record, length));
+		return string(text, LogRecord::Render(record, length, text, 512));
+	}
+
+};
+
+TEST_F(LogRecordTest, TestRenderMatchesStreamFormat)
+{
+	static LogSite site = { LANDAN_LOG_LEVEL_INFO, "INFO", "some/path\\to/File.cpp", "Function", 42, "frame {} took {}ms on {} ({})", 0 };
+	string threadName = "main";
+	LogArgument arguments[] = { MakeLogArgument(-7), MakeLogArgument(16.5f), MakeLogArgument(threadName), MakeLogArgument(7ULL) };
+
+	ASSERT_EQ(string("INFO [File.cpp :: Function : 42] - frame -7 took 16.5ms on main (7)\n"), RenderSite(&site, arguments, 4));
+}
+
+TEST_F(LogRecordTest, TestMissingArgumentsLeavePlaceholders)
+{
+	static LogSite site = { LANDAN_LOG_LEVEL_DEBUG, "DEBUG", "File.cpp", "Function", 1, "{} and {}", 0 };
+	LogArgument arguments[] = { MakeLogArgument("one") };
+
+	ASSERT_EQ(string("DEBUG [File.cpp :: Function : 1] - one and {}\n"), RenderSite(&site, arguments, 1));
+}
+
+TEST_F(LogRecordTest, TestSiteRegistration)
+{
+	static LogSite site = { LANDAN_LOG_LEVEL_INFO, "INFO", "File.cpp", "Function", 1, "", 0 };
+
+	u32 id = LogRecord::RegisterSite(&site);
+	ASSERT_NE(0u, id);
+	ASSERT_EQ(id, LogRecord::RegisterSite(&site));
+	ASSERT_EQ(&site, LogRecord::GetSite(id));
+	ASSERT_TRUE(LogRecord::GetSite(0) == 0);
+}
+
+TEST_F(LogRecordTest, TestUnregisteredSite)
+{
+	//What a site is left with once the table is full, it mustn't render as a text record
+	static LogSite site = { LANDAN_LOG_LEVEL_INFO, "INFO", "File.cpp", "Function", 1, "{}", LogRecord::UNREGISTERED_SITE };
+	LogArgument arguments[] = { MakeLogArgument(1) };
+
+	ASSERT_EQ(string("UNKNOWN [unregistered site] - \n"), RenderSite(&site, arguments, 1));
+}
+
+TEST_F(LogRecordTest, TestTemporaryStringArguments)
+{
+	//The same shape as the LANDAN_LOGF macros, the temporary lives until Encode has copied it
+	static LogSite site = { LANDAN_LOG_LEVEL_INFO, "INFO", "File.cpp", "Function", 1, "{} {}", 0 };
+	char record[512];
+	char text[512];
+	u32 length = LogRecord::Encode(&site, LogArgumentList(MakeLogArgument(string(64, 'a')), MakeLogArgument(string("b"))).values, 2, record, 512);
+
+	ASSERT_EQ(string("INFO [File.cpp :: Function : 1] - ") + string(64, 'a') + " b\n", string(text, LogRecord::Render(record, length, text, 512)));
+}
+
+TEST_F(LogRecordTest, TestRenderRejectsText)
+{
+	char text[16];
+	ASSERT_EQ(0u, LogRecord::Render("plain text line\n", 16, text, 16));
+}
+
+TEST_F(LogRecordTest, TestLongStringsAreClipped)
+{
+	static LogSite site = { LANDAN_LOG_LEVEL_INFO, "INFO", "File.cpp", "Function", 1, "{}", 0 };
+	string longText(LogRecord::MAX_STRING_LENGTH * 2, 'x');
+	LogArgument arguments[] = { MakeLogArgument(longText) };
+
+	string expected = "INFO [File.cpp :: Function : 1] - " + longText.substr(0, LogRecord::MAX_STRING_LENGTH) + "\n";
+	ASSERT_EQ(expected, RenderSite(&site, arguments, 1));
+}
+
+TEST_F(LogRecordTest, TestFileBaseName)
+{
+	ASSERT_EQ(string("File.cpp"), string(DebugUtil::FileBaseName("a/b\\c/File.cpp")));
+	ASSERT_EQ(string("File.cpp"), string(DebugUtil::FileBaseName("File.cpp")));
+}
+
+
+} /* namespace landan */
+#endif /* _LOGRECORDTEST_H_ */
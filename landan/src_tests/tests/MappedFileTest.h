@@ -0,0 +1,166 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: MappedFileTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _MAPPEDFILETEST_H_
+#define _MAPPEDFILETEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <landan/core/LandanTypes.h>
+#include <landan/file/File.h>
+#include <landan/file/MappedFile.h>
+#include <landan/util/ByteArray.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class MappedFileTest : public ::testing::Test
+{
+
+protected:
+	virtual void SetUp()
+	{
+		//A few pages of a known pattern, byte i is i * 7
+		m_contents.resize(3 * MappedFile::GetPageSize() + 123);
+		for (u32 i = 0; i < m_contents.size(); i++)
+		{
+			m_contents[i] = static_cast<u8>(i * 7);
+		}
+		File file(PATH);
+		file.Open(file::WRITE);
+		file.Write(&m_contents[0], static_cast<u32>(m_contents.size()));
+		file.Close();
+	}
+	virtual void TearDown()
+	{
+		File(PATH).Remove();
+		File(EMPTY_PATH).Remove();
+	}
+
+	std::vector<u8> m_contents;
+
+	static const string PATH;
+	static const string EMPTY_PATH;
+
+};
+
+const string MappedFileTest::PATH = "MappedFileTest.bin";
+const string MappedFileTest::EMPTY_PATH = "MappedFileTest.empty";
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(MappedFileTest, TestWholeFile)
+{
+	MappedFile mapping;
+	ASSERT_TRUE(File(PATH).Map(mapping));
+	ASSERT_TRUE(mapping.IsOpen());
+	ASSERT_TRUE(mapping.IsMapped());
+	ASSERT_EQ(m_contents.size(), mapping.GetSize());
+	ASSERT_EQ(0, memcmp(&m_contents[0], mapping.GetData(), m_contents.size()));
+
+#ifndef _WIN32
+	ASSERT_TRUE(mapping.Advise(file::SEQUENTIAL));
+	ASSERT_TRUE(mapping.Advise(file::WILL_NEED, 100, 5000));
+#endif
+	ASSERT_FALSE(mapping.Advise(file::WILL_NEED, mapping.GetSize(), 1));
+
+	//Views read straight out of the mapping
+	ByteArray view = mapping.GetView(8, 4);
+	ASSERT_EQ(4u, view.GetLength());
+	ASSERT_EQ(mapping.GetData() + 8, view.GetRawBytes());
+	ASSERT_EQ(m_contents[11], view.GetRawBytes()[3]);
+
+	ByteArray tail = mapping.GetView(m_contents.size() - 10);
+	ASSERT_EQ(10u, tail.GetLength());
+	ASSERT_EQ(0u, mapping.GetView(m_contents.size()).GetLength());
+
+	mapping.Close();
+	ASSERT_FALSE(mapping.IsOpen());
+	ASSERT_EQ(0, mapping.GetData());
+}
+
+TEST_F(MappedFileTest, TestRange)
+{
+	//An offset that's not on a page boundary
+	u32 offset = MappedFile::GetPageSize() + 17;
+	MappedFile mapping;
+	ASSERT_TRUE(mapping.Open(PATH, offset, 1000));
+	ASSERT_EQ(1000u, mapping.GetSize());
+	ASSERT_EQ(m_contents[offset], mapping.GetData()[0]);
+	ASSERT_EQ(m_contents[offset + 999], mapping.GetData()[999]);
+
+	//Clamped to the end of the file
+	ASSERT_TRUE(mapping.Open(PATH, m_contents.size() - 5, 1000));
+	ASSERT_EQ(5u, mapping.GetSize());
+
+	ASSERT_FALSE(mapping.Open(PATH, m_contents.size() + 1));
+	ASSERT_FALSE(mapping.Open("MappedFileTest.missing"));
+	ASSERT_FALSE(mapping.IsOpen());
+}
+
+TEST_F(MappedFileTest, TestEmpty)
+{
+	File empty(EMPTY_PATH);
+	empty.Open(file::WRITE);
+	empty.Close();
+
+	MappedFile mapping;
+	ASSERT_TRUE(mapping.Open(EMPTY_PATH));
+	ASSERT_TRUE(mapping.IsOpen());
+	ASSERT_FALSE(mapping.IsMapped());
+	ASSERT_EQ(0u, mapping.GetSize());
+	ASSERT_EQ(0u, mapping.GetView().GetLength());
+}
+
+
+} /* namespace landan */
+#endif /* _MAPPEDFILETEST_H_ */
@@ -0,0 +1,240 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: PackFileTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _PACKFILETEST_H_
+#define _PACKFILETEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <sstream>
+#include <landan/core/LandanTypes.h>
+#include <landan/file/File.h>
+#include <landan/file/PackFile.h>
+#include <landan/util/ByteArray.h>
+
+#ifdef _WIN32
+	#include <direct.h>
+#else
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class PackFileTest : public ::testing::Test
+{
+
+protected:
+	virtual void TearDown()
+	{
+		File(PATH).Remove();
+		File("PackFileTest.asset").Remove();
+		File("PackFileTestDir/a.txt").Remove();
+		File("PackFileTestDir/sub/b.txt").Remove();
+#ifndef _WIN32
+		unlink("PackFileTestDir/sub/loop");
+#endif
+		DeleteDirectory("PackFileTestDir/sub");
+		DeleteDirectory("PackFileTestDir");
+	}
+
+	static void MakeDirectory(const char *path)
+	{
+#ifdef _WIN32
+		_mkdir(path);
+#else
+		mkdir(path, 0755);
+#endif
+	}
+
+	static void DeleteDirectory(const char *path)
+	{
+#ifdef _WIN32
+		_rmdir(path);
+#else
+		rmdir(path);
+#endif
+	}
+
+	static void WriteText(const string &path, const string &contents)
+	{
+		File file(path);
+		file.Open(file::WRITE);
+		file.Write(reinterpret_cast<const u8*>(contents.data()), static_cast<u32>(contents.length()));
+		file.Close();
+	}
+
+	static string AsString(ByteArray &bytes)
+	{
+		return string(reinterpret_cast<const char*>(bytes.GetRawBytes()), bytes.GetLength());
+	}
+
+	static const string PATH;
+
+};
+
+const string PackFileTest::PATH = "PackFileTest.pack";
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(PackFileTest, TestRoundTrip)
+{
+	WriteText("PackFileTest.asset", "from disk");
+
+	PackWriter writer;
+	const u32 count = 500;
+	for (u32 i = 0; i < count; i++)
+	{
+		std::ostringstream path;
+		std::ostringstream contents;
+		path << "textures/" << i << ".tex";
+		contents << "texture " << i;
+		ByteArray bytes(static_cast<u32>(contents.str().length()));
+		memcpy(bytes.GetRawBytes(), contents.str().data(), bytes.GetLength());
+		ASSERT_TRUE(writer.Add(path.str(), bytes));
+	}
+	ASSERT_TRUE(writer.AddFile("./config\\disk.txt", "PackFileTest.asset"));
+	ASSERT_TRUE(writer.Add("empty", 0, 0));
+	ASSERT_FALSE(writer.Add("textures/7.tex", 0, 0));
+	ASSERT_FALSE(writer.Add("./", 0, 0));
+	ASSERT_FALSE(writer.AddFile("missing", "PackFileTest.missing"));
+	ASSERT_EQ(count + 2, writer.GetEntryCount());
+	ASSERT_TRUE(writer.Write(PATH));
+
+	PackFile pack;
+	ASSERT_TRUE(pack.Open(PATH));
+	ASSERT_EQ(count + 2, pack.GetEntryCount());
+	for (u32 i = 0; i < count; i++)
+	{
+		std::ostringstream path;
+		std::ostringstream contents;
+		path << "textures/" << i << ".tex";
+		contents << "texture " << i;
+		PackEntry entry;
+		ASSERT_TRUE(pack.Find(path.str(), entry));
+		ASSERT_EQ(0u, entry.offset % pack::BLOB_ALIGNMENT);
+		ASSERT_EQ(pack::COMPRESSION_NONE, entry.compression);
+		ByteArray view = pack.Get(path.str());
+		ASSERT_EQ(contents.str(), AsString(view));
+	}
+
+	//Lookups are normalized the same way as the paths that were added
+	ByteArray disk = pack.Get("config/disk.txt");
+	ASSERT_EQ("from disk", AsString(disk));
+	ASSERT_TRUE(pack.Contains("/config\\disk.txt"));
+	ASSERT_TRUE(pack.Contains("empty"));
+	ASSERT_EQ(0u, pack.Get("empty").GetLength());
+	ASSERT_FALSE(pack.Contains("textures/500.tex"));
+	ASSERT_FALSE(pack.Contains("config/disk.tx"));
+	ASSERT_EQ(0u, pack.Get("missing").GetLength());
+	ASSERT_EQ(0u, pack.GetMapping().GetSize() % pack::BLOB_ALIGNMENT);
+
+	pack.Close();
+	ASSERT_FALSE(pack.IsOpen());
+	ASSERT_FALSE(pack.Contains("empty"));
+}
+
+TEST_F(PackFileTest, TestDirectory)
+{
+	MakeDirectory("PackFileTestDir");
+	MakeDirectory("PackFileTestDir/sub");
+	WriteText("PackFileTestDir/a.txt", "alpha");
+	WriteText("PackFileTestDir/sub/b.txt", "beta");
+#ifndef _WIN32
+	//Links are skipped, following this one would never end
+	ASSERT_EQ(0, symlink("..", "PackFileTestDir/sub/loop"));
+#endif
+
+	PackWriter writer;
+	ASSERT_EQ(2u, writer.AddDirectory("PackFileTestDir"));
+	ASSERT_TRUE(writer.Write(PATH));
+
+	PackFile pack;
+	ASSERT_TRUE(pack.Open(PATH));
+	ByteArray a = pack.Get("a.txt");
+	ByteArray b = pack.Get("sub/b.txt");
+	ASSERT_EQ("alpha", AsString(a));
+	ASSERT_EQ("beta", AsString(b));
+}
+
+TEST_F(PackFileTest, TestInvalid)
+{
+	PackFile pack;
+	ASSERT_FALSE(pack.Open("PackFileTest.missing"));
+
+	WriteText(PATH, "definitely not a pack file, just some text");
+	ASSERT_FALSE(pack.Open(PATH));
+	ASSERT_FALSE(pack.IsOpen());
+
+	//An empty pack is still a pack
+	PackWriter writer;
+	ASSERT_TRUE(writer.Write(PATH));
+	ASSERT_TRUE(pack.Open(PATH));
+	ASSERT_EQ(0u, pack.GetEntryCount());
+	ASSERT_FALSE(pack.Contains("anything"));
+
+	//A strings offset near the top of the u64 range wraps when the size is added to it
+	ByteArray bytes = File(PATH).ReadAll();
+	string corrupt = AsString(bytes);
+	pack.Close();
+	for (u32 i = 0; i < 8; i++)
+	{
+		corrupt[16 + i] = (i == 0) ? '\xF0' : '\xFF';
+	}
+	corrupt[24] = 0x20;
+	WriteText(PATH, corrupt);
+	ASSERT_FALSE(pack.Open(PATH));
+}
+
+
+} /* namespace landan */
+#endif /* _PACKFILETEST_H_ */
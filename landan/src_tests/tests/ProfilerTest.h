@@ -0,0 +1,164 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: ProfilerTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _PROFILERTEST_H_
+#define _PROFILERTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/profile/Profiler.h>
+#include <landan/thread/Thread.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class ProfilerTest : public ::testing::Test
+{
+
+protected:
+	virtual ~ProfilerTest(){
+
+	}
+	virtual void SetUp()
+	{
+		Timer::Init();
+		Profiler::SetEnabled(true);
+		Profiler::Reset();
+	}
+	virtual void TearDown() {
+		Profiler::SetEnabled(true);
+		Profiler::Reset();
+		std::remove(TRACE_PATH);
+	}
+
+	string ReadTrace()
+	{
+		std::ifstream fileStream(TRACE_PATH);
+		return string((std::istreambuf_iterator<char>(fileStream)), std::istreambuf_iterator<char>());
+	}
+
+	static const char *TRACE_PATH;
+
+};
+
+const char *ProfilerTest::TRACE_PATH = "ProfilerTest_trace.json";
+
+void ProfilerTestInner()
+{
+	LANDAN_PROFILE_SCOPE("Inner \"quoted\"");
+}
+
+void ProfilerTestThread()
+{
+	LANDAN_PROFILE_SCOPE("Thread");
+}
+
+TEST_F(ProfilerTest, TestNestedScopes)
+{
+	{
+		LANDAN_PROFILE_SCOPE("Outer");
+		ProfilerTestInner();
+	}
+
+	ASSERT_TRUE(Profiler::WriteChromeTrace(TRACE_PATH));
+	string trace = ReadTrace();
+
+	ASSERT_EQ(0u, trace.find("{\"traceEvents\":["));
+	ASSERT_NE(string::npos, trace.find("\"name\":\"Outer\""));
+	ASSERT_NE(string::npos, trace.find("\"name\":\"Inner \\\"quoted\\\"\""));
+	ASSERT_NE(string::npos, trace.find("\"depth\":1"));
+}
+
+TEST_F(ProfilerTest, TestOpenScopesAreSkipped)
+{
+	u32 handle = Profiler::BeginScope("StillOpen");
+
+	ASSERT_TRUE(Profiler::WriteChromeTrace(TRACE_PATH));
+	ASSERT_EQ(string::npos, ReadTrace().find("StillOpen"));
+
+	Profiler::EndScope(handle);
+}
+
+TEST_F(ProfilerTest, TestDisabled)
+{
+	Profiler::SetEnabled(false);
+	{
+		LANDAN_PROFILE_SCOPE("Disabled");
+	}
+
+	ASSERT_TRUE(Profiler::WriteChromeTrace(TRACE_PATH));
+	ASSERT_EQ(string::npos, ReadTrace().find("Disabled"));
+}
+
+TEST_F(ProfilerTest, TestThreadBuffersAreRecycled)
+{
+	//Warm up so one buffer is already waiting for reuse
+	Thread warmUp(FREE_FUNCTION(&ProfilerTestThread));
+	ASSERT_TRUE(warmUp.Start());
+	warmUp.Join();
+
+	u32 bufferCount = Profiler::GetThreadBufferCount();
+	for (u32 i = 0; i < 8; i++)
+	{
+		Thread thread(FREE_FUNCTION(&ProfilerTestThread));
+		ASSERT_TRUE(thread.Start());
+		thread.Join();
+	}
+	ASSERT_EQ(bufferCount, Profiler::GetThreadBufferCount());
+
+	//Events from threads that have exited are still dumped
+	ASSERT_TRUE(Profiler::WriteChromeTrace(TRACE_PATH));
+	ASSERT_NE(string::npos, ReadTrace().find("\"name\":\"Thread\""));
+}
+
+} /* namespace landan */
+#endif /* _PROFILERTEST_H_ */
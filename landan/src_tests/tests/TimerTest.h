@@ -0,0 +1,111 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: TimerTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _TIMERTEST_H_
+#define _TIMERTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <landan/core/LandanTypes.h>
+#include <landan/timer/Timer.h>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class TimerTest : public ::testing::Test
+{
+
+protected:
+	virtual ~TimerTest(){
+
+	}
+	virtual void SetUp()
+	{
+		Timer::Init();
+	}
+	virtual void TearDown() {
+
+	}
+
+};
+
+TEST_F(TimerTest, TestTicksMonotonic)
+{
+	u64 first = Timer::GetTicks();
+	u64 second = Timer::GetTicks();
+
+	ASSERT_GT(first, 0ULL);
+	ASSERT_GE(second, first);
+}
+
+TEST_F(TimerTest, TestTicksAdvance)
+{
+	u64 start = Timer::GetTicks();
+	f64 startMS = Timer::GetMilliSeconds();
+
+	//Spin for at least two milliseconds of wall time
+	while (Timer::GetMilliSeconds() - startMS < 2.0)
+	{
+	}
+
+	u64 elapsed = Timer::GetTicks() - start;
+
+	ASSERT_GE(elapsed, 2ULL * Timer::TICKS_PER_MILLISECOND);
+	ASSERT_GE(Timer::TicksToMilliSeconds(elapsed), 2.0);
+}
+
+TEST_F(TimerTest, TestTickConversions)
+{
+	ASSERT_DOUBLE_EQ(1.5, Timer::TicksToSeconds(1500000000ULL));
+	ASSERT_DOUBLE_EQ(1.5, Timer::TicksToMilliSeconds(1500000ULL));
+	ASSERT_DOUBLE_EQ(1.5, Timer::TicksToMicroSeconds(1500ULL));
+}
+
+
+} /* namespace landan */
+#endif /* _TIMERTEST_H_ */
@@ -0,0 +1,186 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+/*********************************
+ *Class: VarIntTest.h
+ *Description: 
+ *Author: jkeon
+ **********************************/
+
+#ifndef _VARINTTEST_H_
+#define _VARINTTEST_H_
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <landan/core/LandanTypes.h>
+#include <landan/util/ByteArray.h>
+#include <landan/util/VarInt.h>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+namespace landan
+{
+
+//////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+class VarIntTest : public ::testing::Test
+{
+
+public:
+	//Values around every 7 bit boundary plus both ends
+	static std::vector<u64> Boundaries()
+	{
+		std::vector<u64> values;
+		values.push_back(0);
+		values.push_back(~0ull);
+		for (u32 bits = 7; bits < 64; bits += 7)
+		{
+			u64 edge = 1ull << bits;
+			values.push_back(edge - 1);
+			values.push_back(edge);
+			values.push_back(edge + 1);
+		}
+		return values;
+	}
+};
+
+//////////////////////////////////////////////////////////////////////
+// TESTS /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+TEST_F(VarIntTest, TestRoundTrip)
+{
+	std::vector<u64> values = Boundaries();
+	for (u32 i = 0; i < values.size(); i++)
+	{
+		u64 value = values[i];
+		u8 encoded[VarInt::MAX_SIZE + 8];
+		u32 size = VarInt::Encode(value, encoded);
+		ASSERT_EQ(VarInt::GetSize(value), size);
+		u32 maxSize = VarInt::MAX_SIZE;
+		ASSERT_LE(size, maxSize);
+
+		//Exactly enough bytes takes the byte loop, trailing bytes let the 8 byte path run
+		u64 decoded = 0;
+		ASSERT_EQ(size, VarInt::Decode(encoded, size, decoded));
+		ASSERT_EQ(value, decoded);
+
+		memset(encoded + size, 0xFF, 8);
+		decoded = 0;
+		ASSERT_EQ(size, VarInt::Decode(encoded, size + 8, decoded));
+		ASSERT_EQ(value, decoded);
+
+		//One byte short never decodes
+		ASSERT_EQ(0u, VarInt::Decode(encoded, size - 1, decoded));
+	}
+}
+
+TEST_F(VarIntTest, TestSizes)
+{
+	ASSERT_EQ(1u, VarInt::GetSize(127));
+	ASSERT_EQ(2u, VarInt::GetSize(128));
+	ASSERT_EQ(5u, VarInt::GetSize(0xFFFFFFFF));
+	ASSERT_EQ(10u, VarInt::GetSize(~0ull));
+
+	u8 encoded[2];
+	VarInt::Encode(300, encoded);
+	ASSERT_EQ(0xAC, encoded[0]);
+	ASSERT_EQ(0x02, encoded[1]);
+}
+
+TEST_F(VarIntTest, TestOverlong)
+{
+	u8 bytes[16];
+	memset(bytes, 0x80, sizeof(bytes));
+	u64 value;
+	ASSERT_EQ(0u, VarInt::Decode(bytes, 16, value));
+
+	//A tenth byte with more than the top bit doesn't fit in 64 bits
+	memset(bytes, 0xFF, 9);
+	bytes[9] = 0x02;
+	ASSERT_EQ(0u, VarInt::Decode(bytes, 16, value));
+	bytes[9] = 0x01;
+	ASSERT_EQ(10u, VarInt::Decode(bytes, 16, value));
+	ASSERT_EQ(~0ull, value);
+}
+
+TEST_F(VarIntTest, TestZigZag)
+{
+	ASSERT_EQ(0u, VarInt::ZigZag32(0));
+	ASSERT_EQ(1u, VarInt::ZigZag32(-1));
+	ASSERT_EQ(2u, VarInt::ZigZag32(1));
+	ASSERT_EQ(0xFFFFFFFFu, VarInt::ZigZag32(-2147483647 - 1));
+	ASSERT_EQ(-2147483647 - 1, VarInt::UnZigZag32(0xFFFFFFFFu));
+	ASSERT_EQ(3ull, VarInt::ZigZag64(-2));
+	i64 minimum = -9223372036854775807ll - 1;
+	ASSERT_EQ(minimum, VarInt::UnZigZag64(VarInt::ZigZag64(minimum)));
+}
+
+TEST_F(VarIntTest, TestByteArray)
+{
+	ByteArray bytes(0, bytearray::GROWABLE);
+	bytes.WriteVarUInt32(5);
+	bytes.WriteVarUInt32(0xFFFFFFFF);
+	bytes.WriteVarUInt64(1ull << 60);
+	bytes.WriteVarInt32(-3);
+	bytes.WriteVarInt64(-4000000000ll);
+	ASSERT_EQ(1u + 5 + 9 + 1 + 5, bytes.GetLength());
+
+	bytes.SetPosition(0);
+	ASSERT_EQ(5u, bytes.ReadVarUInt32());
+	ASSERT_EQ(0xFFFFFFFFu, bytes.ReadVarUInt32());
+	ASSERT_EQ(1ull << 60, bytes.ReadVarUInt64());
+	ASSERT_EQ(-3, bytes.ReadVarInt32());
+	ASSERT_EQ(-4000000000ll, bytes.ReadVarInt64());
+	ASSERT_FALSE(bytes.HasError());
+
+	ASSERT_EQ(0u, bytes.ReadVarUInt64());
+	ASSERT_TRUE(bytes.HasError());
+
+	//Too big for 32 bits
+	bytes.ClearError();
+	bytes.SetPosition(6);
+	ASSERT_EQ(0u, bytes.ReadVarUInt32());
+	ASSERT_TRUE(bytes.HasError());
+}
+
+
+} /* namespace landan */
+#endif /* _VARINTTEST_H_ */
@@ -0,0 +1,180 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/core/LandanTypes.h>
+#include <landan/timer/Timer.h>
+#include <landan/util/ByteSwap.h>
+#include <landan/util/EndianUtil.h>
+#include <cstdlib>
+#include <iomanip>
+#include <nowide/args.hpp>
+#include <nowide/iostream.hpp>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+using namespace landan;
+
+//////////////////////////////////////////////////////////////////////
+// BASELINE //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+//The mask and shift chains EndianUtil used before it moved to intrinsics, kept as the baseline
+static u16 LegacySwapUInt16(u16 value)
+{
+	return ((value & 0xFF00) >> 8) | ((value & 0x00FF) << 8);
+}
+
+static u32 LegacySwapUInt32(u32 value)
+{
+	return ((value & 0xFF000000) >> 24) | ((value & 0x000000FF) << 24)
+			| ((value & 0x00FF0000) >> 8) | ((value & 0x0000FF00) << 8);
+}
+
+static u64 LegacySwapUInt64(u64 value)
+{
+	return ((value & 0xFF00000000000000ull) >> 56)
+			| ((value & 0x00000000000000FFull) << 56)
+			| ((value & 0x00FF000000000000ull) >> 40)
+			| ((value & 0x000000000000FF00ull) << 40)
+			| ((value & 0x0000FF0000000000ull) >> 24)
+			| ((value & 0x0000000000FF0000ull) << 24)
+			| ((value & 0x000000FF00000000ull) >> 8)
+			| ((value & 0x00000000FF000000ull) << 8);
+}
+
+//Swaps one element at a time through a function pointer the way a decoder calling per field would,
+//so the compiler can't fold the whole loop into something neither path does in practice
+template<typename T>
+static void SwapEach(T *values, u32 count, T (*swap)(T))
+{
+	for (u32 i = 0; i < count; i++)
+	{
+		values[i] = swap(values[i]);
+	}
+}
+
+static u16 IntrinsicSwapUInt16(u16 value) { return SwapUInt16(value); }
+static u32 IntrinsicSwapUInt32(u32 value) { return SwapUInt32(value); }
+static u64 IntrinsicSwapUInt64(u64 value) { return SwapUInt64(value); }
+
+//////////////////////////////////////////////////////////////////////
+// BENCHMARK /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+static const char* KERNEL_NAMES[] = { "scalar", "ssse3", "avx2" };
+
+static void Report(const char *name, u32 elementSize, u32 count, u32 passes, u64 ticks)
+{
+	f64 seconds = Timer::TicksToSeconds(ticks);
+	f64 bytes = static_cast<f64>(elementSize) * count * passes;
+	nowide::cout << "  " << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(3)
+		<< std::setw(10) << (seconds * 1e9 / (static_cast<f64>(count) * passes)) << " ns/element"
+		<< std::setw(10) << (bytes / seconds / 1e9) << " GB/s" << std::endl;
+}
+
+template<typename T>
+static void Run(const char *title, u32 count, u32 passes, T (*legacy)(T), T (*intrinsic)(T), void (*buffer)(T*, size_t))
+{
+	std::vector<T> values(count);
+	for (u32 i = 0; i < count; i++)
+	{
+		values[i] = static_cast<T>(i * 2654435761u);
+	}
+
+	nowide::cout << title << " x " << count << std::endl;
+
+	u64 start = Timer::GetTicks();
+	for (u32 pass = 0; pass < passes; pass++)
+	{
+		SwapEach(&values[0], count, legacy);
+	}
+	Report("legacy shifts", sizeof(T), count, passes, Timer::GetTicks() - start);
+
+	start = Timer::GetTicks();
+	for (u32 pass = 0; pass < passes; pass++)
+	{
+		SwapEach(&values[0], count, intrinsic);
+	}
+	Report("intrinsic", sizeof(T), count, passes, Timer::GetTicks() - start);
+
+	byteswap::KERNEL supported = ByteSwap::GetSupportedKernel();
+	for (u32 kernel = byteswap::SCALAR; kernel <= static_cast<u32>(supported); kernel++)
+	{
+		ByteSwap::SetKernel(static_cast<byteswap::KERNEL>(kernel));
+		start = Timer::GetTicks();
+		for (u32 pass = 0; pass < passes; pass++)
+		{
+			buffer(&values[0], count);
+		}
+		string name = string("buffer ") + KERNEL_NAMES[kernel];
+		Report(name.c_str(), sizeof(T), count, passes, Timer::GetTicks() - start);
+	}
+	ByteSwap::SetKernel(supported);
+
+	//Every timed loop above is an even number of passes, so the data should be back where it started
+	if (static_cast<T>(values[count - 1]) != static_cast<T>((count - 1) * 2654435761u))
+	{
+		nowide::cout << "  mismatch!" << std::endl;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// ENTRY /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+//Usage: EndianBenchmark [bytes per buffer]
+//The default fits in L2, pass something like 67108864 to see the memory bound case
+int main(int argc, char **argv)
+{
+	nowide::args utf8Args(argc, argv);
+	Timer::Init();
+
+	u32 bytes = (argc > 1) ? static_cast<u32>(strtoul(argv[1], 0, 10)) : 256 * 1024;
+	bytes = (bytes < 64) ? 64 : bytes;
+	//About a gigabyte of traffic per measurement, always an even number of passes
+	u32 passes = ((1u << 30) / bytes + 1) & ~1u;
+	//Buffers of a gigabyte or more round that down to nothing, still time one round trip
+	passes = (passes < 2) ? 2 : passes;
+
+	nowide::cout << "Fastest kernel: " << KERNEL_NAMES[ByteSwap::GetSupportedKernel()] << std::endl;
+	Run<u16>("u16", bytes / 2, passes, &LegacySwapUInt16, &IntrinsicSwapUInt16, &SwapUInt16Buffer);
+	Run<u32>("u32", bytes / 4, passes, &LegacySwapUInt32, &IntrinsicSwapUInt32, &SwapUInt32Buffer);
+	Run<u64>("u64", bytes / 8, passes, &LegacySwapUInt64, &IntrinsicSwapUInt64, &SwapUInt64Buffer);
+	return 0;
+}
@@ -0,0 +1,85 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/file/File.h>
+#include <landan/util/BinaryLog.h>
+#include <landan/util/ByteArray.h>
+#include <nowide/args.hpp>
+#include <nowide/iostream.hpp>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+using namespace landan;
+
+//////////////////////////////////////////////////////////////////////
+// ENTRY /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+//Usage: LogDecoder <file> [file...]
+//Files are decoded in the order given, so pass rotated files oldest first (log.3 log.2 log.1 log)
+int main(int argc, char **argv)
+{
+	nowide::args utf8Args(argc, argv);
+
+	if (argc < 2)
+	{
+		nowide::cerr << "Usage: LogDecoder <file> [file...]" << std::endl;
+		return 1;
+	}
+
+	int result = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		File file(argv[i]);
+		if (!file.Exists())
+		{
+			nowide::cerr << "Unable to open " << argv[i] << std::endl;
+			result = 1;
+			continue;
+		}
+
+		ByteArray bytes = file.ReadAll();
+		if (BinaryLogDecoder::Decode(bytes, nowide::cout) == 0)
+		{
+			nowide::cerr << "No log records in " << argv[i] << std::endl;
+			result = 1;
+		}
+	}
+	nowide::cout.flush();
+	return result;
+}
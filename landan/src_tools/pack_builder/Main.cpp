@@ -0,0 +1,87 @@
+/*
+Simplified BSD License
+======================
+
+Copyright(c) 2012, Karman Interactive Ltd. 
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of
+conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list
+of conditions and the following disclaimer in the documentation and/or other materials
+provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY KARMAN INTERACTIVE LTD "AS IS" AND ANY EXPRESS OR IMPLIED
+WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KARMAN INTERACTIVE LTD OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+The views and conclusions contained in the software and documentation are those of the
+authors and should not be interpreted as representing official policies, either expressed
+or implied, of Karman Interactive Ltd.
+*/
+
+//////////////////////////////////////////////////////////////////////
+// INCLUDES //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+#include <landan/file/PackFile.h>
+#include <nowide/args.hpp>
+#include <nowide/iostream.hpp>
+
+//////////////////////////////////////////////////////////////////////
+// NAMESPACE /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+using namespace landan;
+
+//////////////////////////////////////////////////////////////////////
+// ENTRY /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+//Usage: PackBuilder <directory> <pack>
+//Assets are named by their path relative to the directory, with forward slashes
+int main(int argc, char **argv)
+{
+	nowide::args utf8Args(argc, argv);
+
+	if (argc != 3)
+	{
+		nowide::cerr << "Usage: PackBuilder <directory> <pack>" << std::endl;
+		return 1;
+	}
+
+	PackWriter writer;
+	u32 count = writer.AddDirectory(argv[1]);
+	if (count == 0)
+	{
+		nowide::cerr << "No files found in " << argv[1] << std::endl;
+		return 1;
+	}
+
+	if (!writer.Write(argv[2]))
+	{
+		nowide::cerr << "Unable to write " << argv[2] << std::endl;
+		return 1;
+	}
+
+	//Read it back so a bad pack fails here rather than at startup
+	PackFile pack;
+	if (!pack.Open(argv[2]) || pack.GetEntryCount() != count)
+	{
+		nowide::cerr << "Unable to verify " << argv[2] << std::endl;
+		return 1;
+	}
+
+	nowide::cout << "Packed " << count << " files into " << argv[2] << " (" << pack.GetMapping().GetSize() << " bytes)" << std::endl;
+	return 0;
+}